@@ -21,6 +21,7 @@
 #include <stddef.h>
 
 #include <ecr/error.h>
+#include <ecr/macro/guards.h>
 #include <ecr/version.h>
 
 #ifdef __cplusplus
@@ -34,6 +35,7 @@ extern "C" {
  * @param data implementation-defined data pointer
  * @param free see {@link ecr_allocator_free_fn_t}
  * @param alloc see {@link ecr_allocator_alloc_fn_t}
+ * @param resize see {@link ecr_allocator_resize_fn_t} (since version 1)
  */
 typedef struct ecr_allocator ecr_allocator_t;
 
@@ -58,12 +60,25 @@ typedef ecr_status_t ecr_allocator_free_fn_t(void *data, void *mem);
  */
 typedef ecr_status_t ecr_allocator_alloc_fn_t(void *data, void **mem_ptr, size_t mem_size);
 
+/**
+ * An allocator function template to resize a block of memory, in place if possible.
+ *
+ * @param data data pointer belonging to the calling allocator
+ * @param mem_ptr pointer to the address of the block to resize, which is updated if the block moves
+ * @param mem_size new size of the block, which must be non-zero
+ * @return status code
+ *
+ * @note The contents of the block are preserved up to the lesser of its old and new sizes. On failure, the block is left untouched.
+ */
+typedef ecr_status_t ecr_allocator_resize_fn_t(void *data, void **mem_ptr, size_t mem_size);
+
 struct ecr_allocator {
     ecr_version_t version;
     void *data;
 
     ecr_allocator_free_fn_t *free;
     ecr_allocator_alloc_fn_t *alloc;
+    ecr_allocator_resize_fn_t *resize;
 };
 
 /**
@@ -93,6 +108,22 @@ static ecr_status_t ecr_allocate(ecr_allocator_t *allocator, void **mem_ptr, siz
     return allocator->alloc(allocator->data, mem_ptr, mem_size);
 }
 
+/**
+ * Resize a block of memory using an allocator.
+ * @param allocator allocator to use
+ * @param mem_ptr see {@link ecr_allocator_resize_fn_t}
+ * @param mem_size see {@link ecr_allocator_resize_fn_t}
+ * @return status code
+ * * {@link ECR_ERROR_NOT_SUPPORTED} if the allocator predates version 1 and cannot resize blocks
+ *
+ * @see ecr_allocator_resize_fn_t
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_resize(ecr_allocator_t *allocator, void **mem_ptr, size_t mem_size) {
+    ECR_VERSION_GUARD(allocator->version, 1);
+    return allocator->resize(allocator->data, mem_ptr, mem_size);
+}
+
 
 #ifdef __cplusplus
 }
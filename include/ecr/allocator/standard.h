@@ -54,10 +54,26 @@ static ecr_status_t ecr_allocator_standard_alloc(void *, void **mem_ptr, size_t
     return ECR_SUCCESS;
 }
 
+/**
+ * Wraps the standard libc `realloc()` function.
+ *
+ * @see {@link ecr_allocator_resize_fn_t}
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_allocator_standard_resize(void *, void **mem_ptr, size_t mem_size) {
+    void *mem = realloc(*mem_ptr, mem_size);
+    if(!mem) {
+        return ecr_get_system_error();
+    }
+
+    *mem_ptr = mem;
+    return ECR_SUCCESS;
+}
+
 /**
  * Instantiates the standard allocator.
  */
-#define ecr_allocator_standard ((ecr_allocator_t) { .version = 0, .data = NULL, .free = ecr_allocator_standard_free, .alloc = ecr_allocator_standard_alloc })
+#define ecr_allocator_standard ((ecr_allocator_t) { .version = 1, .data = NULL, .free = ecr_allocator_standard_free, .alloc = ecr_allocator_standard_alloc, .resize = ecr_allocator_standard_resize })
 
 
 #ifdef __cplusplus
@@ -48,6 +48,8 @@ typedef enum : uint_least32_t {
     ECR_ERROR_TYPE_LOGICAL  = 0x20, /// \endcond
     /// numerical overflow
     ECR_ERROR_TYPE_OVERFLOW = ECR_ERROR_TYPE_LOGICAL + 0x1,
+    /// invalid or corrupt data
+    ECR_ERROR_INVALID_DATA  = ECR_ERROR_TYPE_LOGICAL + 0x2,
 
     /// \cond
     ECR_ERROR_TYPE_IO     = 0x40, /// \endcond
@@ -57,6 +59,8 @@ typedef enum : uint_least32_t {
     ECR_ERROR_EOF         = ECR_ERROR_TYPE_IO + 0x1,
     /// full buffer
     ECR_ERROR_FULL_BUFFER = ECR_ERROR_TYPE_IO + 0x2,
+    /// operation would block
+    ECR_ERROR_AGAIN       = ECR_ERROR_TYPE_IO + 0x3,
 } ecr_status_t;
 
 /**
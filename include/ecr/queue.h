@@ -0,0 +1,172 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_QUEUE_H_
+#define ECR_QUEUE_H_
+
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define ECR_QUEUE_CACHE_LINE_SIZE 64
+
+/**
+ * Struct to represent a bounded, lock-free queue of fixed-size elements for any number of producers and consumers.
+ * Its members should only be read, never modified directly.
+ * @param allocator allocator used for the queue's storage
+ * @param storage block allocated for the slots
+ * @param slots slots, aligned to a cache line
+ * @param element_size size of each element
+ * @param element_offset offset of each element from the start of its slot
+ * @param slot_size size of each slot, a multiple of {@link ECR_QUEUE_CACHE_LINE_SIZE}
+ * @param mask number of slots minus one
+ * @param closed whether the queue has been closed
+ * @param head total number of elements claimed by producers, with its top bit set once the queue is closed
+ * @param pushed futex word bumped when elements are pushed while consumers wait
+ * @param pop_waiting number of consumers waiting for elements
+ * @param tail total number of elements claimed by consumers
+ * @param popped futex word bumped when elements are popped while producers wait
+ * @param push_waiting number of producers waiting for room
+ *
+ * Each slot holds a sequence number telling which lap of the ring it is ready for, and whether it's
+ * waiting to be filled or emptied. Producers and consumers claim runs of slots by advancing **head** and **tail**
+ * respectively, then hand them over by publishing each slot's next sequence number, so that neither side ever
+ * waits on the other except when the queue is full or empty. **head** and **tail** live on separate cache lines
+ * along with the futex words used to wait on them, and no two slots share a cache line.
+ */
+typedef struct ecr_queue {
+    ecr_allocator_t *allocator;
+    void *storage, *slots;
+    size_t element_size, element_offset, slot_size, mask;
+    _Atomic(uint32_t) closed;
+    char padding[ECR_QUEUE_CACHE_LINE_SIZE];
+
+    _Atomic(size_t) head;
+    _Atomic(uint32_t) pushed;
+    _Atomic(uint32_t) pop_waiting;
+    char head_padding[ECR_QUEUE_CACHE_LINE_SIZE - 16];
+
+    _Atomic(size_t) tail;
+    _Atomic(uint32_t) popped;
+    _Atomic(uint32_t) push_waiting;
+    char tail_padding[ECR_QUEUE_CACHE_LINE_SIZE - 16];
+} ecr_queue_t;
+
+/**
+ * Initialize an empty queue.
+ *
+ * @param queue pointer to the queue to be initialized
+ * @param allocator allocator to use for the queue's storage; it must remain valid until the queue is freed
+ * @param element_size size of each element
+ * @param capacity number of elements the queue can hold, rounded up to a power of two, and at least two
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **element_size** or **capacity** is zero
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the queue would be too large
+ */
+ecr_status_t ecr_queue_init(ecr_queue_t *queue, ecr_allocator_t *allocator, size_t element_size, size_t capacity);
+
+/**
+ * Free a queue's storage. No other thread may be using the queue.
+ *
+ * @param queue queue to free
+ *
+ * @return error code
+ */
+ecr_status_t ecr_queue_free(ecr_queue_t *queue);
+
+/**
+ * Close a queue, waking up all waiting producers and consumers. Elements already pushed may still be popped.
+ *
+ * @param queue queue to close
+ */
+void ecr_queue_close(ecr_queue_t *queue);
+
+/**
+ * Push an element to the back of a queue.
+ *
+ * @param queue queue to push to
+ * @param element element to copy into the queue
+ * @param blocking whether to wait for room if the queue is full
+ *
+ * @return error code
+ * * {@link ECR_ERROR_AGAIN} if the queue is full and **blocking** is false
+ * * {@link ECR_ERROR_SYSTEM} with `EPIPE` if the queue is closed
+ */
+ecr_status_t ecr_queue_push(ecr_queue_t *queue, const void *element, bool blocking);
+
+/**
+ * Pop an element from the front of a queue.
+ *
+ * @param queue queue to pop from
+ * @param element memory to copy the element into
+ * @param blocking whether to wait for an element if the queue is empty
+ *
+ * @return error code
+ * * {@link ECR_ERROR_AGAIN} if the queue is empty and **blocking** is false
+ * * {@link ECR_ERROR_EOF} if the queue is closed and empty
+ */
+ecr_status_t ecr_queue_pop(ecr_queue_t *queue, void *element, bool blocking);
+
+/**
+ * Push up to **count** elements to the back of a queue at once, claiming their slots with a single atomic operation.
+ * The elements pushed are contiguous in the queue, never interleaved with those of other producers.
+ *
+ * @param queue queue to push to
+ * @param elements array of elements to copy into the queue
+ * @param count number of elements in the array
+ * @param pushed pointer which will store the number of elements pushed on success, which is at least one
+ * @param blocking whether to wait for room if the queue is full
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **count** is zero
+ * * {@link ECR_ERROR_AGAIN} if the queue is full and **blocking** is false
+ * * {@link ECR_ERROR_SYSTEM} with `EPIPE` if the queue is closed
+ */
+ecr_status_t ecr_queue_push_batch(ecr_queue_t *queue, const void *elements, size_t count, size_t *pushed, bool blocking);
+
+/**
+ * Pop up to **count** elements from the front of a queue at once, claiming their slots with a single atomic operation.
+ *
+ * @param queue queue to pop from
+ * @param elements array to copy the elements into
+ * @param count number of elements the array can hold
+ * @param popped pointer which will store the number of elements popped on success, which is at least one
+ * @param blocking whether to wait for an element if the queue is empty
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **count** is zero
+ * * {@link ECR_ERROR_AGAIN} if the queue is empty and **blocking** is false
+ * * {@link ECR_ERROR_EOF} if the queue is closed and empty
+ */
+ecr_status_t ecr_queue_pop_batch(ecr_queue_t *queue, void *elements, size_t count, size_t *popped, bool blocking);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * Sleep until **address** is woken, unless it no longer holds **expected**.
+ * Spurious wakeups are possible; callers must re-check their condition.
+ *
+ * @param timeout relative timeout, or `NULL` to wait indefinitely
+ * @param shared whether **address** may be mapped by other processes
+ */
+[[maybe_unused]]
+static void ecr_futex_wait(_Atomic uint32_t *address, uint32_t expected, const struct timespec *timeout, bool shared) {
+    syscall(SYS_futex, address, shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0);
+}
+
+/**
+ * Wake up to **count** waiters sleeping on **address**.
+ *
+ * @param shared whether **address** may be mapped by other processes
+ */
+[[maybe_unused]]
+static void ecr_futex_wake(_Atomic uint32_t *address, int count, bool shared) {
+    syscall(SYS_futex, address, shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_CONTAINERS_ARRAY_H_
+#define ECR_CONTAINERS_ARRAY_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ecr/allocator.h>
+#include <ecr/buffer.h>
+#include <ecr/error.h>
+#include <ecr/macro/guards.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Grow the storage of a dynamic array so that it holds at least **additional** more elements than it has.
+ *
+ * The capacity grows geometrically, so that appending elements one at a time takes amortized constant time.
+ * The storage is resized with {@link ecr_resize} if the allocator supports it, so that it can grow in place;
+ * otherwise, a new block is allocated and the array's elements are moved to it.
+ *
+ * @param allocator allocator of the array's storage
+ * @param memory pointer to the address of the array's storage, which may be `NULL` if its capacity is zero
+ * @param capacity pointer to the number of elements the storage can hold
+ * @param length number of elements in the array
+ * @param element_size size of each element
+ * @param additional number of elements to make room for after the existing ones
+ *
+ * @return error code
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the array would be too large
+ *
+ * @note On failure, the storage is left untouched.
+ */
+ecr_status_t ecr_array_grow(ecr_allocator_t *allocator, void **memory, size_t *capacity, size_t length, size_t element_size, size_t additional);
+
+/**
+ * Shrink the storage of a dynamic array to fit its elements exactly, freeing it if it has none.
+ *
+ * @param allocator allocator of the array's storage
+ * @param memory pointer to the address of the array's storage
+ * @param capacity pointer to the number of elements the storage can hold
+ * @param length number of elements in the array
+ * @param element_size size of each element
+ *
+ * @return error code
+ *
+ * @note On failure, the storage is left untouched.
+ */
+ecr_status_t ecr_array_shrink(ecr_allocator_t *allocator, void **memory, size_t *capacity, size_t length, size_t element_size);
+
+/**
+ * Define a dynamic array type **name**`_t` of elements of **type**, along with functions to manage it:
+ * * `void `**name**`_init(`**name**`_t *array, ecr_allocator_t *allocator)` initializes an empty array;
+ * nothing is allocated until the first element is added
+ * * `ecr_status_t `**name**`_free(`**name**`_t *array)` frees an array's storage, leaving it empty
+ * * `ecr_status_t `**name**`_reserve(`**name**`_t *array, size_t count)` makes room for at least **count** elements
+ * * `ecr_status_t `**name**`_resize(`**name**`_t *array, size_t length)` sets the number of elements, leaving new ones uninitialized
+ * * `ecr_status_t `**name**`_shrink(`**name**`_t *array)` shrinks an array's storage to fit its elements
+ * * `ecr_status_t `**name**`_push(`**name**`_t *array, type value)` appends an element
+ * * `ecr_status_t `**name**`_append(`**name**`_t *array, const type *values, size_t count)` appends **count** elements
+ * * `bool `**name**`_pop(`**name**`_t *array, type *value)` removes the last element, returning false if there is none
+ * * `void `**name**`_clear(`**name**`_t *array)` removes all elements, keeping the storage
+ * * `ecr_buffer_t `**name**`_as_buffer(const `**name**`_t *array)` views the elements as a buffer, without copying them,
+ * so that they can be written to a stream directly; the buffer remains valid until the array is next modified
+ *
+ * The array's members may be read directly; its elements are `data[0]` through `data[length - 1]`.
+ *
+ * @see ecr_array_grow
+ */
+#define ECR_ARRAY_DEFINE(name, type) \
+    typedef struct name { \
+        ecr_allocator_t *allocator; \
+        type *data; \
+        size_t length, capacity; \
+    } name##_t; \
+    \
+    [[maybe_unused]] \
+    static void name##_init(name##_t *array, ecr_allocator_t *allocator) { \
+        array->allocator = allocator; \
+        array->data      = NULL; \
+        array->length    = 0; \
+        array->capacity  = 0; \
+    } \
+    \
+    [[maybe_unused]] \
+    static ecr_status_t name##_free(name##_t *array) { \
+        if(array->capacity > 0) { \
+            ECR_STATUS_GUARD(ecr_free(array->allocator, array->data)); \
+        } \
+        array->data     = NULL; \
+        array->length   = 0; \
+        array->capacity = 0; \
+        return ECR_SUCCESS; \
+    } \
+    \
+    [[maybe_unused]] \
+    static ecr_status_t name##_grow(name##_t *array, size_t additional) { \
+        void *memory = array->data; \
+        ECR_STATUS_GUARD(ecr_array_grow(array->allocator, &memory, &array->capacity, array->length, sizeof(type), additional)); \
+        array->data = (type *) memory; \
+        return ECR_SUCCESS; \
+    } \
+    \
+    [[maybe_unused]] \
+    static ecr_status_t name##_reserve(name##_t *array, size_t count) { \
+        if(count > array->capacity) { \
+            ECR_STATUS_GUARD(name##_grow(array, count - array->length)); \
+        } \
+        return ECR_SUCCESS; \
+    } \
+    \
+    [[maybe_unused]] \
+    static ecr_status_t name##_resize(name##_t *array, size_t length) { \
+        ECR_STATUS_GUARD(name##_reserve(array, length)); \
+        array->length = length; \
+        return ECR_SUCCESS; \
+    } \
+    \
+    [[maybe_unused]] \
+    static ecr_status_t name##_shrink(name##_t *array) { \
+        void *memory = array->data; \
+        ECR_STATUS_GUARD(ecr_array_shrink(array->allocator, &memory, &array->capacity, array->length, sizeof(type))); \
+        array->data = (type *) memory; \
+        return ECR_SUCCESS; \
+    } \
+    \
+    [[maybe_unused]] \
+    static ecr_status_t name##_push(name##_t *array, type value) { \
+        if(array->length == array->capacity) { \
+            ECR_STATUS_GUARD(name##_grow(array, 1)); \
+        } \
+        array->data[array->length++] = value; \
+        return ECR_SUCCESS; \
+    } \
+    \
+    [[maybe_unused]] \
+    static ecr_status_t name##_append(name##_t *array, const type *values, size_t count) { \
+        if(count > array->capacity - array->length) { \
+            ECR_STATUS_GUARD(name##_grow(array, count)); \
+        } \
+        if(count > 0) { \
+            memcpy(array->data + array->length, values, count * sizeof(type)); \
+        } \
+        array->length += count; \
+        return ECR_SUCCESS; \
+    } \
+    \
+    [[maybe_unused]] \
+    static bool name##_pop(name##_t *array, type *value) { \
+        if(array->length == 0) { \
+            return false; \
+        } \
+        *value = array->data[--array->length]; \
+        return true; \
+    } \
+    \
+    [[maybe_unused]] \
+    static void name##_clear(name##_t *array) { \
+        array->length = 0; \
+    } \
+    \
+    [[maybe_unused]] \
+    static ecr_buffer_t name##_as_buffer(const name##_t *array) { \
+        ecr_buffer_t buffer = { \
+            .memory   = array->data, \
+            .capacity = array->capacity * sizeof(type), \
+            .position = 0, \
+            .length   = array->length * sizeof(type), \
+        }; \
+        return buffer; \
+    }
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
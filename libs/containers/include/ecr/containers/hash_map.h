@@ -0,0 +1,212 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_CONTAINERS_HASH_MAP_H_
+#define ECR_CONTAINERS_HASH_MAP_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * A hash function template for hash map keys.
+ *
+ * @param key pointer to the key to hash
+ * @param key_size size of the map's keys
+ * @return hash of the key; all of its bits are used, so they should all be well mixed
+ */
+typedef uint_least64_t ecr_hash_map_hash_fn_t(const void *key, size_t key_size);
+
+/**
+ * An equality function template for hash map keys.
+ *
+ * @param key pointer to the key being looked up, which may be of another type for heterogeneous lookups
+ * (see {@link ecr_hash_map_find_with})
+ * @param other pointer to a key stored in the map
+ * @param key_size size of the map's keys
+ * @return whether the keys are equal
+ */
+typedef bool ecr_hash_map_equal_fn_t(const void *key, const void *other, size_t key_size);
+
+/**
+ * Struct to represent an open-addressing hash map with fixed-size keys and values.
+ * Its members should only be read, never modified directly.
+ * @param allocator allocator used for the map's storage
+ * @param hash see {@link ecr_hash_map_hash_fn_t}
+ * @param equal see {@link ecr_hash_map_equal_fn_t}
+ * @param key_size size of each key
+ * @param value_size size of each value
+ * @param value_offset offset of each value from its key
+ * @param entry_size size of each key and value pair, including padding
+ * @param capacity number of slots
+ * @param size number of entries
+ * @param growth_left number of entries that can be added before the map needs to grow
+ * @param control one control byte per slot, telling whether it's empty, deleted or full, and in the last case
+ * holding 7 bits of the hash of its key
+ * @param entries slots for key and value pairs
+ *
+ * The map is a Swiss table: slots are probed in groups of 16, whose control bytes are compared
+ * against the hash of the key being looked up all at once with SIMD instructions, so that keys are only compared
+ * when 7 bits of their hashes already match.
+ */
+typedef struct ecr_hash_map {
+    ecr_allocator_t *allocator;
+    ecr_hash_map_hash_fn_t *hash;
+    ecr_hash_map_equal_fn_t *equal;
+
+    size_t key_size, value_size;
+    size_t value_offset, entry_size;
+
+    size_t capacity, size, growth_left;
+    unsigned char *control;
+    void *entries;
+} ecr_hash_map_t;
+
+/**
+ * Hash a block of memory. This is the default hash function of a hash map.
+ *
+ * @param memory memory to hash
+ * @param length length of the memory
+ * @return hash of the memory
+ */
+uint_least64_t ecr_hash_bytes(const void *memory, size_t length);
+
+/**
+ * Initialize an empty hash map. Nothing is allocated until the first entry is inserted.
+ *
+ * Keys and values are copied into the map as they are, and aligned to the largest power of two,
+ * up to 16, dividing their size.
+ *
+ * @param map pointer to the map to be initialized
+ * @param allocator allocator to use for the map's storage; it must remain valid until the map is freed
+ * @param key_size size of each key
+ * @param value_size size of each value; may be zero, for a set
+ * @param hash hash function for keys, or `NULL` to hash their bytes with {@link ecr_hash_bytes}
+ * @param equal equality function for keys, or `NULL` to compare their bytes
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **key_size** is zero
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if a key and value pair is too large
+ */
+ecr_status_t ecr_hash_map_init(ecr_hash_map_t *map, ecr_allocator_t *allocator, size_t key_size, size_t value_size, ecr_hash_map_hash_fn_t *hash, ecr_hash_map_equal_fn_t *equal);
+
+/**
+ * Free a hash map's storage, leaving it empty.
+ *
+ * @param map map to free
+ *
+ * @return error code
+ */
+ecr_status_t ecr_hash_map_free(ecr_hash_map_t *map);
+
+/**
+ * Make room for at least **count** entries in a hash map, rehashing all of its entries at once if it must grow,
+ * so that inserting up to **count** entries in total doesn't rehash again.
+ *
+ * @param map map to reserve room in
+ * @param count number of entries to make room for
+ *
+ * @return error code
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the map would be too large
+ */
+ecr_status_t ecr_hash_map_reserve(ecr_hash_map_t *map, size_t count);
+
+/**
+ * Find the value of a key in a hash map, inserting the key if it isn't present.
+ *
+ * If the key is inserted, its value is left uninitialized, to be written through the pointer returned.
+ * The pointer remains valid until the map is next modified.
+ *
+ * @param map map to insert into
+ * @param key pointer to the key, which is copied into the map if inserted
+ * @param value pointer to the pointer to the key's value to be returned
+ * @param inserted pointer to whether the key was inserted, rather than already present, to be returned;
+ * may be `NULL`
+ *
+ * @return error code
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the map would be too large
+ */
+ecr_status_t ecr_hash_map_insert(ecr_hash_map_t *map, const void *key, void **value, bool *inserted);
+
+/**
+ * Find the value of a key in a hash map.
+ *
+ * @param map map to search
+ * @param key pointer to the key
+ * @return pointer to the key's value, valid until the map is next modified, or `NULL` if the key isn't present
+ */
+void * ecr_hash_map_find(const ecr_hash_map_t *map, const void *key);
+
+/**
+ * Find the value of a key in a hash map, using a lookup key of any type which identifies it.
+ *
+ * This allows looking up entries without first building a key of the map's type; for example, a map keyed by
+ * structs holding a string's pointer and length can be searched with a string directly.
+ * **hash** must equal the hash the map's hash function gives the matching key.
+ *
+ * @param map map to search
+ * @param key pointer to the lookup key, passed to **equal** as its first argument
+ * @param hash hash of the lookup key
+ * @param equal function comparing the lookup key to keys in the map
+ * @return pointer to the key's value, valid until the map is next modified, or `NULL` if the key isn't present
+ */
+void * ecr_hash_map_find_with(const ecr_hash_map_t *map, const void *key, uint_least64_t hash, ecr_hash_map_equal_fn_t *equal);
+
+/**
+ * Remove a key and its value from a hash map.
+ *
+ * @param map map to remove from
+ * @param key pointer to the key
+ * @return whether the key was present
+ */
+bool ecr_hash_map_remove(ecr_hash_map_t *map, const void *key);
+
+/**
+ * Remove all entries from a hash map, keeping its storage.
+ *
+ * @param map map to clear
+ */
+void ecr_hash_map_clear(ecr_hash_map_t *map);
+
+/**
+ * Get the next entry of a hash map, in no particular order.
+ *
+ * Iteration starts with a **cursor** of zero, and must not be interleaved with modifications to the map,
+ * other than writing to values.
+ *
+ * @param map map to iterate over
+ * @param cursor pointer to the iteration state, which is advanced
+ * @param key pointer to the pointer to the entry's key to be returned
+ * @param value pointer to the pointer to the entry's value to be returned
+ * @return whether an entry was found, rather than the iteration having ended
+ */
+bool ecr_hash_map_next(const ecr_hash_map_t *map, size_t *cursor, const void **key, void **value);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
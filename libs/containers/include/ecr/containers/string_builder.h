@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_CONTAINERS_STRING_BUILDER_H_
+#define ECR_CONTAINERS_STRING_BUILDER_H_
+
+
+#include <stdarg.h>
+#include <stddef.h>
+
+#include <ecr/allocator.h>
+#include <ecr/containers/array.h>
+#include <ecr/error.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Dynamic array of characters for building strings, along with the functions of {@link ECR_ARRAY_DEFINE}.
+ * Its contents are not null-terminated unless {@link ecr_string_builder_c_str} is called.
+ */
+ECR_ARRAY_DEFINE(ecr_string_builder, char)
+
+/**
+ * Append a null-terminated string to a string builder.
+ *
+ * @param builder builder to append to
+ * @param string string to append, without its terminator
+ *
+ * @return error code
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the builder would be too large
+ */
+ecr_status_t ecr_string_builder_append_string(ecr_string_builder_t *builder, const char *string);
+
+/**
+ * Append formatted text to a string builder in the same formatting conventions as the
+ * `printf()` family of functions.
+ *
+ * The text is formatted directly into the builder's spare capacity, growing it once if the text doesn't fit.
+ *
+ * @param builder builder to append to
+ * @param format format string
+ * @param ... formatted arguments
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if formatting fails
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the builder would be too large
+ */
+ecr_status_t ecr_string_builder_printf(ecr_string_builder_t *builder, const char *format, ...);
+
+/**
+ * Append formatted text to a string builder in the same formatting conventions as the
+ * `printf()` family of functions.
+ *
+ * @param builder builder to append to
+ * @param format format string
+ * @param vlist formatted arguments
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if formatting fails
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the builder would be too large
+ */
+ecr_status_t ecr_string_builder_vprintf(ecr_string_builder_t *builder, const char *format, va_list vlist);
+
+/**
+ * Null-terminate the contents of a string builder, without counting the terminator in its length.
+ *
+ * @param builder builder to terminate
+ * @param string pointer which will store the address of the terminated string on success;
+ * it remains valid until the builder is next modified
+ *
+ * @return error code
+ */
+ecr_status_t ecr_string_builder_c_str(ecr_string_builder_t *builder, const char **string);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
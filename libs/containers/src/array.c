@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdckdint.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ecr/allocator.h"
+#include "ecr/containers/array.h"
+#include "ecr/error.h"
+#include "ecr/macro/guards.h"
+
+// smallest block worth allocating, so that short arrays don't resize for each of their first few elements
+#define MIN_STORAGE_SIZE 64
+
+static ecr_status_t ecr_array_move(ecr_allocator_t *allocator, void **memory, size_t old_size, size_t new_size, size_t used_size) {
+    if(old_size == 0) {
+        return ecr_allocate(allocator, memory, new_size);
+    }
+
+    ecr_status_t status = ecr_resize(allocator, memory, new_size);
+    if(status != ECR_ERROR_NOT_SUPPORTED) {
+        return status;
+    }
+
+    void *moved;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, &moved, new_size));
+    memcpy(moved, *memory, used_size);
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_free(allocator, *memory), ecr_free(allocator, moved));
+
+    *memory = moved;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_array_grow(ecr_allocator_t *allocator, void **memory, size_t *capacity, size_t length, size_t element_size, size_t additional) {
+    size_t required;
+    if(ckd_add(&required, length, additional)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+    if(required <= *capacity) {
+        return ECR_SUCCESS;
+    }
+
+    // grow by half again, which lets freed blocks be reused for later growth unlike doubling
+    size_t grown = *capacity + *capacity / 2;
+    size_t minimum = (MIN_STORAGE_SIZE + element_size - 1) / element_size;
+    size_t new_capacity = required;
+    if(new_capacity < grown) {
+        new_capacity = grown;
+    }
+    if(new_capacity < minimum) {
+        new_capacity = minimum;
+    }
+
+    size_t new_size;
+    if(ckd_mul(&new_size, new_capacity, element_size)) {
+        // fall back to the exact requirement before giving up
+        new_capacity = required;
+        if(ckd_mul(&new_size, new_capacity, element_size)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+    }
+
+    ECR_STATUS_GUARD(ecr_array_move(allocator, memory, *capacity * element_size, new_size, length * element_size));
+
+    *capacity = new_capacity;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_array_shrink(ecr_allocator_t *allocator, void **memory, size_t *capacity, size_t length, size_t element_size) {
+    if(length == *capacity) {
+        return ECR_SUCCESS;
+    }
+
+    if(length == 0) {
+        ECR_STATUS_GUARD(ecr_free(allocator, *memory));
+        *memory = NULL;
+    } else {
+        ECR_STATUS_GUARD(ecr_array_move(allocator, memory, *capacity * element_size, length * element_size, length * element_size));
+    }
+
+    *capacity = length;
+    return ECR_SUCCESS;
+}
@@ -0,0 +1,375 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdckdint.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ecr/allocator.h"
+#include "ecr/containers/hash_map.h"
+#include "ecr/error.h"
+#include "ecr/macro/guards.h"
+
+#define GROUP_WIDTH 16
+
+// full slots hold the low 7 bits of their key's hash, so only empty and deleted slots have their top bit set
+#define CONTROL_EMPTY   0x80
+#define CONTROL_DELETED 0xFE
+
+#define NOT_FOUND SIZE_MAX
+
+typedef unsigned __int128 uint128_t;
+
+static uint64_t ecr_hash_mix(uint64_t a, uint64_t b) {
+    uint128_t product = (uint128_t) a * b;
+    return (uint64_t) product ^ (uint64_t) (product >> 64);
+}
+
+static uint64_t ecr_hash_read(const unsigned char *memory, size_t size) {
+    uint64_t value = 0;
+    memcpy(&value, memory, size);
+    return value;
+}
+
+uint_least64_t ecr_hash_bytes(const void *memory, size_t length) {
+    const uint64_t p0 = UINT64_C(0xa0761d6478bd642f);
+    const uint64_t p1 = UINT64_C(0xe7037ed1a0b428db);
+    const uint64_t p2 = UINT64_C(0x8ebc6af09c88c6e3);
+
+    const unsigned char *in = memory;
+    uint64_t seed = p0 ^ length;
+
+    size_t remaining = length;
+    for(; remaining > 16; remaining -= 16, in += 16) {
+        seed = ecr_hash_mix(ecr_hash_read(in, 8) ^ p1, ecr_hash_read(in + 8, 8) ^ seed);
+    }
+
+    // the last bytes are read as two words, overlapping if there are fewer than sixteen
+    uint64_t a = 0, b = 0;
+    if(remaining >= 8) {
+        a = ecr_hash_read(in, 8);
+        b = ecr_hash_read(in + remaining - 8, 8);
+    } else if(remaining >= 4) {
+        a = ecr_hash_read(in, 4);
+        b = ecr_hash_read(in + remaining - 4, 4);
+    } else if(remaining > 0) {
+        a = (uint64_t) in[0] << 16 | (uint64_t) in[remaining / 2] << 8 | in[remaining - 1];
+    }
+
+    return ecr_hash_mix(ecr_hash_mix(a ^ p1, b ^ seed) ^ p2, length ^ p1);
+}
+
+static uint_least64_t ecr_hash_map_hash_bytes(const void *key, size_t key_size) {
+    return ecr_hash_bytes(key, key_size);
+}
+
+static bool ecr_hash_map_equal_bytes(const void *key, const void *other, size_t key_size) {
+    return memcmp(key, other, key_size) == 0;
+}
+
+// bit i is set if the control byte of the group's slot i is **control**
+static uint32_t ecr_hash_map_match(const unsigned char *group, unsigned char control) {
+#if defined(__SSE2__)
+    __m128i bytes = _mm_loadu_si128((const __m128i *) group);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(control)));
+#else
+    uint32_t mask = 0;
+    for(size_t i = 0; i < GROUP_WIDTH; i++) {
+        mask |= (uint32_t) (group[i] == control) << i;
+    }
+    return mask;
+#endif
+}
+
+// bit i is set if the group's slot i is empty or deleted
+static uint32_t ecr_hash_map_match_available(const unsigned char *group) {
+#if defined(__SSE2__)
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) group));
+#else
+    uint32_t mask = 0;
+    for(size_t i = 0; i < GROUP_WIDTH; i++) {
+        mask |= (uint32_t) (group[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+static size_t ecr_hash_map_alignment(size_t size) {
+    size_t alignment = size & -size;
+    if(alignment == 0) {
+        return 1;
+    }
+    return alignment > 16 ? 16 : alignment;
+}
+
+static void * ecr_hash_map_entry(const ecr_hash_map_t *map, size_t slot) {
+    return map->entries + slot * map->entry_size;
+}
+
+// groups are probed in triangular steps, which visits every group once the group count is a power of two
+static size_t ecr_hash_map_search(const ecr_hash_map_t *map, const void *key, uint_least64_t hash, ecr_hash_map_equal_fn_t *equal) {
+    if(map->capacity == 0) {
+        return NOT_FOUND;
+    }
+
+    size_t group_mask = map->capacity / GROUP_WIDTH - 1;
+    size_t group = (hash >> 7) & group_mask;
+    unsigned char tag = hash & 0x7F;
+
+    for(size_t step = 1; ; step++) {
+        const unsigned char *control = map->control + group * GROUP_WIDTH;
+
+        for(uint32_t matches = ecr_hash_map_match(control, tag); matches; matches &= matches - 1) {
+            size_t slot = group * GROUP_WIDTH + __builtin_ctz(matches);
+            if(equal(key, ecr_hash_map_entry(map, slot), map->key_size)) {
+                return slot;
+            }
+        }
+
+        // the key would have been placed in this group's empty slot if the probe had reached it
+        if(ecr_hash_map_match(control, CONTROL_EMPTY)) {
+            return NOT_FOUND;
+        }
+
+        group = (group + step) & group_mask;
+    }
+}
+
+static size_t ecr_hash_map_find_available(const ecr_hash_map_t *map, uint_least64_t hash) {
+    size_t group_mask = map->capacity / GROUP_WIDTH - 1;
+    size_t group = (hash >> 7) & group_mask;
+
+    for(size_t step = 1; ; step++) {
+        uint32_t available = ecr_hash_map_match_available(map->control + group * GROUP_WIDTH);
+        if(available) {
+            return group * GROUP_WIDTH + __builtin_ctz(available);
+        }
+
+        group = (group + step) & group_mask;
+    }
+}
+
+// at most 7/8 of the slots are used, so that probes always end at an empty slot
+static size_t ecr_hash_map_max_load(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+static ecr_status_t ecr_hash_map_rehash(ecr_hash_map_t *map, size_t capacity) {
+    size_t entries_size, total;
+    if(ckd_mul(&entries_size, capacity, map->entry_size) || ckd_add(&total, capacity, entries_size)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    unsigned char *control;
+    ECR_STATUS_GUARD(ecr_allocate(map->allocator, (void **) &control, total));
+    memset(control, CONTROL_EMPTY, capacity);
+
+    ecr_hash_map_t rehashed = *map;
+    rehashed.capacity = capacity;
+    rehashed.control = control;
+    rehashed.entries = control + capacity;
+
+    // entries are moved with no key comparisons, as they're known to be distinct
+    for(size_t slot = 0; slot < map->capacity; slot++) {
+        if(map->control[slot] & 0x80) {
+            continue;
+        }
+
+        void *entry = ecr_hash_map_entry(map, slot);
+        uint_least64_t hash = map->hash(entry, map->key_size);
+
+        size_t target = ecr_hash_map_find_available(&rehashed, hash);
+        rehashed.control[target] = hash & 0x7F;
+        memcpy(ecr_hash_map_entry(&rehashed, target), entry, map->entry_size);
+    }
+
+    if(map->capacity > 0) {
+        ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_free(map->allocator, map->control), ecr_free(map->allocator, control));
+    }
+
+    rehashed.growth_left = ecr_hash_map_max_load(capacity) - map->size;
+    *map = rehashed;
+
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_hash_map_init(ecr_hash_map_t *map, ecr_allocator_t *allocator, size_t key_size, size_t value_size, ecr_hash_map_hash_fn_t *hash, ecr_hash_map_equal_fn_t *equal) {
+    if(key_size == 0) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t key_alignment = ecr_hash_map_alignment(key_size);
+    size_t value_alignment = ecr_hash_map_alignment(value_size);
+    size_t alignment = key_alignment > value_alignment ? key_alignment : value_alignment;
+
+    size_t value_offset, entry_size;
+    if(ckd_add(&value_offset, key_size, value_alignment - 1) || ckd_add(&entry_size, value_offset & -value_alignment, value_size) || ckd_add(&entry_size, entry_size, alignment - 1)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    map->allocator    = allocator;
+    map->hash         = hash ? hash : ecr_hash_map_hash_bytes;
+    map->equal        = equal ? equal : ecr_hash_map_equal_bytes;
+    map->key_size     = key_size;
+    map->value_size   = value_size;
+    map->value_offset = value_offset & -value_alignment;
+    map->entry_size   = entry_size & -alignment;
+    map->capacity     = 0;
+    map->size         = 0;
+    map->growth_left  = 0;
+    map->control      = NULL;
+    map->entries      = NULL;
+
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_hash_map_free(ecr_hash_map_t *map) {
+    if(map->capacity > 0) {
+        ECR_STATUS_GUARD(ecr_free(map->allocator, map->control));
+    }
+
+    map->capacity    = 0;
+    map->size        = 0;
+    map->growth_left = 0;
+    map->control     = NULL;
+    map->entries     = NULL;
+
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_hash_map_reserve(ecr_hash_map_t *map, size_t count) {
+    size_t capacity = GROUP_WIDTH;
+    while(ecr_hash_map_max_load(capacity) < count) {
+        if(ckd_mul(&capacity, capacity, 2)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+    }
+
+    if(capacity <= map->capacity) {
+        return ECR_SUCCESS;
+    }
+    return ecr_hash_map_rehash(map, capacity);
+}
+
+ecr_status_t ecr_hash_map_insert(ecr_hash_map_t *map, const void *key, void **value, bool *inserted) {
+    uint_least64_t hash = map->hash(key, map->key_size);
+
+    size_t slot = ecr_hash_map_search(map, key, hash, map->equal);
+    if(slot != NOT_FOUND) {
+        *value = ecr_hash_map_entry(map, slot) + map->value_offset;
+        if(inserted) {
+            *inserted = false;
+        }
+        return ECR_SUCCESS;
+    }
+
+    if(map->growth_left == 0) {
+        // grow, unless at least half of the room for growth is taken up by deleted slots, which rehashing reclaims
+        size_t capacity = map->capacity;
+        if(capacity == 0) {
+            capacity = GROUP_WIDTH;
+        } else if(map->size > ecr_hash_map_max_load(capacity) / 2 && ckd_mul(&capacity, capacity, 2)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+
+        ECR_STATUS_GUARD(ecr_hash_map_rehash(map, capacity));
+    }
+
+    slot = ecr_hash_map_find_available(map, hash);
+    if(map->control[slot] == CONTROL_EMPTY) {
+        map->growth_left--;
+    }
+    map->control[slot] = hash & 0x7F;
+    map->size++;
+
+    void *entry = ecr_hash_map_entry(map, slot);
+    memcpy(entry, key, map->key_size);
+
+    *value = entry + map->value_offset;
+    if(inserted) {
+        *inserted = true;
+    }
+    return ECR_SUCCESS;
+}
+
+void * ecr_hash_map_find(const ecr_hash_map_t *map, const void *key) {
+    if(map->size == 0) {
+        return NULL;
+    }
+    return ecr_hash_map_find_with(map, key, map->hash(key, map->key_size), map->equal);
+}
+
+void * ecr_hash_map_find_with(const ecr_hash_map_t *map, const void *key, uint_least64_t hash, ecr_hash_map_equal_fn_t *equal) {
+    size_t slot = ecr_hash_map_search(map, key, hash, equal);
+    if(slot == NOT_FOUND) {
+        return NULL;
+    }
+    return ecr_hash_map_entry(map, slot) + map->value_offset;
+}
+
+bool ecr_hash_map_remove(ecr_hash_map_t *map, const void *key) {
+    if(map->size == 0) {
+        return false;
+    }
+
+    size_t slot = ecr_hash_map_search(map, key, map->hash(key, map->key_size), map->equal);
+    if(slot == NOT_FOUND) {
+        return false;
+    }
+
+    // probes never continue past a group with an empty slot, so the slot may become empty too; otherwise it's marked
+    // deleted so that probes still continue past it
+    if(ecr_hash_map_match(map->control + slot / GROUP_WIDTH * GROUP_WIDTH, CONTROL_EMPTY)) {
+        map->control[slot] = CONTROL_EMPTY;
+        map->growth_left++;
+    } else {
+        map->control[slot] = CONTROL_DELETED;
+    }
+    map->size--;
+
+    return true;
+}
+
+void ecr_hash_map_clear(ecr_hash_map_t *map) {
+    if(map->capacity > 0) {
+        memset(map->control, CONTROL_EMPTY, map->capacity);
+    }
+
+    map->size = 0;
+    map->growth_left = ecr_hash_map_max_load(map->capacity);
+}
+
+bool ecr_hash_map_next(const ecr_hash_map_t *map, size_t *cursor, const void **key, void **value) {
+    for(size_t slot = *cursor; slot < map->capacity; slot++) {
+        if(map->control[slot] & 0x80) {
+            continue;
+        }
+
+        void *entry = ecr_hash_map_entry(map, slot);
+        *key = entry;
+        *value = entry + map->value_offset;
+
+        *cursor = slot + 1;
+        return true;
+    }
+
+    *cursor = map->capacity;
+    return false;
+}
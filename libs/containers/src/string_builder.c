@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ecr/containers/string_builder.h"
+#include "ecr/error.h"
+#include "ecr/macro/guards.h"
+
+ecr_status_t ecr_string_builder_append_string(ecr_string_builder_t *builder, const char *string) {
+    return ecr_string_builder_append(builder, string, strlen(string));
+}
+
+ecr_status_t ecr_string_builder_printf(ecr_string_builder_t *builder, const char *format, ...) {
+    va_list vlist;
+    va_start(vlist, format);
+    ecr_status_t status = ecr_string_builder_vprintf(builder, format, vlist);
+    va_end(vlist);
+    return status;
+}
+
+ecr_status_t ecr_string_builder_vprintf(ecr_string_builder_t *builder, const char *format, va_list vlist) {
+    va_list retry;
+    va_copy(retry, vlist);
+
+    size_t spare = builder->capacity - builder->length;
+    int length = vsnprintf(spare > 0 ? builder->data + builder->length : NULL, spare, format, vlist);
+    if(length < 0) {
+        va_end(retry);
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    // the terminator needs room too, though it isn't counted in the builder's length
+    if((size_t) length >= spare) {
+        ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_string_builder_grow(builder, (size_t) length + 1), va_end(retry));
+        vsnprintf(builder->data + builder->length, (size_t) length + 1, format, retry);
+    }
+    va_end(retry);
+
+    builder->length += (size_t) length;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_string_builder_c_str(ecr_string_builder_t *builder, const char **string) {
+    if(builder->length == builder->capacity) {
+        ECR_STATUS_GUARD(ecr_string_builder_grow(builder, 1));
+    }
+
+    builder->data[builder->length] = '\0';
+    *string = builder->data;
+    return ECR_SUCCESS;
+}
@@ -0,0 +1,340 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_CODEC_H_
+#define ECR_CODEC_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ecr/buffer.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Maximum length of an unsigned LEB128 varint holding a 64-bit value.
+ */
+#define ECR_CODEC_VARINT_MAX 10
+
+
+/*
+ * The functions below encode values at a buffer's **length**, within its **capacity**, and decode them from its
+ * **position**, up to its **length**. They are inlined so that fields can be written or read one at a time
+ * without the cost of a stream operation per field; use {@link ecr_codec_begin_write}
+ * and {@link ecr_codec_begin_read} to work on a buffered stream's buffer directly.
+ *
+ * Encoders return {@link ECR_ERROR_FULL_BUFFER} and decoders {@link ECR_ERROR_EOF}
+ * if the buffer is too short for the value, in which case the buffer is left unchanged.
+ */
+
+/**
+ * Get the number of bytes needed to encode **value** as a varint.
+ */
+[[maybe_unused]]
+static size_t ecr_codec_varint_size(uint_least64_t value) {
+    return 1 + (63 - __builtin_clzll(value | 1)) / 7;
+}
+
+/**
+ * Encode an unsigned LEB128 varint: seven bits per byte, least significant first,
+ * with the top bit of each byte set if more follow.
+ *
+ * @param buffer buffer to encode into
+ * @param value value to encode
+ *
+ * @return error code
+ * * {@link ECR_ERROR_FULL_BUFFER} if the buffer is too short
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_codec_put_varint(ecr_buffer_t *buffer, uint_least64_t value) {
+    if(buffer->capacity - buffer->length < ecr_codec_varint_size(value)) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    unsigned char *out = (unsigned char *) buffer->memory + buffer->length;
+
+    size_t size = 0;
+    for(; value >= 0x80; value >>= 7) {
+        out[size++] = (unsigned char) (value | 0x80);
+    }
+    out[size++] = (unsigned char) value;
+
+    buffer->length += size;
+    return ECR_SUCCESS;
+}
+
+/**
+ * Decode an unsigned LEB128 varint.
+ *
+ * @param buffer buffer to decode from
+ * @param value pointer to the value to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the buffer ends partway through the varint
+ * * {@link ECR_ERROR_INVALID_DATA} if the varint is longer than {@link ECR_CODEC_VARINT_MAX} bytes, or exceeds 64 bits
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_codec_get_varint(ecr_buffer_t *buffer, uint_least64_t *value) {
+    const unsigned char *in = (const unsigned char *) buffer->memory + buffer->position;
+    size_t available = buffer->length - buffer->position;
+
+    uint_least64_t result = 0;
+    for(size_t i = 0; i < available && i < ECR_CODEC_VARINT_MAX; i++) {
+        result |= (uint_least64_t) (in[i] & 0x7F) << (7 * i);
+
+        if(!(in[i] & 0x80)) {
+            // the tenth byte may only hold the 64th bit
+            if(i == ECR_CODEC_VARINT_MAX - 1 && in[i] > 1) {
+                return ECR_ERROR_INVALID_DATA;
+            }
+
+            buffer->position += i + 1;
+            *value = result;
+            return ECR_SUCCESS;
+        }
+    }
+
+    return available >= ECR_CODEC_VARINT_MAX ? ECR_ERROR_INVALID_DATA : ECR_ERROR_EOF;
+}
+
+/**
+ * Encode a signed integer as a zigzag varint, which maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+ * so that values of small magnitude take few bytes regardless of sign.
+ *
+ * @param buffer buffer to encode into
+ * @param value value to encode
+ *
+ * @return error code
+ * * {@link ECR_ERROR_FULL_BUFFER} if the buffer is too short
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_codec_put_zigzag(ecr_buffer_t *buffer, int_least64_t value) {
+    return ecr_codec_put_varint(buffer, ((uint_least64_t) value << 1) ^ -(uint_least64_t) (value < 0));
+}
+
+/**
+ * Decode a zigzag varint.
+ *
+ * @param buffer buffer to decode from
+ * @param value pointer to the value to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the buffer ends partway through the varint
+ * * {@link ECR_ERROR_INVALID_DATA} if the varint is malformed
+ *
+ * @see ecr_codec_put_zigzag
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_codec_get_zigzag(ecr_buffer_t *buffer, int_least64_t *value) {
+    uint_least64_t encoded;
+    ECR_STATUS_GUARD(ecr_codec_get_varint(buffer, &encoded));
+
+    *value = (int_least64_t) ((encoded >> 1) ^ -(encoded & 1));
+    return ECR_SUCCESS;
+}
+
+/// \cond
+#define ECR_CODEC_FIXED(bits, order, swap) \
+    [[maybe_unused]] \
+    static ecr_status_t ecr_codec_put_u##bits##order(ecr_buffer_t *buffer, uint_least##bits##_t value) { \
+        if(buffer->capacity - buffer->length < bits / 8) { \
+            return ECR_ERROR_FULL_BUFFER; \
+        } \
+        uint##bits##_t raw = (uint##bits##_t) value; \
+        if(swap) { \
+            raw = __builtin_bswap##bits(raw); \
+        } \
+        memcpy((unsigned char *) buffer->memory + buffer->length, &raw, bits / 8); \
+        buffer->length += bits / 8; \
+        return ECR_SUCCESS; \
+    } \
+    [[maybe_unused]] \
+    static ecr_status_t ecr_codec_get_u##bits##order(ecr_buffer_t *buffer, uint_least##bits##_t *value) { \
+        if(buffer->length - buffer->position < bits / 8) { \
+            return ECR_ERROR_EOF; \
+        } \
+        uint##bits##_t raw; \
+        memcpy(&raw, (const unsigned char *) buffer->memory + buffer->position, bits / 8); \
+        if(swap) { \
+            raw = __builtin_bswap##bits(raw); \
+        } \
+        buffer->position += bits / 8; \
+        *value = raw; \
+        return ECR_SUCCESS; \
+    }
+/// \endcond
+
+/*
+ * Fixed-width integers: ecr_codec_put_u<bits><order>(buffer, value) and ecr_codec_get_u<bits><order>(buffer, &value),
+ * for 16, 32 and 64 bits, in little (le) or big (be) endian order. Each is a single unaligned load or store,
+ * byte swapped if the order differs from the host's.
+ */
+ECR_CODEC_FIXED(16, le, __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+ECR_CODEC_FIXED(32, le, __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+ECR_CODEC_FIXED(64, le, __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+ECR_CODEC_FIXED(16, be, __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+ECR_CODEC_FIXED(32, be, __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+ECR_CODEC_FIXED(64, be, __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+/**
+ * Encode length-delimited bytes, as a varint length followed by the bytes themselves.
+ *
+ * @param buffer buffer to encode into
+ * @param memory bytes to encode
+ * @param length number of bytes to encode
+ *
+ * @return error code
+ * * {@link ECR_ERROR_FULL_BUFFER} if the buffer is too short
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_codec_put_bytes(ecr_buffer_t *buffer, const void *memory, size_t length) {
+    size_t space = buffer->capacity - buffer->length;
+    size_t prefix_size = ecr_codec_varint_size(length);
+    if(space < prefix_size || space - prefix_size < length) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ecr_codec_put_varint(buffer, length);
+    if(length > 0) {
+        memcpy((unsigned char *) buffer->memory + buffer->length, memory, length);
+    }
+    buffer->length += length;
+
+    return ECR_SUCCESS;
+}
+
+/**
+ * Decode length-delimited bytes, and get a view of them within the buffer.
+ *
+ * @param buffer buffer to decode from
+ * @param memory pointer to the start of the bytes to be returned
+ * @param length pointer to the number of bytes to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the buffer ends partway through the length or the bytes
+ * * {@link ECR_ERROR_INVALID_DATA} if the length is malformed
+ *
+ * @see ecr_codec_put_bytes
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_codec_get_bytes(ecr_buffer_t *buffer, const void **memory, size_t *length) {
+    size_t position = buffer->position;
+
+    uint_least64_t encoded_length;
+    ECR_STATUS_GUARD(ecr_codec_get_varint(buffer, &encoded_length));
+
+    if(buffer->length - buffer->position < encoded_length) {
+        buffer->position = position;
+        return ECR_ERROR_EOF;
+    }
+
+    *memory = (const unsigned char *) buffer->memory + buffer->position;
+    *length = (size_t) encoded_length;
+    buffer->position += (size_t) encoded_length;
+
+    return ECR_SUCCESS;
+}
+
+/**
+ * Decode a run of up to **count** varints.
+ *
+ * Runs of single-byte varints are widened sixteen at a time, and longer ones are decoded
+ * with a few shifts and masks each, rather than a loop over their bytes.
+ *
+ * @param buffer buffer to decode from
+ * @param values array of at least **count** values to be returned
+ * @param count number of varints to decode
+ * @param decoded pointer to the number of varints decoded; set even if an error is returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the buffer ends before **count** varints
+ * * {@link ECR_ERROR_INVALID_DATA} if a varint is malformed; it and any after it are left undecoded
+ */
+ecr_status_t ecr_codec_get_varints(ecr_buffer_t *buffer, uint_least64_t *values, size_t count, size_t *decoded);
+
+
+/**
+ * Get space of at least **minimum** bytes in a buffered stream's buffer to encode into.
+ *
+ * **buffer** is set to describe the space, empty; encode into it with the `ecr_codec_put_*` functions,
+ * then commit what was encoded with {@link ecr_codec_end_write}.
+ *
+ * @param stream buffered stream (see {@link ecr_stream_open_buffered}) to write to
+ * @param minimum number of bytes required
+ * @param buffer buffer to be set
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a buffered stream
+ *
+ * @see ecr_stream_buffered_reserve
+ */
+ecr_status_t ecr_codec_begin_write(ecr_stream_t *stream, size_t minimum, ecr_buffer_t *buffer);
+
+/**
+ * Commit the bytes encoded into a buffer obtained with {@link ecr_codec_begin_write}, as if they had been written.
+ *
+ * @param stream buffered stream the buffer was obtained from
+ * @param buffer buffer holding the encoded bytes
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a buffered stream
+ */
+ecr_status_t ecr_codec_end_write(ecr_stream_t *stream, const ecr_buffer_t *buffer);
+
+/**
+ * Read ahead until a buffered stream holds at least **minimum** unread bytes, and get them as a buffer to decode from.
+ *
+ * Decode from **buffer** with the `ecr_codec_get_*` functions, then consume what was decoded
+ * with {@link ecr_codec_end_read}. If a decoder runs out of data, end the read and begin another
+ * with a larger **minimum**.
+ *
+ * @param stream buffered stream (see {@link ecr_stream_open_buffered}) to read from
+ * @param minimum number of unread bytes required
+ * @param buffer buffer to be set; set even if {@link ECR_ERROR_EOF} is returned, in which case it may be short of **minimum**
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the stream ended before enough data could be read
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a buffered stream
+ *
+ * @see ecr_stream_buffered_fill
+ */
+ecr_status_t ecr_codec_begin_read(ecr_stream_t *stream, size_t minimum, ecr_buffer_t *buffer);
+
+/**
+ * Consume the bytes decoded from a buffer obtained with {@link ecr_codec_begin_read}, as if they had been read.
+ *
+ * @param stream buffered stream the buffer was obtained from
+ * @param buffer buffer the bytes were decoded from
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a buffered stream
+ */
+ecr_status_t ecr_codec_end_read(ecr_stream_t *stream, const ecr_buffer_t *buffer);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
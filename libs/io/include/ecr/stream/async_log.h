@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_ASYNC_LOG_H_
+#define ECR_STREAM_ASYNC_LOG_H_
+
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Type for defining what happens when a message is logged while the log's queue is full.
+ */
+typedef enum : uint_least32_t {
+    /// wait until the background thread frees up space
+    ECR_ASYNC_LOG_OVERFLOW_BLOCK = 0,
+    /// discard the message and return {@link ECR_ERROR_FULL_BUFFER}
+    ECR_ASYNC_LOG_OVERFLOW_DROP  = 1,
+    /// discard the message, count it and return successfully
+    ECR_ASYNC_LOG_OVERFLOW_COUNT = 2,
+} ecr_async_log_overflow_t;
+
+/**
+ * Struct to configure an asynchronous log.
+ * @param capacity number of messages that can be queued at once; rounded up to a power of two
+ * @param record_size maximum number of bytes a message's captured arguments (including copied strings) may take up
+ * @param batch_size number of formatted messages after which output is written to the sink
+ * @param max_latency_ns maximum number of nanoseconds a formatted message may wait before being written to the sink
+ * @param overflow see {@link ecr_async_log_overflow_t}
+ */
+typedef struct ecr_async_log_config {
+    size_t capacity;
+    size_t record_size;
+    size_t batch_size;
+    uint_least64_t max_latency_ns;
+    ecr_async_log_overflow_t overflow;
+} ecr_async_log_config_t;
+
+/**
+ * Instantiates a reasonable default asynchronous log configuration.
+ */
+#define ecr_async_log_config_default ((ecr_async_log_config_t) { .capacity = 4096, .record_size = 240, .batch_size = 64, .max_latency_ns = 1000000, .overflow = ECR_ASYNC_LOG_OVERFLOW_BLOCK })
+
+/**
+ * Opaque type representing an asynchronous log.
+ */
+typedef struct ecr_async_log ecr_async_log_t;
+
+/**
+ * Open an asynchronous log writing to a **sink** stream.
+ *
+ * Logging a message only captures its arguments in binary form on the calling thread;
+ * formatting and writing happen on a background thread owned by the log.
+ *
+ * @param log_ptr pointer to the pointer which will store the log on success
+ * @param sink stream to write formatted messages to; it must remain valid until the log is closed
+ * @param allocator thread-safe allocator used for the log's state;
+ * it must remain valid until the log is closed
+ * @param config log configuration
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} for a zero capacity or batch size
+ */
+ecr_status_t ecr_async_log_open(ecr_async_log_t **log_ptr, ecr_stream_t *sink, ecr_allocator_t *allocator, const ecr_async_log_config_t *config);
+
+/**
+ * Flush and close an asynchronous log.
+ * No other thread may be logging to it concurrently.
+ *
+ * @param log log to close
+ *
+ * @return error code; the first error encountered while writing to the sink, if any
+ */
+ecr_status_t ecr_async_log_close(ecr_async_log_t *log);
+
+/**
+ * Log a message in the same formatting conventions as the `printf()` family of functions.
+ * May be called from any number of threads at once.
+ *
+ * @param log log to write to
+ * @param format format string; it is read again when the message is formatted,
+ * so it must remain valid until the log is closed (e.g. a string literal)
+ * @param ... formatted arguments; strings are copied
+ *
+ * @return error code
+ * * {@link ECR_ERROR_FULL_BUFFER} if the captured arguments exceed the configured record size
+ * * {@link ECR_ERROR_FULL_BUFFER} if the queue is full and the log drops messages with {@link ECR_ASYNC_LOG_OVERFLOW_DROP}
+ * * {@link ECR_ERROR_NOT_SUPPORTED} for `%n`, positional or wide-character conversions
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} for a malformed format string
+ * * any error previously encountered while writing to the sink
+ */
+ecr_status_t ecr_async_log_printf(ecr_async_log_t *log, const char *format, ...);
+
+/**
+ * Log a message in the same formatting conventions as the `printf()` family of functions.
+ *
+ * @param log log to write to
+ * @param format format string
+ * @param vlist formatted arguments
+ *
+ * @return error code
+ *
+ * @see ecr_async_log_printf
+ */
+ecr_status_t ecr_async_log_vprintf(ecr_async_log_t *log, const char *format, va_list vlist);
+
+/**
+ * Learn how many messages were discarded because the queue was full.
+ *
+ * @param log log to query
+ * @param dropped pointer to the count to be returned
+ *
+ * @return error code
+ */
+ecr_status_t ecr_async_log_dropped(ecr_async_log_t *log, uint_least64_t *dropped);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_BUFFERED_H_
+#define ECR_STREAM_BUFFERED_H_
+
+
+#include <stddef.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Open a stream which buffers reads from and writes to an **inner** stream.
+ *
+ * Reads are served from a buffer which is refilled with one large read at a time, and writes are collected
+ * in the same buffer until it is full, flushed or the stream is repositioned or closed. Reads and writes
+ * larger than the buffer bypass it. Switching from reading to writing requires the inner stream
+ * to support rewinding over any data read ahead. The inner stream is not closed.
+ *
+ * Besides plain reads and writes, the buffer can be accessed directly, without copying,
+ * with {@link ecr_stream_buffered_fill} and {@link ecr_stream_buffered_reserve}.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param inner stream to buffer; it must remain valid until the stream is closed
+ * @param allocator allocator used for the stream's state and buffer; it must remain valid until the stream is closed
+ * @param capacity initial size of the buffer
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **capacity** is zero
+ */
+ecr_status_t ecr_stream_open_buffered(ecr_stream_t *stream, ecr_stream_t *inner, ecr_allocator_t *allocator, size_t capacity);
+
+/**
+ * Write any data buffered in a buffered stream to its inner stream.
+ *
+ * @param stream buffered stream to flush
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered}
+ */
+ecr_status_t ecr_stream_buffered_flush(ecr_stream_t *stream);
+
+/**
+ * Read ahead until a buffered stream holds at least **minimum** unread bytes, and get a view of them,
+ * growing its buffer if necessary.
+ *
+ * The view remains valid until the next operation on the stream. The bytes in it are not consumed;
+ * use {@link ecr_stream_buffered_consume} for that.
+ *
+ * @param stream buffered stream to read from
+ * @param minimum number of unread bytes required
+ * @param memory pointer to the start of the view to be returned; set even if an error is returned
+ * @param length pointer to the length of the view to be returned, which may exceed **minimum**;
+ * set even if an error is returned, in which case it may be short of **minimum**
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the inner stream ended before enough data could be read
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered}
+ */
+ecr_status_t ecr_stream_buffered_fill(ecr_stream_t *stream, size_t minimum, const void **memory, size_t *length);
+
+/**
+ * Consume unread bytes in a buffered stream, as if they had been read.
+ *
+ * @param stream buffered stream to consume from
+ * @param length number of bytes to consume; at most the number of unread bytes held by the stream
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered},
+ * or holds fewer than **length** unread bytes
+ */
+ecr_status_t ecr_stream_buffered_consume(ecr_stream_t *stream, size_t length);
+
+/**
+ * Get writable space of at least **minimum** bytes in a buffered stream's buffer,
+ * flushing or growing the buffer if necessary.
+ *
+ * Nothing is written until the space is committed with {@link ecr_stream_buffered_commit}.
+ * The space remains valid until the next operation on the stream.
+ *
+ * @param stream buffered stream to write to
+ * @param minimum number of bytes required
+ * @param memory pointer to the start of the space to be returned
+ * @param length pointer to the length of the space to be returned, which may exceed **minimum**
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered}
+ */
+ecr_status_t ecr_stream_buffered_reserve(ecr_stream_t *stream, size_t minimum, void **memory, size_t *length);
+
+/**
+ * Commit bytes written into space obtained with {@link ecr_stream_buffered_reserve}, as if they had been written.
+ *
+ * @param stream buffered stream to commit to
+ * @param length number of bytes to commit; at most the length of the reserved space
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered},
+ * or has less than **length** bytes of space
+ */
+ecr_status_t ecr_stream_buffered_commit(ecr_stream_t *stream, size_t length);
+
+/**
+ * Read a record ending in a **delimiter** byte from a buffered stream, and get a view of it.
+ *
+ * The record is found in the stream's buffer and returned without copying. Records spanning more than
+ * the data currently buffered are completed by reading ahead, growing the buffer as needed.
+ * The final record may lack the delimiter if the stream ends without one.
+ * The view remains valid until the next operation on the stream.
+ *
+ * @param stream buffered stream to read from
+ * @param delimiter byte ending each record
+ * @param max_length maximum length of a record, including its delimiter
+ * @param record pointer to the start of the record to be returned
+ * @param length pointer to the length of the record to be returned, including its delimiter if present
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if there are no more records
+ * * {@link ECR_ERROR_FULL_BUFFER} if the record is longer than **max_length**; it is left unread
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered}
+ */
+ecr_status_t ecr_stream_read_until(ecr_stream_t *stream, unsigned char delimiter, size_t max_length, const void **record, size_t *length);
+
+/**
+ * Read a line from a buffered stream, and get a view of it.
+ *
+ * Behaves like {@link ecr_stream_read_until} with a `'\n'` delimiter,
+ * except that the line ending (`"\n"` or `"\r\n"`) is not included in the line.
+ *
+ * @param stream buffered stream to read from
+ * @param max_length maximum length of a line, including its line ending
+ * @param line pointer to the start of the line to be returned
+ * @param length pointer to the length of the line to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if there are no more lines
+ * * {@link ECR_ERROR_FULL_BUFFER} if the line is longer than **max_length**; it is left unread
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered}
+ */
+ecr_status_t ecr_stream_readline(ecr_stream_t *stream, size_t max_length, const char **line, size_t *length);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_CHECKSUM_H_
+#define ECR_STREAM_CHECKSUM_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Update a running CRC-32C (Castagnoli) checksum with **length** bytes from **memory**.
+ *
+ * Uses the `crc32` instruction where the processor supports it, and a table-driven implementation otherwise.
+ *
+ * @param crc checksum of the data so far; 0 to start a new checksum
+ * @param memory data to add to the checksum
+ * @param length number of bytes in **memory**
+ *
+ * @return the updated checksum
+ */
+uint_least32_t ecr_crc32c(uint_least32_t crc, const void *memory, size_t length);
+
+/**
+ * Open a stream which passes reads and writes through to an **inner** stream,
+ * keeping a running CRC-32C checksum of every byte read from or written to it.
+ *
+ * Since the checksum covers the data in the order it passes through the stream,
+ * the stream's position cannot be changed. The inner stream is not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param inner stream to pass reads and writes to; it must remain valid until the stream is closed
+ * @param allocator allocator used for the stream's state; it must remain valid until the stream is closed
+ *
+ * @return error code
+ */
+ecr_status_t ecr_stream_open_checksum(ecr_stream_t *stream, ecr_stream_t *inner, ecr_allocator_t *allocator);
+
+/**
+ * Get the checksum of all data that has passed through a checksum stream so far.
+ *
+ * @param stream checksum stream to query
+ * @param digest pointer to the checksum to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_checksum}
+ */
+ecr_status_t ecr_stream_checksum_digest(ecr_stream_t *stream, uint_least32_t *digest);
+
+/**
+ * Check the checksum of all data that has passed through a checksum stream so far against an **expected** value.
+ *
+ * @param stream checksum stream to verify
+ * @param expected expected checksum
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_DATA} if the checksums differ
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_checksum}
+ */
+ecr_status_t ecr_stream_checksum_verify(ecr_stream_t *stream, uint_least32_t expected);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_COMPRESS_H_
+#define ECR_STREAM_COMPRESS_H_
+
+
+#include <stddef.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/// Largest block size a compressed stream may use.
+#define ECR_STREAM_COMPRESS_BLOCK_MAX (1 << 24)
+
+/**
+ * Open a write-only stream which compresses everything written into it, and writes the result to a **sink** stream.
+ *
+ * Data is split into blocks of **block_size** bytes, each compressed separately with a fast LZ-style codec;
+ * blocks which do not compress are stored as they are. Writes of whole blocks are compressed directly from
+ * the caller's memory. Any remaining data and the end of the compressed data are written when the stream is closed.
+ * If a write to the sink fails, the compressed data is left incomplete. The sink itself is not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param sink stream to write compressed data to; it must remain valid until the stream is closed
+ * @param allocator allocator used for the stream's state and buffers; it must remain valid until the stream is closed
+ * @param block_size number of bytes compressed at a time; at most {@link ECR_STREAM_COMPRESS_BLOCK_MAX}
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **block_size** is zero or too large
+ */
+ecr_status_t ecr_stream_open_compress(ecr_stream_t *stream, ecr_stream_t *sink, ecr_allocator_t *allocator, size_t block_size);
+
+/**
+ * Open a read-only stream which decompresses data read from a **source** stream,
+ * as written by a stream opened with {@link ecr_stream_open_compress}.
+ *
+ * Reading from the stream returns {@link ECR_ERROR_INVALID_DATA} if the compressed data is malformed or truncated,
+ * and {@link ECR_ERROR_EOF} once all of it has been read. The source itself is not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param source stream to read compressed data from; it must remain valid until the stream is closed
+ * @param allocator allocator used for the stream's state and buffers; it must remain valid until the stream is closed
+ *
+ * @return error code
+ */
+ecr_status_t ecr_stream_open_decompress(ecr_stream_t *stream, ecr_stream_t *source, ecr_allocator_t *allocator);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
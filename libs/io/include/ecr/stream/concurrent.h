@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_CONCURRENT_H_
+#define ECR_STREAM_CONCURRENT_H_
+
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Open a write-only stream that may be written to from any number of threads at once,
+ * forwarding everything written into it to a **sink** stream.
+ *
+ * Each write is copied into a record and appended to a lock-free queue without blocking the writer.
+ * A dedicated thread drains the queue in batches, so that the bytes of any single write are never
+ * interleaved with those of another. If the sink is a file descriptor stream, batches are
+ * submitted with a single `writev()` call, and if it is a socket stream, with a single `sendmsg()` call
+ * honoring the socket's options.
+ *
+ * An error encountered while writing to the sink is returned by every subsequent write,
+ * as well as by {@link ecr_stream_close}, which flushes any remaining records.
+ * The sink itself is not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param sink stream to forward writes to; it must remain valid until the stream is closed
+ * @param allocator thread-safe allocator used for the stream's state and records;
+ * it must remain valid until the stream is closed
+ *
+ * @return error code
+ */
+ecr_status_t ecr_stream_open_concurrent(ecr_stream_t *stream, ecr_stream_t *sink, ecr_allocator_t *allocator);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
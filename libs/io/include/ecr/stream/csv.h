@@ -0,0 +1,88 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_CSV_H_
+#define ECR_STREAM_CSV_H_
+
+
+#include <stddef.h>
+
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Struct to represent a field of a delimited text record, as a view into a buffered stream's buffer.
+ * @param memory pointer to the start of the field, after any opening quote
+ * @param length length of the field, excluding any quotes around it
+ * @param escaped whether the field holds doubled quotes, which {@link ecr_csv_unescape} turns into single ones
+ */
+typedef struct ecr_csv_field {
+    const char *memory;
+    size_t length;
+    bool escaped;
+} ecr_csv_field_t;
+
+/**
+ * Read a record of delimited text (CSV, TSV and the like) from a buffered stream, and get views of its fields.
+ *
+ * Records end at a newline (`"\n"` or `"\r\n"`) or at the end of the stream, and fields are separated by **delimiter**.
+ * If **quoting** is set, fields may be enclosed in double quotes, within which delimiters and newlines
+ * are part of the field and quotes are escaped by doubling them. An empty line is a record with one empty field.
+ *
+ * The record is found in the stream's buffer and its fields are returned without copying. Quotes, delimiters and
+ * newlines are located 64 bytes at a time with SIMD comparisons, and records spanning more than the data currently
+ * buffered, including quoted fields, are completed by reading ahead and growing the buffer as needed.
+ * The views remain valid until the next operation on the stream.
+ *
+ * @param stream buffered stream (see {@link ecr_stream_open_buffered}) to read from
+ * @param delimiter byte separating fields, e.g. `','` or `'\t'`
+ * @param quoting whether fields may be quoted
+ * @param max_length maximum length of a record, including its line ending
+ * @param fields array of at least **max_fields** fields to be returned
+ * @param max_fields maximum number of fields in a record
+ * @param count pointer to the number of fields to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if there are no more records
+ * * {@link ECR_ERROR_FULL_BUFFER} if the record is longer than **max_length** or has more than **max_fields** fields;
+ * it is left unread
+ * * {@link ECR_ERROR_INVALID_DATA} if the stream ends within a quoted field
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a buffered stream
+ */
+ecr_status_t ecr_stream_read_csv(ecr_stream_t *stream, unsigned char delimiter, bool quoting, size_t max_length, ecr_csv_field_t *fields, size_t max_fields, size_t *count);
+
+/**
+ * Copy a field's contents with doubled quotes turned into single ones.
+ *
+ * @param field field to unescape
+ * @param out memory of at least **field**'s length to copy into
+ *
+ * @return length of the unescaped field
+ */
+size_t ecr_csv_unescape(const ecr_csv_field_t *field, char *out);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
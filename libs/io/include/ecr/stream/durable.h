@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_DURABLE_H_
+#define ECR_STREAM_DURABLE_H_
+
+
+#include <stdint.h>
+
+#include <ecr/allocator.h>
+#include <ecr/buffer.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Type for identifying a record submitted to a durable stream.
+ * Tickets increase monotonically in submission order.
+ */
+typedef uint_least64_t ecr_stream_durable_ticket_t;
+
+/**
+ * Open a write-only stream which appends records durably to a **file** stream,
+ * committing concurrently submitted records as a group.
+ *
+ * Whichever waiting thread finds no commit in progress becomes the committer: it appends every pending record
+ * with `writev()` and then issues a single `fdatasync()` for the whole group, while the other threads wait for it.
+ * Writing to the stream submits the written bytes as one record and waits until it is durable.
+ *
+ * Once a commit fails the stream stays failed, returning the same error for every subsequent operation,
+ * since it can no longer tell which records reached storage.
+ * The file stream itself is not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param file stream backed by a file descriptor opened with {@link ECR_FILEMODE_APPEND};
+ * it must remain valid until the stream is closed
+ * @param allocator thread-safe allocator used for the stream's state and submitted records;
+ * it must remain valid until the stream is closed
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **file** is not a file descriptor stream in append mode
+ */
+ecr_status_t ecr_stream_open_durable(ecr_stream_t *stream, ecr_stream_t *file, ecr_allocator_t *allocator);
+
+/**
+ * Submit the remaining contents of a **buffer** as a record without waiting for it to become durable,
+ * advancing the buffer's position to its length.
+ * The contents are copied, so the buffer may be reused immediately.
+ *
+ * @param stream durable stream to submit to
+ * @param buffer buffer to submit from
+ * @param ticket pointer to the ticket to be returned, to be passed to {@link ecr_stream_durable_wait}
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_durable}
+ */
+ecr_status_t ecr_stream_durable_submit(ecr_stream_t *stream, ecr_buffer_t *restrict buffer, ecr_stream_durable_ticket_t *ticket);
+
+/**
+ * Wait until the record identified by **ticket**, and every record submitted before it, is durable.
+ *
+ * @param stream durable stream the record was submitted to
+ * @param ticket ticket returned when the record was submitted
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_durable}
+ */
+ecr_status_t ecr_stream_durable_wait(ecr_stream_t *stream, ecr_stream_durable_ticket_t ticket);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
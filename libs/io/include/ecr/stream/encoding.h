@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_ENCODING_H_
+#define ECR_STREAM_ENCODING_H_
+
+
+#include <stdint.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Type for selecting a binary-to-text encoding.
+ */
+typedef enum : uint_least32_t {
+    /// hexadecimal; encodes to lowercase digits and decodes either case
+    ECR_ENCODING_HEX    = 0,
+    /// base64 with the standard alphabet and `=` padding (RFC 4648)
+    ECR_ENCODING_BASE64 = 1,
+} ecr_encoding_t;
+
+/**
+ * Open a write-only stream which encodes everything written into it as text, and writes the text to a **sink** stream.
+ *
+ * Data is encoded in large blocks, using SIMD kernels where the processor supports them.
+ * Any final partial base64 group is padded and written when the stream is closed.
+ * The sink itself is not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param sink stream to write encoded text to; it must remain valid until the stream is closed
+ * @param encoding encoding to use
+ * @param allocator allocator used for the stream's state; it must remain valid until the stream is closed
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} for an unknown encoding
+ */
+ecr_status_t ecr_stream_open_encode(ecr_stream_t *stream, ecr_stream_t *sink, ecr_encoding_t encoding, ecr_allocator_t *allocator);
+
+/**
+ * Open a read-only stream which decodes text read from a **source** stream.
+ *
+ * Reading from the stream returns {@link ECR_ERROR_INVALID_DATA} if the text contains anything other than
+ * the encoding's characters (including whitespace), is misplaced padding, or ends partway through a group,
+ * and {@link ECR_ERROR_EOF} once all of it has been read. The source itself is not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param source stream to read encoded text from; it must remain valid until the stream is closed
+ * @param encoding encoding to use
+ * @param allocator allocator used for the stream's state; it must remain valid until the stream is closed
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} for an unknown encoding
+ */
+ecr_status_t ecr_stream_open_decode(ecr_stream_t *stream, ecr_stream_t *source, ecr_encoding_t encoding, ecr_allocator_t *allocator);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
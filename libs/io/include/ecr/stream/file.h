@@ -46,6 +46,8 @@ typedef enum : uint_least32_t {
 
     /// Create file if nonexistent
     ECR_FILEMODE_CREATE     = (1 << 8),
+    /// Return {@link ECR_ERROR_AGAIN} instead of blocking
+    ECR_FILEMODE_NONBLOCK   = (1 << 9),
 } ecr_filemode_t;
 
 /**
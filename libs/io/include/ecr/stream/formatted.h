@@ -19,6 +19,8 @@
 
 
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #include <ecr/error.h>
 #include <ecr/stream.h>
@@ -52,6 +54,181 @@ ecr_status_t ecr_stream_printf(ecr_stream_t *stream, const char *format, ...);
  */
 ecr_status_t ecr_stream_vprintf(ecr_stream_t *stream, const char *format, va_list vlist);
 
+/**
+ * Type for identifying what kind of value a {@link ecr_format_segment_t} holds.
+ */
+typedef enum : uint_least32_t {
+    /// null-terminated string, written as is
+    ECR_FORMAT_STRING  = 0,
+    /// single character
+    ECR_FORMAT_CHAR    = 1,
+    /// signed integer, written in decimal
+    ECR_FORMAT_INT     = 2,
+    /// unsigned integer, written in decimal
+    ECR_FORMAT_UINT    = 3,
+    /// floating-point number, written with the fewest digits which read back as the same value
+    ECR_FORMAT_FLOAT   = 4,
+    /// boolean, written as `true` or `false`
+    ECR_FORMAT_BOOL    = 5,
+    /// pointer, written in hexadecimal with a `0x` prefix
+    ECR_FORMAT_POINTER = 6,
+} ecr_format_kind_t;
+
+/**
+ * Struct holding one value to be written by {@link ecr_format_segments}.
+ * @param kind kind of value held
+ */
+typedef struct ecr_format_segment {
+    ecr_format_kind_t kind;
+    union {
+        const char *string;
+        char character;
+        int_least64_t integer;
+        uint_least64_t unsigned_integer;
+        double floating;
+        bool boolean;
+        const void *pointer;
+    };
+} ecr_format_segment_t;
+
+/**
+ * Write a sequence of values to the specified stream, each according to its kind.
+ *
+ * Output is collected in a small buffer on the stack and written in as few writes as possible.
+ * This is usually called through {@link ecr_format}, rather than directly.
+ *
+ * @param stream stream to write to
+ * @param segments values to write
+ * @param count number of values to write
+ *
+ * @return error code
+ */
+ecr_status_t ecr_format_segments(ecr_stream_t *stream, const ecr_format_segment_t *segments, size_t count);
+
+/// \cond
+[[maybe_unused]]
+static ecr_format_segment_t ecr_format_segment_string(const char *value) {
+    return (ecr_format_segment_t) { .kind = ECR_FORMAT_STRING, .string = value };
+}
+
+[[maybe_unused]]
+static ecr_format_segment_t ecr_format_segment_char(char value) {
+    return (ecr_format_segment_t) { .kind = ECR_FORMAT_CHAR, .character = value };
+}
+
+[[maybe_unused]]
+static ecr_format_segment_t ecr_format_segment_int(int_least64_t value) {
+    return (ecr_format_segment_t) { .kind = ECR_FORMAT_INT, .integer = value };
+}
+
+[[maybe_unused]]
+static ecr_format_segment_t ecr_format_segment_uint(uint_least64_t value) {
+    return (ecr_format_segment_t) { .kind = ECR_FORMAT_UINT, .unsigned_integer = value };
+}
+
+[[maybe_unused]]
+static ecr_format_segment_t ecr_format_segment_float(double value) {
+    return (ecr_format_segment_t) { .kind = ECR_FORMAT_FLOAT, .floating = value };
+}
+
+[[maybe_unused]]
+static ecr_format_segment_t ecr_format_segment_bool(bool value) {
+    return (ecr_format_segment_t) { .kind = ECR_FORMAT_BOOL, .boolean = value };
+}
+
+[[maybe_unused]]
+static ecr_format_segment_t ecr_format_segment_pointer(const void *value) {
+    return (ecr_format_segment_t) { .kind = ECR_FORMAT_POINTER, .pointer = value };
+}
+
+#define ECR_FORMAT_CONCAT_(a, b) a##b
+#define ECR_FORMAT_CONCAT(a, b) ECR_FORMAT_CONCAT_(a, b)
+
+#define ECR_FORMAT_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, count, ...) count
+#define ECR_FORMAT_COUNT(...) ECR_FORMAT_COUNT_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define ECR_FORMAT_MAP_1(m, x)       m(x)
+#define ECR_FORMAT_MAP_2(m, x, ...)  m(x), ECR_FORMAT_MAP_1(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_3(m, x, ...)  m(x), ECR_FORMAT_MAP_2(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_4(m, x, ...)  m(x), ECR_FORMAT_MAP_3(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_5(m, x, ...)  m(x), ECR_FORMAT_MAP_4(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_6(m, x, ...)  m(x), ECR_FORMAT_MAP_5(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_7(m, x, ...)  m(x), ECR_FORMAT_MAP_6(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_8(m, x, ...)  m(x), ECR_FORMAT_MAP_7(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_9(m, x, ...)  m(x), ECR_FORMAT_MAP_8(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_10(m, x, ...) m(x), ECR_FORMAT_MAP_9(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_11(m, x, ...) m(x), ECR_FORMAT_MAP_10(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_12(m, x, ...) m(x), ECR_FORMAT_MAP_11(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_13(m, x, ...) m(x), ECR_FORMAT_MAP_12(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_14(m, x, ...) m(x), ECR_FORMAT_MAP_13(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_15(m, x, ...) m(x), ECR_FORMAT_MAP_14(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_16(m, x, ...) m(x), ECR_FORMAT_MAP_15(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_17(m, x, ...) m(x), ECR_FORMAT_MAP_16(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_18(m, x, ...) m(x), ECR_FORMAT_MAP_17(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_19(m, x, ...) m(x), ECR_FORMAT_MAP_18(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_20(m, x, ...) m(x), ECR_FORMAT_MAP_19(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_21(m, x, ...) m(x), ECR_FORMAT_MAP_20(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_22(m, x, ...) m(x), ECR_FORMAT_MAP_21(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_23(m, x, ...) m(x), ECR_FORMAT_MAP_22(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_24(m, x, ...) m(x), ECR_FORMAT_MAP_23(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_25(m, x, ...) m(x), ECR_FORMAT_MAP_24(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_26(m, x, ...) m(x), ECR_FORMAT_MAP_25(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_27(m, x, ...) m(x), ECR_FORMAT_MAP_26(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_28(m, x, ...) m(x), ECR_FORMAT_MAP_27(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_29(m, x, ...) m(x), ECR_FORMAT_MAP_28(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_30(m, x, ...) m(x), ECR_FORMAT_MAP_29(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_31(m, x, ...) m(x), ECR_FORMAT_MAP_30(m, __VA_ARGS__)
+#define ECR_FORMAT_MAP_32(m, x, ...) m(x), ECR_FORMAT_MAP_31(m, __VA_ARGS__)
+/// \endcond
+
+/**
+ * Convert a value to a {@link ecr_format_segment_t}, choosing its kind from its type at compile time.
+ *
+ * Strings (`char *`), `char`, signed and unsigned integer types, `float`, `double`, `bool` and `void *`
+ * are supported; any other type is a compile-time error.
+ *
+ * @param value value to convert
+ */
+#define ECR_FORMAT_SEGMENT(value) _Generic((value), \
+    char *:             ecr_format_segment_string, \
+    const char *:       ecr_format_segment_string, \
+    char:               ecr_format_segment_char, \
+    signed char:        ecr_format_segment_int, \
+    short:              ecr_format_segment_int, \
+    int:                ecr_format_segment_int, \
+    long:               ecr_format_segment_int, \
+    long long:          ecr_format_segment_int, \
+    unsigned char:      ecr_format_segment_uint, \
+    unsigned short:     ecr_format_segment_uint, \
+    unsigned int:       ecr_format_segment_uint, \
+    unsigned long:      ecr_format_segment_uint, \
+    unsigned long long: ecr_format_segment_uint, \
+    float:              ecr_format_segment_float, \
+    double:             ecr_format_segment_float, \
+    bool:               ecr_format_segment_bool, \
+    void *:             ecr_format_segment_pointer, \
+    const void *:       ecr_format_segment_pointer \
+)(value)
+
+/**
+ * Write up to 32 values to the specified stream, each formatted according to its type,
+ * e.g. `ecr_format(stream, "x=", x, " y=", y, "\n")`.
+ *
+ * Each value's formatter is picked at compile time (see {@link ECR_FORMAT_SEGMENT}),
+ * so there is no format string to parse, and no way for a value to mismatch its format.
+ *
+ * @param stream stream to write to
+ * @param ... values to write
+ *
+ * @return error code
+ *
+ * @see ecr_format_segments
+ */
+#define ecr_format(stream, ...) \
+    ecr_format_segments((stream), \
+        (const ecr_format_segment_t[]) { ECR_FORMAT_CONCAT(ECR_FORMAT_MAP_, ECR_FORMAT_COUNT(__VA_ARGS__))(ECR_FORMAT_SEGMENT, __VA_ARGS__) }, \
+        ECR_FORMAT_COUNT(__VA_ARGS__))
+
 
 #ifdef __cplusplus
 }
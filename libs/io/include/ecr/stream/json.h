@@ -0,0 +1,196 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_JSON_H_
+#define ECR_STREAM_JSON_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Maximum nesting depth of objects and arrays written with a {@link ecr_json_writer_t}.
+ */
+#define ECR_JSON_MAX_DEPTH 64
+
+
+/**
+ * Struct to represent the state of a JSON writer. Its members should not be accessed directly.
+ * @param stream buffered stream written to
+ * @param objects bit stack recording which open containers are objects rather than arrays
+ * @param depth number of open containers
+ * @param comma whether a value precedes the next one in the current container
+ * @param key whether a key was written and awaits its value
+ */
+typedef struct ecr_json_writer {
+    ecr_stream_t *stream;
+    uint_least64_t objects;
+    uint_least32_t depth;
+    bool comma, key;
+} ecr_json_writer_t;
+
+/**
+ * Initialize a JSON writer which writes to a buffered stream.
+ *
+ * Values are written straight into the stream's buffer, without whitespace. Each value written outside any container
+ * is a complete JSON text; consecutive ones are separated by newlines, as in JSON Lines.
+ * Nesting is tracked in the writer itself, so writing never allocates.
+ *
+ * @param writer pointer to the writer to be initialized
+ * @param stream buffered stream (see {@link ecr_stream_open_buffered}) to write to;
+ * it must remain valid for as long as the writer is used
+ */
+void ecr_json_writer_init(ecr_json_writer_t *writer, ecr_stream_t *stream);
+
+/*
+ * The functions below write to a JSON writer, returning an error code.
+ * Their common errors are:
+ * * ECR_ERROR_INVALID_ARGUMENT if the call doesn't fit the structure written so far, e.g. a value in an object
+ *   without a key, a key outside of an object, or closing a container that isn't open; nothing is written
+ * * ECR_ERROR_INVALID_ARGUMENT if the writer's stream is not a buffered stream
+ */
+
+/**
+ * Open an object, as a value.
+ *
+ * @param writer JSON writer to write to
+ *
+ * @return error code
+ * * {@link ECR_ERROR_FULL_BUFFER} if {@link ECR_JSON_MAX_DEPTH} containers are already open
+ */
+ecr_status_t ecr_json_begin_object(ecr_json_writer_t *writer);
+
+/**
+ * Close the innermost open container, which must be an object.
+ *
+ * @param writer JSON writer to write to
+ *
+ * @return error code
+ */
+ecr_status_t ecr_json_end_object(ecr_json_writer_t *writer);
+
+/**
+ * Open an array, as a value.
+ *
+ * @param writer JSON writer to write to
+ *
+ * @return error code
+ * * {@link ECR_ERROR_FULL_BUFFER} if {@link ECR_JSON_MAX_DEPTH} containers are already open
+ */
+ecr_status_t ecr_json_begin_array(ecr_json_writer_t *writer);
+
+/**
+ * Close the innermost open container, which must be an array.
+ *
+ * @param writer JSON writer to write to
+ *
+ * @return error code
+ */
+ecr_status_t ecr_json_end_array(ecr_json_writer_t *writer);
+
+/**
+ * Write the key of the next member of the innermost open container, which must be an object.
+ *
+ * The key is escaped like a string value (see {@link ecr_json_string}).
+ *
+ * @param writer JSON writer to write to
+ * @param key bytes of the key
+ * @param length length of the key
+ *
+ * @return error code
+ */
+ecr_status_t ecr_json_key(ecr_json_writer_t *writer, const char *key, size_t length);
+
+/**
+ * Write a string value.
+ *
+ * Quotes, backslashes and control characters are escaped; everything else, including any bytes above 0x7F,
+ * is copied as is, so the string should be valid UTF-8. The string is searched for characters to escape
+ * sixteen bytes at a time, and runs without any are copied in bulk.
+ *
+ * @param writer JSON writer to write to
+ * @param string bytes of the string
+ * @param length length of the string
+ *
+ * @return error code
+ */
+ecr_status_t ecr_json_string(ecr_json_writer_t *writer, const char *string, size_t length);
+
+/**
+ * Write an unsigned integer value.
+ *
+ * @param writer JSON writer to write to
+ * @param value value to write
+ *
+ * @return error code
+ */
+ecr_status_t ecr_json_u64(ecr_json_writer_t *writer, uint_least64_t value);
+
+/**
+ * Write a signed integer value.
+ *
+ * @param writer JSON writer to write to
+ * @param value value to write
+ *
+ * @return error code
+ */
+ecr_status_t ecr_json_i64(ecr_json_writer_t *writer, int_least64_t value);
+
+/**
+ * Write a floating point value, with the fewest digits that read back exactly (see {@link ecr_format_f64}).
+ *
+ * @param writer JSON writer to write to
+ * @param value value to write
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **value** is infinite or NaN, which JSON can't represent
+ */
+ecr_status_t ecr_json_f64(ecr_json_writer_t *writer, double value);
+
+/**
+ * Write a boolean value.
+ *
+ * @param writer JSON writer to write to
+ * @param value value to write
+ *
+ * @return error code
+ */
+ecr_status_t ecr_json_bool(ecr_json_writer_t *writer, bool value);
+
+/**
+ * Write a null value.
+ *
+ * @param writer JSON writer to write to
+ *
+ * @return error code
+ */
+ecr_status_t ecr_json_null(ecr_json_writer_t *writer);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
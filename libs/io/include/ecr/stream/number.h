@@ -0,0 +1,133 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_NUMBER_H_
+#define ECR_STREAM_NUMBER_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/// Largest number of characters any of the number formatting functions produce.
+#define ECR_NUMBER_MAX_LENGTH 32
+
+/**
+ * Format an unsigned integer in decimal.
+ *
+ * @param out memory to write the characters to, at least {@link ECR_NUMBER_MAX_LENGTH} bytes long; no terminator is written
+ * @param value value to format
+ *
+ * @return number of characters written
+ */
+size_t ecr_format_u64(char *out, uint_least64_t value);
+
+/**
+ * Format a signed integer in decimal.
+ *
+ * @param out memory to write the characters to, at least {@link ECR_NUMBER_MAX_LENGTH} bytes long; no terminator is written
+ * @param value value to format
+ *
+ * @return number of characters written
+ */
+size_t ecr_format_i64(char *out, int_least64_t value);
+
+/**
+ * Format an unsigned integer in lowercase hexadecimal, without a prefix.
+ *
+ * @param out memory to write the characters to, at least {@link ECR_NUMBER_MAX_LENGTH} bytes long; no terminator is written
+ * @param value value to format
+ *
+ * @return number of characters written
+ */
+size_t ecr_format_hex(char *out, uint_least64_t value);
+
+/**
+ * Format a floating-point number with the fewest decimal digits which read back as exactly the same value.
+ *
+ * Numbers are written like `"%.17g"` would, but without superfluous digits: in scientific notation
+ * (e.g. `1.5e-07`) if their decimal exponent is below -4 or above 16, and in positional notation otherwise.
+ * Infinities and NaNs are written as `inf`, `-inf` and `nan`.
+ *
+ * @param out memory to write the characters to, at least {@link ECR_NUMBER_MAX_LENGTH} bytes long; no terminator is written
+ * @param value value to format
+ *
+ * @return number of characters written
+ */
+size_t ecr_format_f64(char *out, double value);
+
+/**
+ * Write an unsigned integer to a stream in decimal.
+ *
+ * @param stream stream to write to
+ * @param value value to write
+ *
+ * @return error code
+ *
+ * @see ecr_format_u64
+ */
+ecr_status_t ecr_stream_write_u64(ecr_stream_t *stream, uint_least64_t value);
+
+/**
+ * Write a signed integer to a stream in decimal.
+ *
+ * @param stream stream to write to
+ * @param value value to write
+ *
+ * @return error code
+ *
+ * @see ecr_format_i64
+ */
+ecr_status_t ecr_stream_write_i64(ecr_stream_t *stream, int_least64_t value);
+
+/**
+ * Write an unsigned integer to a stream in lowercase hexadecimal, without a prefix.
+ *
+ * @param stream stream to write to
+ * @param value value to write
+ *
+ * @return error code
+ *
+ * @see ecr_format_hex
+ */
+ecr_status_t ecr_stream_write_hex(ecr_stream_t *stream, uint_least64_t value);
+
+/**
+ * Write a floating-point number to a stream with the fewest decimal digits which read back as exactly the same value.
+ *
+ * @param stream stream to write to
+ * @param value value to write
+ *
+ * @return error code
+ *
+ * @see ecr_format_f64
+ */
+ecr_status_t ecr_stream_write_f64(ecr_stream_t *stream, double value);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_PIPE_H_
+#define ECR_STREAM_PIPE_H_
+
+
+#include <stddef.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+#include <ecr/stream/file.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Open an in-process pipe: a pair of streams connected by a lock-free single-producer/single-consumer ring.
+ *
+ * Bytes written to **writer** are read from **reader** with a single copy in each direction and no system calls,
+ * except for futex wakeups when one side is waiting on the other.
+ * Each end may be used by one thread at a time, and the two ends may be closed independently:
+ * once **writer** is closed, **reader** returns {@link ECR_ERROR_EOF} after the remaining bytes are read,
+ * and once **reader** is closed, writes fail with `EPIPE`.
+ *
+ * @param reader pointer to the reading stream object to be initialized
+ * @param writer pointer to the writing stream object to be initialized
+ * @param allocator allocator used for the pipe's state; it must remain valid until both ends are closed
+ * @param capacity number of bytes the pipe can hold; rounded up to a power of two
+ * @param mode_flags {@link ECR_FILEMODE_NONBLOCK} to return {@link ECR_ERROR_AGAIN}
+ * instead of waiting when the pipe is empty or full, or `0`
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} for a zero capacity or unsupported mode flags
+ */
+ecr_status_t ecr_stream_open_pipe(ecr_stream_t *reader, ecr_stream_t *writer, ecr_allocator_t *allocator, size_t capacity, ecr_filemode_t mode_flags);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
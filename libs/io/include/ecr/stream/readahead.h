@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_READAHEAD_H_
+#define ECR_STREAM_READAHEAD_H_
+
+
+#include <stddef.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Open a read-only stream which reads ahead from a **source** stream on a background thread,
+ * so that reading from the source overlaps with processing the data already read.
+ *
+ * The background thread fills a rotating set of buffers, one source read at a time.
+ * The amount requested per read adapts to the consumer: it grows while the consumer has to wait for data,
+ * and shrinks while the consumer is too slow to free up buffers.
+ * Errors and the end of the source are reported after all data read before them.
+ * The source itself is not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param source stream to read from; it must remain valid until the stream is closed,
+ * and must not be used by anything else in the meantime
+ * @param allocator allocator used for the stream's state and buffers; it must remain valid until the stream is closed
+ * @param buffer_count number of buffers to rotate through; at least two
+ * @param buffer_size size of each buffer, which is the largest amount requested per source read
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} for fewer than two buffers or a zero buffer size
+ */
+ecr_status_t ecr_stream_open_readahead(ecr_stream_t *stream, ecr_stream_t *source, ecr_allocator_t *allocator, size_t buffer_count, size_t buffer_size);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
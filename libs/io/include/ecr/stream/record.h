@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_RECORD_H_
+#define ECR_STREAM_RECORD_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Type for selecting how the length of a record is encoded in front of it.
+ */
+typedef enum : uint_least32_t {
+    /// unsigned LEB128 varint, taking one byte for records shorter than 128 bytes
+    ECR_RECORD_PREFIX_VARINT  = 0,
+    /// 32-bit little-endian integer
+    ECR_RECORD_PREFIX_FIXED32 = 1,
+} ecr_record_prefix_t;
+
+/**
+ * Write a length-prefixed record to a buffered stream.
+ *
+ * The record is added to the stream's buffer, so that consecutive records are written to the inner stream together
+ * once the buffer fills up or is flushed with {@link ecr_stream_buffered_flush}. Records larger than the buffer
+ * are written to the inner stream directly.
+ *
+ * @param stream buffered stream (see {@link ecr_stream_open_buffered}) to write to
+ * @param prefix encoding of the record's length
+ * @param memory contents of the record
+ * @param length length of the record
+ *
+ * @return error code
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if **length** can't be encoded with **prefix**
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a buffered stream, or **prefix** is unknown
+ */
+ecr_status_t ecr_stream_write_record(ecr_stream_t *stream, ecr_record_prefix_t prefix, const void *memory, size_t length);
+
+/**
+ * Read a length-prefixed record from a buffered stream, and get a view of it.
+ *
+ * The record is returned without copying, from the stream's buffer; it is read with as few reads
+ * from the inner stream as the buffer allows, rather than one for the prefix and another for the record.
+ * The view remains valid until the next operation on the stream.
+ *
+ * @param stream buffered stream (see {@link ecr_stream_open_buffered}) to read from
+ * @param prefix encoding of the record's length
+ * @param max_length maximum length of a record
+ * @param record pointer to the start of the record to be returned
+ * @param length pointer to the length of the record to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if there are no more records
+ * * {@link ECR_ERROR_FULL_BUFFER} if the record is longer than **max_length**; it is left unread
+ * * {@link ECR_ERROR_INVALID_DATA} if the prefix is malformed, or the stream ends partway through a record
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a buffered stream, or **prefix** is unknown
+ */
+ecr_status_t ecr_stream_read_record(ecr_stream_t *stream, ecr_record_prefix_t prefix, size_t max_length, const void **record, size_t *length);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
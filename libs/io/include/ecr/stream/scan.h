@@ -0,0 +1,116 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_SCAN_H_
+#define ECR_STREAM_SCAN_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Maximum length of a number read by the `ecr_stream_scan_*` functions; longer numbers are rejected as invalid.
+ */
+#define ECR_SCAN_NUMBER_MAX_LENGTH 1024
+
+
+/**
+ * Read an unsigned decimal integer from a buffered stream.
+ *
+ * Leading whitespace is skipped. The number is parsed directly from the stream's buffer and ends
+ * at the first byte which is neither alphanumeric nor one of `.+-`, so `"12,"` reads as 12
+ * while `"12abc"` is invalid. An optional `+` sign is accepted.
+ *
+ * @param stream buffered stream to read from
+ * @param value pointer to the number to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the stream ends before any number
+ * * {@link ECR_ERROR_INVALID_DATA} if the next token isn't a valid number; it is left unread
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the number doesn't fit in **value**; it is left unread
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered}
+ */
+ecr_status_t ecr_stream_scan_u64(ecr_stream_t *stream, uint_least64_t *value);
+
+/**
+ * Read a signed decimal integer from a buffered stream.
+ *
+ * Behaves like {@link ecr_stream_scan_u64}, except that a `-` sign is also accepted.
+ *
+ * @param stream buffered stream to read from
+ * @param value pointer to the number to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the stream ends before any number
+ * * {@link ECR_ERROR_INVALID_DATA} if the next token isn't a valid number; it is left unread
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the number doesn't fit in **value**; it is left unread
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered}
+ */
+ecr_status_t ecr_stream_scan_i64(ecr_stream_t *stream, int_least64_t *value);
+
+/**
+ * Read a decimal floating point number from a buffered stream, rounded to the nearest double.
+ *
+ * Behaves like {@link ecr_stream_scan_i64}, but accepts a fraction and an exponent
+ * (`[+-]digits[.digits][(e|E)[+-]digits]`, where either the integer or the fraction digits may be missing),
+ * as well as `inf`, `infinity` and `nan` in any case. The decimal point is always `.`, regardless of locale.
+ * Numbers too small to represent are rounded to zero.
+ *
+ * @param stream buffered stream to read from
+ * @param value pointer to the number to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the stream ends before any number
+ * * {@link ECR_ERROR_INVALID_DATA} if the next token isn't a valid number; it is left unread
+ * * {@link ECR_ERROR_TYPE_OVERFLOW} if the number's magnitude is too large to represent; it is left unread
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered}
+ */
+ecr_status_t ecr_stream_scan_f64(ecr_stream_t *stream, double *value);
+
+/**
+ * Read a whitespace-delimited token from a buffered stream, and get a view of it.
+ *
+ * Leading whitespace is skipped, and the token ends before the next whitespace byte or at the end of the stream.
+ * The whitespace after the token is left unread. The token is found in the stream's buffer and returned
+ * without copying; the view remains valid until the next operation on the stream.
+ *
+ * @param stream buffered stream to read from
+ * @param max_length maximum length of a token
+ * @param token pointer to the start of the token to be returned
+ * @param length pointer to the length of the token to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_EOF} if the stream ends before any token
+ * * {@link ECR_ERROR_FULL_BUFFER} if the token is longer than **max_length**; it is left unread
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_buffered}
+ */
+ecr_status_t ecr_stream_scan_token(ecr_stream_t *stream, size_t max_length, const char **token, size_t *length);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_SHM_H_
+#define ECR_STREAM_SHM_H_
+
+
+#include <stddef.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+#include <ecr/stream/file.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Open one end of a ring buffer in shared memory, to exchange data with another process without system calls.
+ *
+ * The ring has exactly one reading and one writing end, chosen by the access mode;
+ * each end may be used by one thread at a time and waits for the other with futexes.
+ * Once the writing end is closed the reading end returns {@link ECR_ERROR_EOF} after the remaining bytes are read,
+ * and once the reading end is closed writes fail with `EPIPE`.
+ *
+ * A named ring is unlinked when the end that created it is closed, so its name can be reused;
+ * an end opened by name after that fails, while ends that are already open keep working.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param name name of the shared memory object as passed to `shm_open()`,
+ * or `NULL` to create an anonymous ring whose file descriptor can be retrieved with {@link ecr_stream_shm_fd}
+ * @param mode_flags file access mode flags:
+ * * {@link ECR_FILEMODE_READ_ONLY} to open the reading end, or {@link ECR_FILEMODE_WRITE_ONLY} to open the writing end
+ * * {@link ECR_FILEMODE_CREATE} to create the ring, failing if it already exists
+ * * {@link ECR_FILEMODE_NONBLOCK} to return {@link ECR_ERROR_AGAIN} instead of waiting
+ * @param capacity number of bytes the ring can hold if it is created, rounded up to a power of two; ignored otherwise
+ * @param allocator allocator used for the stream's state; it must remain valid until the stream is closed
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} for an invalid access mode, any other flag not listed above,
+ * or a `NULL` **name** without {@link ECR_FILEMODE_CREATE}
+ * * {@link ECR_ERROR_AGAIN} if the ring exists but has not been initialized by its creator yet
+ * * {@link ECR_ERROR_IO} if the shared memory object does not contain a valid ring
+ */
+ecr_status_t ecr_stream_open_shm(ecr_stream_t *stream, const char *name, ecr_filemode_t mode_flags, size_t capacity, ecr_allocator_t *allocator);
+
+/**
+ * Open one end of a ring buffer in an existing shared memory file descriptor,
+ * such as one received from another process. The file descriptor is duplicated.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param fd file descriptor of a shared memory object containing a ring
+ * @param mode_flags file access mode flags, as for {@link ecr_stream_open_shm} except for {@link ECR_FILEMODE_CREATE}
+ * @param allocator allocator used for the stream's state; it must remain valid until the stream is closed
+ *
+ * @return error code
+ *
+ * @see ecr_stream_open_shm
+ */
+ecr_status_t ecr_stream_open_shm_fd(ecr_stream_t *stream, int fd, ecr_filemode_t mode_flags, ecr_allocator_t *allocator);
+
+/**
+ * Get the file descriptor of the shared memory object backing a ring stream, e.g. to pass it to another process.
+ * The file descriptor remains owned by the stream and is closed along with it.
+ *
+ * @param stream shared memory stream to query
+ * @param fd pointer to the file descriptor to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened as a shared memory stream
+ */
+ecr_status_t ecr_stream_shm_fd(ecr_stream_t *stream, int *fd);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
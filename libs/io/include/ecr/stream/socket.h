@@ -0,0 +1,155 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_SOCKET_H_
+#define ECR_STREAM_SOCKET_H_
+
+
+#include <stdint.h>
+
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Type for selecting a socket stream option.
+ */
+typedef enum : uint_least32_t {
+    /// disable Nagle's algorithm (`TCP_NODELAY`) if non-zero
+    ECR_SOCKET_NODELAY  = 1,
+    /// hold back partial frames (`TCP_CORK` and `MSG_MORE`) if non-zero until {@link ecr_stream_socket_flush} is called
+    ECR_SOCKET_CORK     = 2,
+    /// set the kernel receive buffer size in bytes (`SO_RCVBUF`)
+    ECR_SOCKET_RCVBUF   = 3,
+    /// set the kernel send buffer size in bytes (`SO_SNDBUF`)
+    ECR_SOCKET_SNDBUF   = 4,
+    /// send writes of at least this many bytes with `MSG_ZEROCOPY`, or disable if zero
+    ECR_SOCKET_ZEROCOPY = 5,
+} ecr_socket_option_t;
+
+/**
+ * Connect to a unix domain stream socket.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param path file system path of the socket
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **path** is too long
+ */
+ecr_status_t ecr_stream_connect_unix(ecr_stream_t *stream, const char *path);
+
+/**
+ * Connect to a TCP socket over IPv4 or IPv6, trying each resolved address in turn.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param host host name or numeric address
+ * @param service service name or numeric port
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **host** or **service** can't be resolved
+ * * {@link ECR_ERROR_AGAIN} for a temporary name resolution failure
+ */
+ecr_status_t ecr_stream_connect_tcp(ecr_stream_t *stream, const char *host, const char *service);
+
+/**
+ * Listen on a unix domain stream socket.
+ * The resulting stream can't be read from or written to; use {@link ecr_stream_accept} instead.
+ *
+ * @param listener pointer to the stream object to be initialized
+ * @param path file system path to bind the socket to; it must not exist yet
+ * @param backlog maximum number of pending connections
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **path** is too long
+ */
+ecr_status_t ecr_stream_listen_unix(ecr_stream_t *listener, const char *path, int backlog);
+
+/**
+ * Listen on a TCP socket over IPv4 or IPv6.
+ * The resulting stream can't be read from or written to; use {@link ecr_stream_accept} instead.
+ *
+ * @param listener pointer to the stream object to be initialized
+ * @param host local address to bind to, or `NULL` for any address
+ * @param service service name or numeric port to bind to; `"0"` picks an ephemeral port
+ * @param backlog maximum number of pending connections
+ *
+ * @return error code
+ *
+ * @see ecr_stream_socket_local_port
+ */
+ecr_status_t ecr_stream_listen_tcp(ecr_stream_t *listener, const char *host, const char *service, int backlog);
+
+/**
+ * Accept a connection on a listening socket stream, waiting for one if necessary.
+ *
+ * @param listener listening stream to accept from
+ * @param stream pointer to the stream object to be initialized
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **listener** was not opened with {@link ecr_stream_listen_unix} or {@link ecr_stream_listen_tcp}
+ */
+ecr_status_t ecr_stream_accept(ecr_stream_t *listener, ecr_stream_t *stream);
+
+/**
+ * Set an option on a socket stream.
+ *
+ * @param stream socket stream to configure
+ * @param option option to set
+ * @param value option value
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a socket stream, or for an unknown option
+ * * {@link ECR_ERROR_NOT_SUPPORTED} if the socket does not support the option
+ *
+ * @note Zero-copy writes wait for the kernel to release the written memory before returning,
+ * so they only pay off for large buffers.
+ */
+ecr_status_t ecr_stream_socket_set_option(ecr_stream_t *stream, ecr_socket_option_t option, uint_least32_t value);
+
+/**
+ * Push out any data held back by {@link ECR_SOCKET_CORK}, keeping the stream corked.
+ * Does nothing if the stream is not corked.
+ *
+ * @param stream socket stream to flush
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a socket stream
+ */
+ecr_status_t ecr_stream_socket_flush(ecr_stream_t *stream);
+
+/**
+ * Learn the local port a TCP socket stream is bound to.
+ *
+ * @param stream socket stream to query
+ * @param port pointer to the port value to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** is not a socket stream
+ * * {@link ECR_ERROR_NOT_SUPPORTED} if the socket is not an IPv4 or IPv6 socket
+ */
+ecr_status_t ecr_stream_socket_local_port(ecr_stream_t *stream, uint_least16_t *port);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_SPILL_H_
+#define ECR_STREAM_SPILL_H_
+
+
+#include <stddef.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Open a read-write stream that keeps its contents in memory until they grow past **threshold** bytes,
+ * after which they are transparently moved ("spilled") to an anonymous temporary file.
+ *
+ * The stream behaves like a file opened with {@link ECR_FILEMODE_READ_WRITE}:
+ * reads and writes share a single position which may be moved with {@link ecr_stream_setpos}.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param allocator allocator used for the stream's state and in-memory contents;
+ * it must remain valid until the stream is closed
+ * @param threshold maximum number of bytes kept in memory
+ *
+ * @return error code
+ */
+ecr_status_t ecr_stream_open_spill(ecr_stream_t *stream, ecr_allocator_t *allocator, size_t threshold);
+
+/**
+ * Get the file descriptor backing a spill stream, spilling its contents first if they are still held in memory.
+ *
+ * The file descriptor remains owned by the stream and is closed along with it.
+ * Its file offset is unspecified; use an explicit offset (e.g. with `sendfile()` or `pread()`) to access it.
+ *
+ * @param stream spill stream to query
+ * @param fd pointer to the file descriptor to be returned
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_spill}
+ */
+ecr_status_t ecr_stream_spill_fd(ecr_stream_t *stream, int *fd);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_TEE_H_
+#define ECR_STREAM_TEE_H_
+
+
+#include <stddef.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Struct describing one of the children of a tee stream.
+ * @param stream stream to forward writes to
+ * @param async whether writes to this child are queued and performed on a background thread,
+ * as with {@link ecr_stream_open_concurrent}, so that a slow child does not hold up the others
+ */
+typedef struct ecr_stream_tee_child {
+    ecr_stream_t *stream;
+    bool async;
+} ecr_stream_tee_child_t;
+
+/**
+ * Open a write-only stream which forwards everything written into it to each of its **children**.
+ *
+ * Synchronous children are written directly from the caller's buffer, one after another,
+ * and each is written to until it has taken all of the data. Asynchronous children copy the data once
+ * and are written to on their own background threads.
+ *
+ * Each child's progress is tracked separately. If a child fails, the write returns its error
+ * and only consumes the data every child has taken; retrying the write with the remaining data
+ * resumes each child from where it stopped, without repeating data for children that had already taken it.
+ * The children themselves are not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param children array of **count** children; the streams must remain valid until the stream is closed
+ * @param count number of children
+ * @param allocator allocator used for the stream's state; it must be thread-safe if any child is asynchronous,
+ * and must remain valid until the stream is closed
+ *
+ * @return error code
+ */
+ecr_status_t ecr_stream_open_tee(ecr_stream_t *stream, const ecr_stream_tee_child_t *children, size_t count, ecr_allocator_t *allocator);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ECR_STREAM_UTF8_H_
+#define ECR_STREAM_UTF8_H_
+
+
+#include <stdint.h>
+
+#include <ecr/allocator.h>
+#include <ecr/error.h>
+#include <ecr/stream.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * Open a stream which passes reads and writes through to an **inner** stream,
+ * checking that every byte read from or written to it is part of well-formed UTF-8.
+ *
+ * Overlong encodings, surrogates and code points above U+10FFFF are rejected, as is data which ends
+ * partway through a sequence. Once invalid data is found, every read and write returns {@link ECR_ERROR_INVALID_DATA};
+ * a read stops short of the invalid sequence, and a write containing it forwards nothing.
+ * Since validation follows the data in the order it passes through the stream,
+ * the stream's position cannot be changed. The inner stream is not closed.
+ *
+ * @param stream pointer to the stream object to be initialized
+ * @param inner stream to pass reads and writes to; it must remain valid until the stream is closed
+ * @param allocator allocator used for the stream's state; it must remain valid until the stream is closed
+ *
+ * @return error code
+ */
+ecr_status_t ecr_stream_open_utf8(ecr_stream_t *stream, ecr_stream_t *inner, ecr_allocator_t *allocator);
+
+/**
+ * Check whether a UTF-8 validating stream has found invalid data, and where.
+ *
+ * @param stream UTF-8 validating stream to query
+ * @param offset pointer to the offset to be returned, counted in bytes from the start of the stream's data,
+ * of the first byte of the first invalid sequence; only set if invalid data has been found
+ *
+ * @return error code
+ * * {@link ECR_ERROR_INVALID_DATA} if invalid data has been found
+ * * {@link ECR_ERROR_INVALID_ARGUMENT} if **stream** was not opened with {@link ecr_stream_open_utf8}
+ */
+ecr_status_t ecr_stream_utf8_error(ecr_stream_t *stream, uint_least64_t *offset);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
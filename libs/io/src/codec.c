@@ -0,0 +1,142 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ecr/buffer.h"
+#include "ecr/codec.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/buffered.h"
+
+// gathers the seven-bit groups of a varint of at most eight bytes, held in the low bytes of **chunk**
+static uint64_t ecr_codec_compact(uint64_t chunk) {
+    chunk &= UINT64_C(0x7F7F7F7F7F7F7F7F);
+    chunk = (chunk & UINT64_C(0x007F007F007F007F)) | ((chunk & UINT64_C(0x7F007F007F007F00)) >> 1);
+    chunk = (chunk & UINT64_C(0x00003FFF00003FFF)) | ((chunk & UINT64_C(0x3FFF00003FFF0000)) >> 2);
+    chunk = (chunk & UINT64_C(0x000000000FFFFFFF)) | ((chunk & UINT64_C(0x0FFFFFFF00000000)) >> 4);
+    return chunk;
+}
+
+#if defined(__SSE2__)
+// widens sixteen single-byte varints to 64 bits each
+static void ecr_codec_widen(__m128i chunk, uint_least64_t *values) {
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i halves[2] = { _mm_unpacklo_epi8(chunk, zero), _mm_unpackhi_epi8(chunk, zero) };
+    for(size_t h = 0; h < 2; h++) {
+        __m128i quarters[2] = { _mm_unpacklo_epi16(halves[h], zero), _mm_unpackhi_epi16(halves[h], zero) };
+        for(size_t q = 0; q < 2; q++) {
+            _mm_storeu_si128((__m128i *) (values + 8 * h + 4 * q), _mm_unpacklo_epi32(quarters[q], zero));
+            _mm_storeu_si128((__m128i *) (values + 8 * h + 4 * q + 2), _mm_unpackhi_epi32(quarters[q], zero));
+        }
+    }
+}
+#endif
+
+ecr_status_t ecr_codec_get_varints(ecr_buffer_t *buffer, uint_least64_t *values, size_t count, size_t *decoded) {
+    const unsigned char *in = buffer->memory;
+
+    ecr_status_t status = ECR_SUCCESS;
+    size_t done = 0;
+    while(done < count) {
+        size_t available = buffer->length - buffer->position;
+
+#if defined(__SSE2__)
+        if(available >= 16 && count - done >= 16) {
+            __m128i chunk = _mm_loadu_si128((const __m128i *) (in + buffer->position));
+            if(_mm_movemask_epi8(chunk) == 0) {
+                ecr_codec_widen(chunk, values + done);
+                buffer->position += 16;
+                done += 16;
+                continue;
+            }
+        }
+#endif
+
+        if(available >= 8) {
+            uint64_t chunk;
+            memcpy(&chunk, in + buffer->position, sizeof(chunk));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            chunk = __builtin_bswap64(chunk);
+#endif
+
+            uint64_t ends = ~chunk & UINT64_C(0x8080808080808080);
+            if(ends) {
+                size_t size = __builtin_ctzll(ends) / 8 + 1;
+                if(size < 8) {
+                    chunk &= (UINT64_C(1) << (8 * size)) - 1;
+                }
+
+                values[done++] = ecr_codec_compact(chunk);
+                buffer->position += size;
+                continue;
+            }
+        }
+
+        // varints longer than eight bytes, and the end of the buffer
+        status = ecr_codec_get_varint(buffer, &values[done]);
+        if(status) {
+            break;
+        }
+        done++;
+    }
+
+    *decoded = done;
+    return status;
+}
+
+ecr_status_t ecr_codec_begin_write(ecr_stream_t *stream, size_t minimum, ecr_buffer_t *buffer) {
+    void *memory;
+    size_t length;
+    ECR_STATUS_GUARD(ecr_stream_buffered_reserve(stream, minimum, &memory, &length));
+
+    buffer->memory   = memory;
+    buffer->capacity = length;
+    buffer->position = 0;
+    buffer->length   = 0;
+
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_codec_end_write(ecr_stream_t *stream, const ecr_buffer_t *buffer) {
+    return ecr_stream_buffered_commit(stream, buffer->length);
+}
+
+ecr_status_t ecr_codec_begin_read(ecr_stream_t *stream, size_t minimum, ecr_buffer_t *buffer) {
+    const void *memory;
+    size_t length;
+    ecr_status_t status = ecr_stream_buffered_fill(stream, minimum, &memory, &length);
+    if(status && status != ECR_ERROR_EOF) {
+        return status;
+    }
+
+    buffer->memory   = (void *) memory;
+    buffer->capacity = length;
+    buffer->position = 0;
+    buffer->length   = length;
+
+    return status;
+}
+
+ecr_status_t ecr_codec_end_read(ecr_stream_t *stream, const ecr_buffer_t *buffer) {
+    return ecr_stream_buffered_consume(stream, buffer->position);
+}
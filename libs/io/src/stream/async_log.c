@@ -0,0 +1,871 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdckdint.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <pthread.h>
+#include <sys/types.h>
+
+#include "ecr/allocator.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/async_log.h"
+
+#include "futex.h"
+
+#define CACHE_LINE_SIZE 64
+#define OUTPUT_CAPACITY 65536
+#define SPEC_TEXT_MAX   48
+
+enum {
+    CONSUMER_RUNNING  = 0,
+    CONSUMER_SLEEPING = 1,
+};
+
+typedef enum {
+    MODIFIER_NONE,
+    MODIFIER_CHAR,
+    MODIFIER_SHORT,
+    MODIFIER_LONG,
+    MODIFIER_LONG_LONG,
+    MODIFIER_LONG_DOUBLE,
+    MODIFIER_INTMAX,
+    MODIFIER_SIZE,
+    MODIFIER_PTRDIFF,
+} ecr_async_log_modifier_t;
+
+typedef enum {
+    ARGUMENT_LITERAL,
+    ARGUMENT_INT,
+    ARGUMENT_UINT,
+    ARGUMENT_CHAR,
+    ARGUMENT_DOUBLE,
+    ARGUMENT_LONG_DOUBLE,
+    ARGUMENT_STRING,
+    ARGUMENT_POINTER,
+    ARGUMENT_ERRNO,
+} ecr_async_log_argument_t;
+
+struct ecr_async_log_spec {
+    const char *start, *modifier, *end;
+    ecr_async_log_modifier_t modifier_kind;
+    ecr_async_log_argument_t argument;
+    bool width_star, precision_star;
+    int precision;
+};
+
+struct ecr_async_log_slot {
+    _Atomic size_t sequence;
+    const char *format;
+    size_t length;
+    unsigned char payload[];
+};
+
+struct ecr_async_log {
+    ecr_stream_t *sink;
+    ecr_allocator_t *allocator;
+    ecr_async_log_config_t config;
+    pthread_t consumer;
+
+    void *slots;
+    size_t slot_size, mask;
+
+    _Atomic size_t enqueue_position;
+    char enqueue_padding[CACHE_LINE_SIZE - sizeof(size_t)];
+
+    _Atomic uint32_t consumer_state;
+    _Atomic uint32_t released;
+    _Atomic uint32_t blocked;
+    atomic_bool closing;
+    _Atomic ecr_status_t status;
+    _Atomic uint_least64_t dropped;
+    char state_padding[CACHE_LINE_SIZE];
+
+    size_t dequeue_position;
+    ecr_buffer_t output;
+};
+
+static struct ecr_async_log_slot * ecr_async_log_slot(ecr_async_log_t *log, size_t position) {
+    return log->slots + (position & log->mask) * log->slot_size;
+}
+
+static ecr_status_t ecr_async_log_parse(const char *format, struct ecr_async_log_spec *spec) {
+    spec->start = format++;
+    spec->width_star = false;
+    spec->precision_star = false;
+    spec->precision = -1;
+
+    if(*format == '%') {
+        spec->modifier = format;
+        spec->modifier_kind = MODIFIER_NONE;
+        spec->argument = ARGUMENT_LITERAL;
+        spec->end = format + 1;
+        return ECR_SUCCESS;
+    }
+
+    const char *digits = format;
+    while(*digits >= '0' && *digits <= '9') {
+        digits++;
+    }
+    if(*digits == '$') {
+        return ECR_ERROR_NOT_SUPPORTED;
+    }
+
+    while(*format && strchr("-+ #0'I", *format)) {
+        format++;
+    }
+
+    if(*format == '*') {
+        spec->width_star = true;
+        format++;
+    } else {
+        while(*format >= '0' && *format <= '9') {
+            format++;
+        }
+    }
+
+    if(*format == '.') {
+        format++;
+        if(*format == '*') {
+            spec->precision_star = true;
+            format++;
+        } else {
+            spec->precision = 0;
+            while(*format >= '0' && *format <= '9') {
+                if(spec->precision < INT_MAX / 10) {
+                    spec->precision = spec->precision * 10 + (*format - '0');
+                }
+                format++;
+            }
+        }
+    }
+
+    spec->modifier = format;
+    switch(*format) {
+        case 'h':
+            format++;
+            if(*format == 'h') {
+                spec->modifier_kind = MODIFIER_CHAR;
+                format++;
+            } else {
+                spec->modifier_kind = MODIFIER_SHORT;
+            }
+            break;
+        case 'l':
+            format++;
+            if(*format == 'l') {
+                spec->modifier_kind = MODIFIER_LONG_LONG;
+                format++;
+            } else {
+                spec->modifier_kind = MODIFIER_LONG;
+            }
+            break;
+        case 'q':
+            spec->modifier_kind = MODIFIER_LONG_LONG;
+            format++;
+            break;
+        case 'L':
+            spec->modifier_kind = MODIFIER_LONG_DOUBLE;
+            format++;
+            break;
+        case 'j':
+            spec->modifier_kind = MODIFIER_INTMAX;
+            format++;
+            break;
+        case 'z':
+        case 'Z':
+            spec->modifier_kind = MODIFIER_SIZE;
+            format++;
+            break;
+        case 't':
+            spec->modifier_kind = MODIFIER_PTRDIFF;
+            format++;
+            break;
+        default:
+            spec->modifier_kind = MODIFIER_NONE;
+            break;
+    }
+
+    switch(*format) {
+        case 'd':
+        case 'i':
+            spec->argument = ARGUMENT_INT;
+            break;
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            spec->argument = ARGUMENT_UINT;
+            break;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec->argument = spec->modifier_kind == MODIFIER_LONG_DOUBLE ? ARGUMENT_LONG_DOUBLE : ARGUMENT_DOUBLE;
+            break;
+        case 'c':
+            spec->argument = ARGUMENT_CHAR;
+            break;
+        case 's':
+            spec->argument = ARGUMENT_STRING;
+            break;
+        case 'p':
+            spec->argument = ARGUMENT_POINTER;
+            break;
+        case 'm':
+            spec->argument = ARGUMENT_ERRNO;
+            break;
+        case 'n':
+        case 'C':
+        case 'S':
+            return ECR_ERROR_NOT_SUPPORTED;
+        default:
+            return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    if((spec->argument == ARGUMENT_CHAR || spec->argument == ARGUMENT_STRING) && spec->modifier_kind != MODIFIER_NONE) {
+        return ECR_ERROR_NOT_SUPPORTED;
+    }
+
+    spec->end = format + 1;
+    if(spec->end - spec->start > SPEC_TEXT_MAX) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    return ECR_SUCCESS;
+}
+
+static bool ecr_async_log_put(struct ecr_async_log_slot *slot, size_t record_size, const void *value, size_t size) {
+    if(size > record_size - slot->length) {
+        return false;
+    }
+
+    memcpy(slot->payload + slot->length, value, size);
+    slot->length += size;
+    return true;
+}
+
+static ecr_status_t ecr_async_log_capture(struct ecr_async_log_slot *slot, size_t record_size, const char *format, va_list vlist) {
+    slot->length = 0;
+
+    int saved_errno = errno;
+    for(format = strchr(format, '%'); format; format = strchr(format, '%')) {
+        struct ecr_async_log_spec spec;
+        ECR_STATUS_GUARD(ecr_async_log_parse(format, &spec));
+        format = spec.end;
+
+        int precision = spec.precision;
+        if(spec.width_star) {
+            int width = va_arg(vlist, int);
+            if(!ecr_async_log_put(slot, record_size, &width, sizeof(width))) {
+                return ECR_ERROR_FULL_BUFFER;
+            }
+        }
+        if(spec.precision_star) {
+            precision = va_arg(vlist, int);
+            if(!ecr_async_log_put(slot, record_size, &precision, sizeof(precision))) {
+                return ECR_ERROR_FULL_BUFFER;
+            }
+        }
+
+        bool stored = true;
+        switch(spec.argument) {
+            case ARGUMENT_LITERAL:
+                break;
+            case ARGUMENT_INT: {
+                intmax_t value;
+                switch(spec.modifier_kind) {
+                    case MODIFIER_CHAR:
+                        value = (signed char) va_arg(vlist, int);
+                        break;
+                    case MODIFIER_SHORT:
+                        value = (short) va_arg(vlist, int);
+                        break;
+                    case MODIFIER_LONG:
+                        value = va_arg(vlist, long);
+                        break;
+                    case MODIFIER_LONG_LONG:
+                    case MODIFIER_LONG_DOUBLE:
+                        value = va_arg(vlist, long long);
+                        break;
+                    case MODIFIER_INTMAX:
+                        value = va_arg(vlist, intmax_t);
+                        break;
+                    case MODIFIER_SIZE:
+                        value = va_arg(vlist, ssize_t);
+                        break;
+                    case MODIFIER_PTRDIFF:
+                        value = va_arg(vlist, ptrdiff_t);
+                        break;
+                    default:
+                        value = va_arg(vlist, int);
+                        break;
+                }
+                stored = ecr_async_log_put(slot, record_size, &value, sizeof(value));
+                break;
+            }
+            case ARGUMENT_UINT: {
+                uintmax_t value;
+                switch(spec.modifier_kind) {
+                    case MODIFIER_CHAR:
+                        value = (unsigned char) va_arg(vlist, unsigned int);
+                        break;
+                    case MODIFIER_SHORT:
+                        value = (unsigned short) va_arg(vlist, unsigned int);
+                        break;
+                    case MODIFIER_LONG:
+                        value = va_arg(vlist, unsigned long);
+                        break;
+                    case MODIFIER_LONG_LONG:
+                    case MODIFIER_LONG_DOUBLE:
+                        value = va_arg(vlist, unsigned long long);
+                        break;
+                    case MODIFIER_INTMAX:
+                        value = va_arg(vlist, uintmax_t);
+                        break;
+                    case MODIFIER_SIZE:
+                        value = va_arg(vlist, size_t);
+                        break;
+                    case MODIFIER_PTRDIFF:
+                        value = (uintmax_t) va_arg(vlist, ptrdiff_t);
+                        break;
+                    default:
+                        value = va_arg(vlist, unsigned int);
+                        break;
+                }
+                stored = ecr_async_log_put(slot, record_size, &value, sizeof(value));
+                break;
+            }
+            case ARGUMENT_CHAR: {
+                int value = va_arg(vlist, int);
+                stored = ecr_async_log_put(slot, record_size, &value, sizeof(value));
+                break;
+            }
+            case ARGUMENT_DOUBLE: {
+                double value = va_arg(vlist, double);
+                stored = ecr_async_log_put(slot, record_size, &value, sizeof(value));
+                break;
+            }
+            case ARGUMENT_LONG_DOUBLE: {
+                long double value = va_arg(vlist, long double);
+                stored = ecr_async_log_put(slot, record_size, &value, sizeof(value));
+                break;
+            }
+            case ARGUMENT_STRING: {
+                const char *value = va_arg(vlist, const char *);
+                if(!value) {
+                    value = "(null)";
+                }
+
+                size_t length = precision < 0 ? strlen(value) : strnlen(value, (size_t) precision);
+                stored = ecr_async_log_put(slot, record_size, &length, sizeof(length))
+                    && ecr_async_log_put(slot, record_size, value, length)
+                    && ecr_async_log_put(slot, record_size, "", 1);
+                break;
+            }
+            case ARGUMENT_POINTER: {
+                void *value = va_arg(vlist, void *);
+                stored = ecr_async_log_put(slot, record_size, &value, sizeof(value));
+                break;
+            }
+            case ARGUMENT_ERRNO:
+                stored = ecr_async_log_put(slot, record_size, &saved_errno, sizeof(saved_errno));
+                break;
+        }
+        if(!stored) {
+            return ECR_ERROR_FULL_BUFFER;
+        }
+    }
+
+    return ECR_SUCCESS;
+}
+
+static const void * ecr_async_log_take(const unsigned char **payload, size_t size) {
+    const void *value = *payload;
+    *payload += size;
+    return value;
+}
+
+#define ECR_ASYNC_LOG_SNPRINTF(memory, size, text, spec, width, precision, ...) \
+    ((spec)->width_star \
+        ? ((spec)->precision_star \
+            ? snprintf(memory, size, text, width, precision __VA_OPT__(,) __VA_ARGS__) \
+            : snprintf(memory, size, text, width __VA_OPT__(,) __VA_ARGS__)) \
+        : ((spec)->precision_star \
+            ? snprintf(memory, size, text, precision __VA_OPT__(,) __VA_ARGS__) \
+            : snprintf(memory, size, text __VA_OPT__(,) __VA_ARGS__)))
+
+static int ecr_async_log_snprintf(char *memory, size_t size, const struct ecr_async_log_spec *spec, const unsigned char *payload) {
+    char text[SPEC_TEXT_MAX + 3];
+    size_t prefix_length = (size_t) (spec->modifier - spec->start);
+    memcpy(text, spec->start, prefix_length);
+
+    char *suffix = text + prefix_length;
+    switch(spec->argument) {
+        case ARGUMENT_INT:
+        case ARGUMENT_UINT:
+            *suffix++ = 'j';
+            break;
+        case ARGUMENT_LONG_DOUBLE:
+            *suffix++ = 'L';
+            break;
+        default:
+            break;
+    }
+    *suffix++ = spec->end[-1];
+    *suffix = '\0';
+
+    int width = 0, precision = 0;
+    if(spec->width_star) {
+        memcpy(&width, ecr_async_log_take(&payload, sizeof(width)), sizeof(width));
+    }
+    if(spec->precision_star) {
+        memcpy(&precision, ecr_async_log_take(&payload, sizeof(precision)), sizeof(precision));
+    }
+
+    switch(spec->argument) {
+        case ARGUMENT_INT: {
+            intmax_t value;
+            memcpy(&value, payload, sizeof(value));
+            return ECR_ASYNC_LOG_SNPRINTF(memory, size, text, spec, width, precision, value);
+        }
+        case ARGUMENT_UINT: {
+            uintmax_t value;
+            memcpy(&value, payload, sizeof(value));
+            return ECR_ASYNC_LOG_SNPRINTF(memory, size, text, spec, width, precision, value);
+        }
+        case ARGUMENT_CHAR: {
+            int value;
+            memcpy(&value, payload, sizeof(value));
+            return ECR_ASYNC_LOG_SNPRINTF(memory, size, text, spec, width, precision, value);
+        }
+        case ARGUMENT_DOUBLE: {
+            double value;
+            memcpy(&value, payload, sizeof(value));
+            return ECR_ASYNC_LOG_SNPRINTF(memory, size, text, spec, width, precision, value);
+        }
+        case ARGUMENT_LONG_DOUBLE: {
+            long double value;
+            memcpy(&value, payload, sizeof(value));
+            return ECR_ASYNC_LOG_SNPRINTF(memory, size, text, spec, width, precision, value);
+        }
+        case ARGUMENT_STRING: {
+            const char *value = (const char *) payload + sizeof(size_t);
+            return ECR_ASYNC_LOG_SNPRINTF(memory, size, text, spec, width, precision, value);
+        }
+        case ARGUMENT_POINTER: {
+            void *value;
+            memcpy(&value, payload, sizeof(value));
+            return ECR_ASYNC_LOG_SNPRINTF(memory, size, text, spec, width, precision, value);
+        }
+        case ARGUMENT_ERRNO:
+            memcpy(&errno, payload, sizeof(int));
+            return ECR_ASYNC_LOG_SNPRINTF(memory, size, text, spec, width, precision);
+        default:
+            return 0;
+    }
+}
+
+static size_t ecr_async_log_payload_size(const struct ecr_async_log_spec *spec, const unsigned char *payload) {
+    size_t size = 0;
+    if(spec->width_star) {
+        size += sizeof(int);
+    }
+    if(spec->precision_star) {
+        size += sizeof(int);
+    }
+
+    switch(spec->argument) {
+        case ARGUMENT_INT:
+            return size + sizeof(intmax_t);
+        case ARGUMENT_UINT:
+            return size + sizeof(uintmax_t);
+        case ARGUMENT_CHAR:
+        case ARGUMENT_ERRNO:
+            return size + sizeof(int);
+        case ARGUMENT_DOUBLE:
+            return size + sizeof(double);
+        case ARGUMENT_LONG_DOUBLE:
+            return size + sizeof(long double);
+        case ARGUMENT_POINTER:
+            return size + sizeof(void *);
+        case ARGUMENT_STRING: {
+            size_t length;
+            memcpy(&length, payload + size, sizeof(length));
+            return size + sizeof(length) + length + 1;
+        }
+        default:
+            return size;
+    }
+}
+
+static ecr_status_t ecr_async_log_flush(ecr_async_log_t *log) {
+    if(log->output.length == 0) {
+        return ECR_SUCCESS;
+    }
+
+    log->output.position = 0;
+    ecr_status_t status = ecr_stream_writebuf_full(log->sink, &log->output);
+
+    log->output.position = 0;
+    log->output.length = 0;
+    return status;
+}
+
+static ecr_status_t ecr_async_log_emit(ecr_async_log_t *log, const char *memory, size_t length) {
+    while(length > 0) {
+        if(log->output.length == log->output.capacity) {
+            ECR_STATUS_GUARD(ecr_async_log_flush(log));
+        }
+
+        size_t chunk = log->output.capacity - log->output.length;
+        if(chunk > length) {
+            chunk = length;
+        }
+
+        memcpy(log->output.memory + log->output.length, memory, chunk);
+        log->output.length += chunk;
+        memory += chunk;
+        length -= chunk;
+    }
+
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_async_log_emit_spec(ecr_async_log_t *log, const struct ecr_async_log_spec *spec, const unsigned char *payload) {
+    size_t available = log->output.capacity - log->output.length;
+    int size = ecr_async_log_snprintf(log->output.memory + log->output.length, available, spec, payload);
+    if(size < 0) {
+        return ecr_get_system_error();
+    }
+    if((size_t) size < available) {
+        log->output.length += (size_t) size;
+        return ECR_SUCCESS;
+    }
+
+    ECR_STATUS_GUARD(ecr_async_log_flush(log));
+    if((size_t) size < log->output.capacity) {
+        ecr_async_log_snprintf(log->output.memory, log->output.capacity, spec, payload);
+        log->output.length = (size_t) size;
+        return ECR_SUCCESS;
+    }
+
+    char *memory;
+    ECR_STATUS_GUARD(ecr_allocate(log->allocator, (void **) &memory, (size_t) size + 1));
+
+    ecr_async_log_snprintf(memory, (size_t) size + 1, spec, payload);
+    ecr_status_t status = ecr_async_log_emit(log, memory, (size_t) size);
+
+    ecr_free(log->allocator, memory);
+    return status;
+}
+
+static ecr_status_t ecr_async_log_format(ecr_async_log_t *log, const struct ecr_async_log_slot *slot) {
+    const char *format = slot->format;
+    const unsigned char *payload = slot->payload;
+
+    while(*format) {
+        const char *percent = strchrnul(format, '%');
+        ECR_STATUS_GUARD(ecr_async_log_emit(log, format, (size_t) (percent - format)));
+        if(!*percent) {
+            break;
+        }
+
+        struct ecr_async_log_spec spec;
+        ECR_STATUS_GUARD(ecr_async_log_parse(percent, &spec));
+
+        if(spec.argument == ARGUMENT_LITERAL) {
+            ECR_STATUS_GUARD(ecr_async_log_emit(log, "%", 1));
+        } else {
+            ECR_STATUS_GUARD(ecr_async_log_emit_spec(log, &spec, payload));
+            payload += ecr_async_log_payload_size(&spec, payload);
+        }
+
+        format = spec.end;
+    }
+
+    return ECR_SUCCESS;
+}
+
+static void ecr_async_log_fail(ecr_async_log_t *log, ecr_status_t status) {
+    ecr_status_t expected = ECR_SUCCESS;
+    atomic_compare_exchange_strong(&log->status, &expected, status);
+}
+
+static uint_least64_t ecr_async_log_now() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint_least64_t) now.tv_sec * 1000000000 + (uint_least64_t) now.tv_nsec;
+}
+
+static bool ecr_async_log_ready(ecr_async_log_t *log) {
+    struct ecr_async_log_slot *slot = ecr_async_log_slot(log, log->dequeue_position);
+    return atomic_load_explicit(&slot->sequence, memory_order_acquire) == log->dequeue_position + 1;
+}
+
+static void * ecr_async_log_consume(void *data) {
+    ecr_async_log_t *log = data;
+
+    size_t pending = 0;
+    uint_least64_t deadline = 0;
+    while(true) {
+        if(ecr_async_log_ready(log)) {
+            struct ecr_async_log_slot *slot = ecr_async_log_slot(log, log->dequeue_position);
+            if(pending == 0) {
+                deadline = ecr_async_log_now() + log->config.max_latency_ns;
+            }
+
+            if(slot->format) {
+                ecr_status_t status = ecr_async_log_format(log, slot);
+                if(status) {
+                    ecr_async_log_fail(log, status);
+                }
+                pending++;
+            }
+
+            atomic_store_explicit(&slot->sequence, log->dequeue_position + log->mask + 1, memory_order_release);
+            log->dequeue_position++;
+
+            atomic_fetch_add(&log->released, 1);
+            if(atomic_load(&log->blocked)) {
+                ecr_futex_wake(&log->released, INT_MAX, false);
+            }
+
+            if(pending >= log->config.batch_size || (pending > 0 && ecr_async_log_now() >= deadline)) {
+                ecr_status_t status = ecr_async_log_flush(log);
+                if(status) {
+                    ecr_async_log_fail(log, status);
+                }
+                pending = 0;
+            }
+            continue;
+        }
+
+        struct timespec timeout, *timeout_ptr = NULL;
+        if(pending > 0) {
+            uint_least64_t now = ecr_async_log_now();
+            if(now >= deadline || atomic_load(&log->closing)) {
+                ecr_status_t status = ecr_async_log_flush(log);
+                if(status) {
+                    ecr_async_log_fail(log, status);
+                }
+                pending = 0;
+                continue;
+            }
+
+            timeout.tv_sec  = (time_t) ((deadline - now) / 1000000000);
+            timeout.tv_nsec = (long) ((deadline - now) % 1000000000);
+            timeout_ptr = &timeout;
+        } else if(atomic_load(&log->closing)) {
+            break;
+        }
+
+        atomic_store(&log->consumer_state, CONSUMER_SLEEPING);
+        if(!ecr_async_log_ready(log) && !atomic_load(&log->closing)) {
+            ecr_futex_wait(&log->consumer_state, CONSUMER_SLEEPING, timeout_ptr, false);
+        }
+        atomic_store(&log->consumer_state, CONSUMER_RUNNING);
+    }
+
+    return NULL;
+}
+
+static void ecr_async_log_wake(ecr_async_log_t *log) {
+    if(atomic_load(&log->consumer_state) == CONSUMER_SLEEPING
+            && atomic_exchange(&log->consumer_state, CONSUMER_RUNNING) == CONSUMER_SLEEPING) {
+        ecr_futex_wake(&log->consumer_state, 1, false);
+    }
+}
+
+static ecr_status_t ecr_async_log_acquire(ecr_async_log_t *log, struct ecr_async_log_slot **slot_ptr) {
+    size_t position = atomic_load_explicit(&log->enqueue_position, memory_order_relaxed);
+    while(true) {
+        struct ecr_async_log_slot *slot = ecr_async_log_slot(log, position);
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t) (sequence - position);
+
+        if(difference == 0) {
+            if(atomic_compare_exchange_weak_explicit(&log->enqueue_position, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+                *slot_ptr = slot;
+                return ECR_SUCCESS;
+            }
+        } else if(difference < 0) {
+            switch(log->config.overflow) {
+                case ECR_ASYNC_LOG_OVERFLOW_DROP:
+                    return ECR_ERROR_FULL_BUFFER;
+                case ECR_ASYNC_LOG_OVERFLOW_COUNT:
+                    atomic_fetch_add_explicit(&log->dropped, 1, memory_order_relaxed);
+                    *slot_ptr = NULL;
+                    return ECR_SUCCESS;
+                default:
+                    break;
+            }
+
+            atomic_fetch_add(&log->blocked, 1);
+            uint32_t released = atomic_load(&log->released);
+            if(atomic_load_explicit(&slot->sequence, memory_order_acquire) == sequence) {
+                ecr_futex_wait(&log->released, released, NULL, false);
+            }
+            atomic_fetch_sub(&log->blocked, 1);
+
+            position = atomic_load_explicit(&log->enqueue_position, memory_order_relaxed);
+        } else {
+            position = atomic_load_explicit(&log->enqueue_position, memory_order_relaxed);
+        }
+    }
+}
+
+ecr_status_t ecr_async_log_vprintf(ecr_async_log_t *log, const char *format, va_list vlist) {
+    ECR_STATUS_GUARD(atomic_load_explicit(&log->status, memory_order_relaxed));
+
+    struct ecr_async_log_slot *slot;
+    ECR_STATUS_GUARD(ecr_async_log_acquire(log, &slot));
+    if(!slot) {
+        return ECR_SUCCESS;
+    }
+
+    size_t position = atomic_load_explicit(&slot->sequence, memory_order_relaxed);
+
+    ecr_status_t status = ecr_async_log_capture(slot, log->config.record_size, format, vlist);
+    slot->format = status ? NULL : format;
+
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+    ecr_async_log_wake(log);
+    return status;
+}
+
+ecr_status_t ecr_async_log_printf(ecr_async_log_t *log, const char *format, ...) {
+    va_list vlist;
+    va_start(vlist, format);
+    ecr_status_t status = ecr_async_log_vprintf(log, format, vlist);
+
+    va_end(vlist);
+    return status;
+}
+
+ecr_status_t ecr_async_log_dropped(ecr_async_log_t *log, uint_least64_t *dropped) {
+    *dropped = atomic_load_explicit(&log->dropped, memory_order_relaxed);
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_async_log_close(ecr_async_log_t *log) {
+    atomic_store(&log->closing, true);
+    atomic_store(&log->consumer_state, CONSUMER_RUNNING);
+    ecr_futex_wake(&log->consumer_state, 1, false);
+
+    int error = pthread_join(log->consumer, NULL);
+    if(error) {
+        errno = error;
+        return ecr_get_system_error();
+    }
+
+    ecr_status_t status = atomic_load(&log->status);
+    ecr_status_t free_status = ecr_buffer_free(&log->output, log->allocator);
+    if(!status) {
+        status = free_status;
+    }
+
+    free_status = ecr_free(log->allocator, log->slots);
+    if(!status) {
+        status = free_status;
+    }
+
+    free_status = ecr_free(log->allocator, log);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+ecr_status_t ecr_async_log_open(ecr_async_log_t **log_ptr, ecr_stream_t *sink, ecr_allocator_t *allocator, const ecr_async_log_config_t *config) {
+    if(config->capacity == 0 || config->batch_size == 0) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t capacity = 1;
+    while(capacity < config->capacity) {
+        if(ckd_mul(&capacity, capacity, 2)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+    }
+
+    size_t slot_size;
+    if(ckd_add(&slot_size, sizeof(struct ecr_async_log_slot) + CACHE_LINE_SIZE - 1, config->record_size)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+    slot_size &= ~(size_t) (CACHE_LINE_SIZE - 1);
+
+    size_t slots_size;
+    if(ckd_mul(&slots_size, slot_size, capacity)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    ecr_async_log_t *log;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &log, sizeof(*log)));
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_allocate(allocator, &log->slots, slots_size), {
+        ecr_free(allocator, log);
+    });
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_buffer_allocate(&log->output, allocator, OUTPUT_CAPACITY), {
+        ecr_free(allocator, log->slots);
+        ecr_free(allocator, log);
+    });
+
+    log->sink = sink;
+    log->allocator = allocator;
+    log->config = *config;
+    log->slot_size = slot_size;
+    log->mask = capacity - 1;
+
+    for(size_t i = 0; i < capacity; i++) {
+        atomic_init(&ecr_async_log_slot(log, i)->sequence, i);
+    }
+
+    atomic_init(&log->enqueue_position, 0);
+    atomic_init(&log->consumer_state, CONSUMER_RUNNING);
+    atomic_init(&log->released, 0);
+    atomic_init(&log->blocked, 0);
+    atomic_init(&log->closing, false);
+    atomic_init(&log->status, ECR_SUCCESS);
+    atomic_init(&log->dropped, 0);
+    log->dequeue_position = 0;
+
+    int error = pthread_create(&log->consumer, NULL, ecr_async_log_consume, log);
+    if(error) {
+        ecr_buffer_free(&log->output, allocator);
+        ecr_free(allocator, log->slots);
+        ecr_free(allocator, log);
+
+        errno = error;
+        return ecr_get_system_error();
+    }
+
+    *log_ptr = log;
+    return ECR_SUCCESS;
+}
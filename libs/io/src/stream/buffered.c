@@ -0,0 +1,410 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdckdint.h>
+#include <string.h>
+
+#include "ecr/allocator.h"
+#include "ecr/buffer.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/buffered.h"
+
+struct ecr_stream_buffered {
+    ecr_stream_t *inner;
+    ecr_allocator_t *allocator;
+
+    // holds unread data while reading, and unwritten data while writing, between its position and length
+    ecr_buffer_t buffer;
+    bool writing;
+};
+
+static ecr_status_t ecr_stream_buffered_drain(struct ecr_stream_buffered *buffered) {
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    if(buffer->position < buffer->length) {
+        ECR_STATUS_GUARD(ecr_stream_writebuf_full(buffered->inner, buffer));
+    }
+
+    buffer->position = 0;
+    buffer->length = 0;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_buffered_discard(struct ecr_stream_buffered *buffered) {
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    // the inner stream has read ahead of this stream's position
+    ecr_stream_pos_t unread = buffer->length - buffer->position;
+    if(unread > 0) {
+        ECR_STATUS_GUARD(ecr_stream_setpos(buffered->inner, &unread, ECR_STREAM_DIR_REWIND));
+    }
+
+    buffer->position = 0;
+    buffer->length = 0;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_buffered_set_writing(struct ecr_stream_buffered *buffered, bool writing) {
+    if(buffered->writing == writing) {
+        return ECR_SUCCESS;
+    }
+
+    if(writing) {
+        ECR_STATUS_GUARD(ecr_stream_buffered_discard(buffered));
+    } else {
+        ECR_STATUS_GUARD(ecr_stream_buffered_drain(buffered));
+    }
+
+    buffered->writing = writing;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_buffered_grow(struct ecr_stream_buffered *buffered, size_t minimum) {
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    size_t capacity = buffer->capacity;
+    while(capacity < minimum) {
+        if(ckd_mul(&capacity, capacity, 2)) {
+            capacity = minimum;
+        }
+    }
+
+    ecr_buffer_t grown;
+    ECR_STATUS_GUARD(ecr_buffer_allocate(&grown, buffered->allocator, capacity));
+
+    grown.length = buffer->length - buffer->position;
+    memcpy(grown.memory, buffer->memory + buffer->position, grown.length);
+
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_buffer_free(buffer, buffered->allocator), {
+        ecr_buffer_free(&grown, buffered->allocator);
+    });
+
+    *buffer = grown;
+    return ECR_SUCCESS;
+}
+
+// reads until at least **minimum** bytes are unread, moving the unread data to the front of the buffer first if it won't fit
+static ecr_status_t ecr_stream_buffered_read_ahead(struct ecr_stream_buffered *buffered, size_t minimum) {
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    if(minimum > buffer->capacity) {
+        ECR_STATUS_GUARD(ecr_stream_buffered_grow(buffered, minimum));
+    } else if(minimum > buffer->capacity - buffer->position) {
+        buffer->length -= buffer->position;
+        memmove(buffer->memory, buffer->memory + buffer->position, buffer->length);
+        buffer->position = 0;
+    }
+
+    ecr_buffer_t space = {
+        .memory = buffer->memory,
+        .capacity = buffer->capacity,
+        .position = buffer->length,
+        .length = buffer->capacity,
+    };
+
+    ecr_status_t status = ECR_SUCCESS;
+    while(!status && space.position - buffer->position < minimum) {
+        status = ecr_stream_readbuf(buffered->inner, &space);
+    }
+
+    buffer->length = space.position;
+    return status;
+}
+
+static ecr_status_t ecr_stream_buffered_readbuf(void *data, ecr_buffer_t *restrict out) {
+    struct ecr_stream_buffered *buffered = data;
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    size_t length = out->length - out->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ECR_STATUS_GUARD(ecr_stream_buffered_set_writing(buffered, false));
+
+    if(buffer->position == buffer->length) {
+        buffer->position = 0;
+        buffer->length = 0;
+
+        if(length >= buffer->capacity) {
+            return ecr_stream_readbuf(buffered->inner, out);
+        }
+
+        ECR_STATUS_GUARD(ecr_stream_buffered_read_ahead(buffered, 1));
+    }
+
+    if(length > buffer->length - buffer->position) {
+        length = buffer->length - buffer->position;
+    }
+
+    memcpy(out->memory + out->position, buffer->memory + buffer->position, length);
+    buffer->position += length;
+
+    out->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_buffered_writebuf(void *data, ecr_buffer_t *restrict in) {
+    struct ecr_stream_buffered *buffered = data;
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    size_t length = in->length - in->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ECR_STATUS_GUARD(ecr_stream_buffered_set_writing(buffered, true));
+
+    if(buffer->length == buffer->capacity) {
+        ECR_STATUS_GUARD(ecr_stream_buffered_drain(buffered));
+    }
+
+    if(buffer->length == 0 && length >= buffer->capacity) {
+        return ecr_stream_writebuf(buffered->inner, in);
+    }
+
+    if(length > buffer->capacity - buffer->length) {
+        length = buffer->capacity - buffer->length;
+    }
+
+    memcpy(buffer->memory + buffer->length, in->memory + in->position, length);
+    buffer->length += length;
+
+    in->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_buffered_close(void *data) {
+    struct ecr_stream_buffered *buffered = data;
+
+    ecr_status_t status = ECR_SUCCESS;
+    if(buffered->writing) {
+        status = ecr_stream_buffered_drain(buffered);
+    }
+
+    ecr_status_t free_status = ecr_buffer_free(&buffered->buffer, buffered->allocator);
+    if(!status) {
+        status = free_status;
+    }
+
+    free_status = ecr_free(buffered->allocator, buffered);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_buffered_getpos(void *data, ecr_stream_pos_t *restrict position) {
+    struct ecr_stream_buffered *buffered = data;
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    ECR_STATUS_GUARD(ecr_stream_getpos(buffered->inner, position));
+
+    if(buffered->writing) {
+        *position += buffer->length - buffer->position;
+    } else {
+        *position -= buffer->length - buffer->position;
+    }
+
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_buffered_setpos(void *data, ecr_stream_pos_t *restrict position, ecr_stream_dir_t direction) {
+    struct ecr_stream_buffered *buffered = data;
+
+    if(buffered->writing) {
+        ECR_STATUS_GUARD(ecr_stream_buffered_drain(buffered));
+    } else {
+        ECR_STATUS_GUARD(ecr_stream_buffered_discard(buffered));
+    }
+
+    return ecr_stream_setpos(buffered->inner, position, direction);
+}
+
+ecr_status_t ecr_stream_open_buffered(ecr_stream_t *stream, ecr_stream_t *inner, ecr_allocator_t *allocator, size_t capacity) {
+    if(capacity == 0) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_buffered *buffered;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &buffered, sizeof(*buffered)));
+
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_buffer_allocate(&buffered->buffer, allocator, capacity), {
+        ecr_free(allocator, buffered);
+    });
+
+    buffered->inner = inner;
+    buffered->allocator = allocator;
+    buffered->writing = false;
+
+    stream->version = 0;
+    stream->data = buffered;
+
+    stream->readbuf  = ecr_stream_buffered_readbuf;
+    stream->writebuf = ecr_stream_buffered_writebuf;
+    stream->close    = ecr_stream_buffered_close;
+    stream->getpos   = ecr_stream_buffered_getpos;
+    stream->setpos   = ecr_stream_buffered_setpos;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_buffered_flush(ecr_stream_t *stream) {
+    if(stream->close != ecr_stream_buffered_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_buffered *buffered = stream->data;
+    if(!buffered->writing) {
+        return ECR_SUCCESS;
+    }
+
+    return ecr_stream_buffered_drain(buffered);
+}
+
+ecr_status_t ecr_stream_buffered_fill(ecr_stream_t *stream, size_t minimum, const void **memory, size_t *length) {
+    if(stream->close != ecr_stream_buffered_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_buffered *buffered = stream->data;
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    ECR_STATUS_GUARD(ecr_stream_buffered_set_writing(buffered, false));
+
+    ecr_status_t status = ECR_SUCCESS;
+    if(buffer->length - buffer->position < minimum) {
+        status = ecr_stream_buffered_read_ahead(buffered, minimum);
+    }
+
+    *memory = buffer->memory + buffer->position;
+    *length = buffer->length - buffer->position;
+
+    if(status && *length >= minimum) {
+        // enough was read before the error; it will come up again on the next read
+        status = ECR_SUCCESS;
+    }
+
+    return status;
+}
+
+ecr_status_t ecr_stream_buffered_consume(ecr_stream_t *stream, size_t length) {
+    if(stream->close != ecr_stream_buffered_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_buffered *buffered = stream->data;
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    if(buffered->writing || length > buffer->length - buffer->position) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_buffered_reserve(ecr_stream_t *stream, size_t minimum, void **memory, size_t *length) {
+    if(stream->close != ecr_stream_buffered_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_buffered *buffered = stream->data;
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    ECR_STATUS_GUARD(ecr_stream_buffered_set_writing(buffered, true));
+
+    if(buffer->capacity - buffer->length < minimum) {
+        ECR_STATUS_GUARD(ecr_stream_buffered_drain(buffered));
+
+        if(buffer->capacity < minimum) {
+            ECR_STATUS_GUARD(ecr_stream_buffered_grow(buffered, minimum));
+        }
+    }
+
+    *memory = buffer->memory + buffer->length;
+    *length = buffer->capacity - buffer->length;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_buffered_commit(ecr_stream_t *stream, size_t length) {
+    if(stream->close != ecr_stream_buffered_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_buffered *buffered = stream->data;
+    ecr_buffer_t *buffer = &buffered->buffer;
+
+    if(!buffered->writing || length > buffer->capacity - buffer->length) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    buffer->length += length;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_read_until(ecr_stream_t *stream, unsigned char delimiter, size_t max_length, const void **record, size_t *length) {
+    const unsigned char *memory;
+    size_t available;
+    ECR_STATUS_GUARD(ecr_stream_buffered_fill(stream, 1, (const void **) &memory, &available));
+
+    // only scan newly read data, so that long records aren't scanned over and over
+    size_t scanned = 0;
+    while(true) {
+        const unsigned char *end = memchr(memory + scanned, delimiter, available - scanned);
+        if(end) {
+            available = end - memory + 1;
+            break;
+        }
+
+        if(available >= max_length) {
+            return ECR_ERROR_FULL_BUFFER;
+        }
+
+        scanned = available;
+
+        ecr_status_t status = ecr_stream_buffered_fill(stream, available + 1, (const void **) &memory, &available);
+        if(status == ECR_ERROR_EOF) {
+            break;
+        }
+        ECR_STATUS_GUARD(status);
+    }
+
+    if(available > max_length) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ECR_STATUS_GUARD(ecr_stream_buffered_consume(stream, available));
+
+    *record = memory;
+    *length = available;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_readline(ecr_stream_t *stream, size_t max_length, const char **line, size_t *length) {
+    ECR_STATUS_GUARD(ecr_stream_read_until(stream, '\n', max_length, (const void **) line, length));
+
+    if(*length > 0 && (*line)[*length - 1] == '\n') {
+        (*length)--;
+
+        if(*length > 0 && (*line)[*length - 1] == '\r') {
+            (*length)--;
+        }
+    }
+
+    return ECR_SUCCESS;
+}
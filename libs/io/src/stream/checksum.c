@@ -0,0 +1,206 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+#include "ecr/allocator.h"
+#include "ecr/buffer.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/checksum.h"
+
+#define CRC32C_POLYNOMIAL 0x82F63B78
+
+struct ecr_stream_checksum {
+    ecr_stream_t *inner;
+    ecr_allocator_t *allocator;
+    uint_least32_t crc;
+};
+
+typedef uint32_t ecr_crc32c_fn_t(uint32_t crc, const unsigned char *memory, size_t length);
+
+static uint32_t crc32c_table[8][256];
+static ecr_crc32c_fn_t *crc32c_kernel;
+static pthread_once_t crc32c_once = PTHREAD_ONCE_INIT;
+
+static uint32_t ecr_crc32c_portable(uint32_t crc, const unsigned char *memory, size_t length) {
+    for(; length > 0 && ((uintptr_t) memory & 7) != 0; length--) {
+        crc = crc32c_table[0][(crc ^ *memory++) & 0xFF] ^ (crc >> 8);
+    }
+
+    // slicing-by-8: one table lookup per byte, eight independent lookups per word
+    for(; length >= 8; length -= 8) {
+        uint64_t word;
+        memcpy(&word, memory, sizeof(word));
+        memory += 8;
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        word ^= crc;
+
+        crc = crc32c_table[7][word & 0xFF]
+            ^ crc32c_table[6][(word >> 8) & 0xFF]
+            ^ crc32c_table[5][(word >> 16) & 0xFF]
+            ^ crc32c_table[4][(word >> 24) & 0xFF]
+            ^ crc32c_table[3][(word >> 32) & 0xFF]
+            ^ crc32c_table[2][(word >> 40) & 0xFF]
+            ^ crc32c_table[1][(word >> 48) & 0xFF]
+            ^ crc32c_table[0][word >> 56];
+    }
+
+    for(; length > 0; length--) {
+        crc = crc32c_table[0][(crc ^ *memory++) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+#if defined(__x86_64__)
+[[gnu::target("sse4.2")]]
+static uint32_t ecr_crc32c_sse42(uint32_t crc, const unsigned char *memory, size_t length) {
+    for(; length > 0 && ((uintptr_t) memory & 7) != 0; length--) {
+        crc = _mm_crc32_u8(crc, *memory++);
+    }
+
+    uint64_t crc64 = crc;
+    for(; length >= 8; length -= 8) {
+        uint64_t word;
+        memcpy(&word, memory, sizeof(word));
+        memory += 8;
+
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = crc64;
+
+    for(; length > 0; length--) {
+        crc = _mm_crc32_u8(crc, *memory++);
+    }
+
+    return crc;
+}
+#endif
+
+static void ecr_crc32c_init() {
+    for(uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for(int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (CRC32C_POLYNOMIAL & -(crc & 1));
+        }
+        crc32c_table[0][i] = crc;
+    }
+
+    for(uint32_t i = 0; i < 256; i++) {
+        for(int slice = 1; slice < 8; slice++) {
+            uint32_t crc = crc32c_table[slice - 1][i];
+            crc32c_table[slice][i] = crc32c_table[0][crc & 0xFF] ^ (crc >> 8);
+        }
+    }
+
+    crc32c_kernel = ecr_crc32c_portable;
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("sse4.2")) {
+        crc32c_kernel = ecr_crc32c_sse42;
+    }
+#endif
+}
+
+uint_least32_t ecr_crc32c(uint_least32_t crc, const void *memory, size_t length) {
+    pthread_once(&crc32c_once, ecr_crc32c_init);
+    return ~crc32c_kernel(~(uint32_t) crc, memory, length);
+}
+
+static ecr_status_t ecr_stream_checksum_readbuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_checksum *checksum = data;
+
+    size_t position = buffer->position;
+    ecr_status_t status = ecr_stream_readbuf(checksum->inner, buffer);
+    checksum->crc = ecr_crc32c(checksum->crc, buffer->memory + position, buffer->position - position);
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_checksum_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_checksum *checksum = data;
+
+    size_t position = buffer->position;
+    ecr_status_t status = ecr_stream_writebuf(checksum->inner, buffer);
+    checksum->crc = ecr_crc32c(checksum->crc, buffer->memory + position, buffer->position - position);
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_checksum_close(void *data) {
+    struct ecr_stream_checksum *checksum = data;
+    return ecr_free(checksum->allocator, checksum);
+}
+
+static ecr_status_t ecr_stream_checksum_getpos(void *data, ecr_stream_pos_t *restrict position) {
+    struct ecr_stream_checksum *checksum = data;
+    return ecr_stream_getpos(checksum->inner, position);
+}
+
+static ecr_status_t ecr_stream_checksum_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_checksum(ecr_stream_t *stream, ecr_stream_t *inner, ecr_allocator_t *allocator) {
+    struct ecr_stream_checksum *checksum;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &checksum, sizeof(*checksum)));
+
+    checksum->inner = inner;
+    checksum->allocator = allocator;
+    checksum->crc = 0;
+
+    stream->version = 0;
+    stream->data = checksum;
+
+    stream->readbuf  = ecr_stream_checksum_readbuf;
+    stream->writebuf = ecr_stream_checksum_writebuf;
+    stream->close    = ecr_stream_checksum_close;
+    stream->getpos   = ecr_stream_checksum_getpos;
+    stream->setpos   = ecr_stream_checksum_setpos;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_checksum_digest(ecr_stream_t *stream, uint_least32_t *digest) {
+    if(stream->close != ecr_stream_checksum_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_checksum *checksum = stream->data;
+    *digest = checksum->crc;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_checksum_verify(ecr_stream_t *stream, uint_least32_t expected) {
+    uint_least32_t digest;
+    ECR_STATUS_GUARD(ecr_stream_checksum_digest(stream, &digest));
+
+    if(digest != expected) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    return ECR_SUCCESS;
+}
@@ -0,0 +1,563 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdckdint.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ecr/allocator.h"
+#include "ecr/buffer.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/compress.h"
+
+#define FRAME_MAGIC       0x5A524345 // "ECRZ"
+#define FRAME_HEADER_SIZE 8
+#define BLOCK_HEADER_SIZE 8
+#define BLOCK_STORED      0x80000000
+
+#define LZ_HASH_BITS  12
+#define LZ_MIN_MATCH  4
+#define LZ_MAX_OFFSET 0xFFFF
+
+struct ecr_stream_compress {
+    ecr_stream_t *sink;
+    ecr_allocator_t *allocator;
+    bool started;
+
+    ecr_buffer_t block;
+    ecr_buffer_t output;
+    uint32_t table[1 << LZ_HASH_BITS];
+};
+
+struct ecr_stream_decompress {
+    ecr_stream_t *source;
+    ecr_allocator_t *allocator;
+    ecr_status_t status;
+
+    ecr_buffer_t block;
+    ecr_buffer_t input;
+};
+
+static uint32_t load_le32(const unsigned char *memory) {
+    return (uint32_t) memory[0] | (uint32_t) memory[1] << 8 | (uint32_t) memory[2] << 16 | (uint32_t) memory[3] << 24;
+}
+
+static void store_le32(unsigned char *memory, uint32_t value) {
+    memory[0] = value;
+    memory[1] = value >> 8;
+    memory[2] = value >> 16;
+    memory[3] = value >> 24;
+}
+
+static uint32_t lz_load32(const unsigned char *memory) {
+    uint32_t value;
+    memcpy(&value, memory, sizeof(value));
+    return value;
+}
+
+static uint32_t lz_hash(uint32_t value) {
+    return (value * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static size_t lz_match_length(const unsigned char *memory, size_t match, size_t position, size_t length) {
+    size_t start = position;
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while(position + 8 <= length) {
+        uint64_t a, b;
+        memcpy(&a, memory + match, sizeof(a));
+        memcpy(&b, memory + position, sizeof(b));
+
+        if(a != b) {
+            return position - start + (__builtin_ctzll(a ^ b) >> 3);
+        }
+
+        match += 8;
+        position += 8;
+    }
+#endif
+
+    while(position < length && memory[match] == memory[position]) {
+        match++;
+        position++;
+    }
+
+    return position - start;
+}
+
+static unsigned char * lz_put_length(unsigned char *out, size_t length) {
+    for(; length >= 255; length -= 255) {
+        *out++ = 255;
+    }
+    *out++ = length;
+
+    return out;
+}
+
+/*
+ * Each sequence is a token holding the literal length and match length in its upper and lower nibble,
+ * the rest of the literal length (if the nibble is 15), the literals, a 16-bit little-endian match offset,
+ * and the rest of the match length. The final sequence consists of literals only.
+ *
+ * Returns the compressed size, or 0 if it would exceed the output's capacity.
+ */
+static size_t lz_compress(const unsigned char *memory, size_t length, unsigned char *out, size_t capacity, uint32_t *table) {
+    memset(table, 0, sizeof(uint32_t) << LZ_HASH_BITS);
+
+    unsigned char *out_start = out, *out_end = out + capacity;
+    size_t position = 0, anchor = 0;
+
+    while(true) {
+        size_t match = 0, match_length = 0;
+        while(position + LZ_MIN_MATCH <= length) {
+            uint32_t value = lz_load32(memory + position);
+            uint32_t *entry = &table[lz_hash(value)];
+            match = *entry;
+            *entry = position;
+
+            if(match < position && position - match <= LZ_MAX_OFFSET && lz_load32(memory + match) == value) {
+                match_length = LZ_MIN_MATCH + lz_match_length(memory, match + LZ_MIN_MATCH, position + LZ_MIN_MATCH, length);
+                break;
+            }
+
+            // skip ahead faster the longer no match has been found
+            position += 1 + ((position - anchor) >> 6);
+        }
+
+        if(match_length == 0) {
+            position = length;
+        } else {
+            while(position > anchor && match > 0 && memory[position - 1] == memory[match - 1]) {
+                position--;
+                match--;
+                match_length++;
+            }
+        }
+
+        size_t literals = position - anchor;
+        if((size_t) (out_end - out) < 1 + literals / 255 + 1 + literals + 2 + match_length / 255 + 1) {
+            return 0;
+        }
+
+        unsigned char *token = out++;
+        *token = (literals < 15 ? literals : 15) << 4;
+        if(literals >= 15) {
+            out = lz_put_length(out, literals - 15);
+        }
+
+        memcpy(out, memory + anchor, literals);
+        out += literals;
+
+        if(match_length == 0) {
+            break;
+        }
+
+        size_t offset = position - match;
+        *out++ = offset;
+        *out++ = offset >> 8;
+
+        size_t extra = match_length - LZ_MIN_MATCH;
+        *token |= extra < 15 ? extra : 15;
+        if(extra >= 15) {
+            out = lz_put_length(out, extra - 15);
+        }
+
+        position += match_length;
+        anchor = position;
+    }
+
+    return out - out_start;
+}
+
+static bool lz_get_length(const unsigned char **in, const unsigned char *in_end, size_t *length) {
+    unsigned char byte;
+    do {
+        if(*in == in_end || ckd_add(length, *length, (byte = *(*in)++))) {
+            return false;
+        }
+    } while(byte == 255);
+
+    return true;
+}
+
+static ecr_status_t lz_decompress(const unsigned char *in, size_t in_length, unsigned char *out, size_t out_length) {
+    const unsigned char *in_end = in + in_length;
+    size_t position = 0;
+
+    while(true) {
+        if(in == in_end) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+        unsigned char token = *in++;
+
+        size_t literals = token >> 4;
+        if(literals == 15 && !lz_get_length(&in, in_end, &literals)) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+        if(literals > (size_t) (in_end - in) || literals > out_length - position) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+
+        memcpy(out + position, in, literals);
+        in += literals;
+        position += literals;
+
+        if(in == in_end) {
+            break;
+        }
+
+        if(in_end - in < 2) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+        size_t offset = in[0] | (size_t) in[1] << 8;
+        in += 2;
+
+        size_t match_length = token & 15;
+        if(match_length == 15 && !lz_get_length(&in, in_end, &match_length)) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+        if(offset == 0 || offset > position || ckd_add(&match_length, match_length, LZ_MIN_MATCH) || match_length > out_length - position) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+
+        if(offset >= match_length) {
+            memcpy(out + position, out + position - offset, match_length);
+            position += match_length;
+        } else {
+            // overlapping match, repeating the last `offset` bytes
+            for(size_t end = position + match_length; position < end; position++) {
+                out[position] = out[position - offset];
+            }
+        }
+    }
+
+    if(position != out_length) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_compress_start(struct ecr_stream_compress *compress) {
+    if(compress->started) {
+        return ECR_SUCCESS;
+    }
+
+    unsigned char header[FRAME_HEADER_SIZE];
+    store_le32(header, FRAME_MAGIC);
+    store_le32(header + 4, compress->block.capacity);
+
+    size_t length = sizeof(header);
+    ECR_STATUS_GUARD(ecr_stream_write_full(compress->sink, header, &length));
+
+    compress->started = true;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_compress_block(struct ecr_stream_compress *compress, void *memory, size_t length) {
+    ECR_STATUS_GUARD(ecr_stream_compress_start(compress));
+
+    unsigned char *header = compress->output.memory;
+    size_t compressed = lz_compress(memory, length, compress->output.memory + BLOCK_HEADER_SIZE, length - 1, compress->table);
+
+    if(compressed > 0) {
+        store_le32(header, compressed);
+        store_le32(header + 4, length);
+
+        size_t output_length = BLOCK_HEADER_SIZE + compressed;
+        return ecr_stream_write_full(compress->sink, header, &output_length);
+    }
+
+    store_le32(header, length | BLOCK_STORED);
+    store_le32(header + 4, length);
+
+    size_t header_length = BLOCK_HEADER_SIZE;
+    ECR_STATUS_GUARD(ecr_stream_write_full(compress->sink, header, &header_length));
+    return ecr_stream_write_full(compress->sink, memory, &length);
+}
+
+static ecr_status_t ecr_stream_compress_readbuf(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_compress_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_compress *compress = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ecr_buffer_t *block = &compress->block;
+    if(block->position == block->capacity) {
+        ECR_STATUS_GUARD(ecr_stream_compress_block(compress, block->memory, block->position));
+        block->position = 0;
+    }
+
+    if(block->position == 0 && length >= block->capacity) {
+        ECR_STATUS_GUARD(ecr_stream_compress_block(compress, buffer->memory + buffer->position, block->capacity));
+        buffer->position += block->capacity;
+        return ECR_SUCCESS;
+    }
+
+    if(length > block->capacity - block->position) {
+        length = block->capacity - block->position;
+    }
+
+    memcpy(block->memory + block->position, buffer->memory + buffer->position, length);
+    block->position += length;
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_compress_free(struct ecr_stream_compress *compress) {
+    ecr_status_t status = ecr_buffer_free(&compress->output, compress->allocator);
+
+    ecr_status_t free_status = ecr_buffer_free(&compress->block, compress->allocator);
+    if(!status) {
+        status = free_status;
+    }
+
+    free_status = ecr_free(compress->allocator, compress);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_compress_close(void *data) {
+    struct ecr_stream_compress *compress = data;
+
+    ecr_status_t status = ECR_SUCCESS;
+    if(compress->block.position > 0) {
+        status = ecr_stream_compress_block(compress, compress->block.memory, compress->block.position);
+    }
+
+    if(!status) {
+        status = ecr_stream_compress_start(compress);
+    }
+
+    if(!status) {
+        unsigned char trailer[BLOCK_HEADER_SIZE] = { 0 };
+        size_t length = sizeof(trailer);
+        status = ecr_stream_write_full(compress->sink, trailer, &length);
+    }
+
+    ecr_status_t free_status = ecr_stream_compress_free(compress);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_compress_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_compress_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_compress(ecr_stream_t *stream, ecr_stream_t *sink, ecr_allocator_t *allocator, size_t block_size) {
+    if(block_size == 0 || block_size > ECR_STREAM_COMPRESS_BLOCK_MAX) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_compress *compress;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &compress, sizeof(*compress)));
+
+    compress->block = (ecr_buffer_t) { 0 };
+    compress->output = (ecr_buffer_t) { 0 };
+    compress->allocator = allocator;
+
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_buffer_allocate(&compress->block, allocator, block_size), {
+        ecr_free(allocator, compress);
+    });
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_buffer_allocate(&compress->output, allocator, BLOCK_HEADER_SIZE + block_size), {
+        ecr_buffer_free(&compress->block, allocator);
+        ecr_free(allocator, compress);
+    });
+
+    compress->sink = sink;
+    compress->started = false;
+    compress->block.position = 0;
+
+    stream->version = 0;
+    stream->data = compress;
+
+    stream->readbuf  = ecr_stream_compress_readbuf;
+    stream->writebuf = ecr_stream_compress_writebuf;
+    stream->close    = ecr_stream_compress_close;
+    stream->getpos   = ecr_stream_compress_getpos;
+    stream->setpos   = ecr_stream_compress_setpos;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_decompress_read(struct ecr_stream_decompress *decompress, void *memory, size_t length) {
+    ecr_status_t status = ecr_stream_read_full(decompress->source, memory, &length);
+    if(status == ECR_ERROR_EOF) {
+        // the end of the compressed data is marked explicitly, so running out of it early means it's truncated
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_decompress_start(struct ecr_stream_decompress *decompress) {
+    unsigned char header[FRAME_HEADER_SIZE];
+    ECR_STATUS_GUARD(ecr_stream_decompress_read(decompress, header, sizeof(header)));
+
+    size_t block_size = load_le32(header + 4);
+    if(load_le32(header) != FRAME_MAGIC || block_size == 0 || block_size > ECR_STREAM_COMPRESS_BLOCK_MAX) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    ecr_buffer_t block, input;
+    ECR_STATUS_GUARD(ecr_buffer_allocate(&block, decompress->allocator, block_size));
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_buffer_allocate(&input, decompress->allocator, block_size), {
+        ecr_buffer_free(&block, decompress->allocator);
+    });
+
+    decompress->block = block;
+    decompress->input = input;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_decompress_block(struct ecr_stream_decompress *decompress) {
+    if(decompress->block.memory == NULL) {
+        ECR_STATUS_GUARD(ecr_stream_decompress_start(decompress));
+    }
+
+    unsigned char header[BLOCK_HEADER_SIZE];
+    ECR_STATUS_GUARD(ecr_stream_decompress_read(decompress, header, sizeof(header)));
+
+    uint32_t size = load_le32(header);
+    size_t length = load_le32(header + 4);
+    if(size == 0 && length == 0) {
+        return ECR_ERROR_EOF;
+    }
+
+    ecr_buffer_t *block = &decompress->block;
+    if(length == 0 || length > block->capacity) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    if(size & BLOCK_STORED) {
+        if((size & ~BLOCK_STORED) != length) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+
+        ECR_STATUS_GUARD(ecr_stream_decompress_read(decompress, block->memory, length));
+    } else {
+        if(size == 0 || size > decompress->input.capacity) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+
+        ECR_STATUS_GUARD(ecr_stream_decompress_read(decompress, decompress->input.memory, size));
+        ECR_STATUS_GUARD(lz_decompress(decompress->input.memory, size, block->memory, length));
+    }
+
+    block->position = 0;
+    block->length = length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_decompress_readbuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_decompress *decompress = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ecr_buffer_t *block = &decompress->block;
+    while(block->position == block->length) {
+        if(decompress->status) {
+            return decompress->status;
+        }
+
+        // errors leave the source in an unknown position, so they are permanent
+        decompress->status = ecr_stream_decompress_block(decompress);
+    }
+
+    if(length > block->length - block->position) {
+        length = block->length - block->position;
+    }
+
+    memcpy(buffer->memory + buffer->position, block->memory + block->position, length);
+    block->position += length;
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_decompress_writebuf(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_decompress_close(void *data) {
+    struct ecr_stream_decompress *decompress = data;
+
+    ecr_status_t status = ECR_SUCCESS;
+    if(decompress->block.memory != NULL) {
+        status = ecr_buffer_free(&decompress->input, decompress->allocator);
+
+        ecr_status_t free_status = ecr_buffer_free(&decompress->block, decompress->allocator);
+        if(!status) {
+            status = free_status;
+        }
+    }
+
+    ecr_status_t free_status = ecr_free(decompress->allocator, decompress);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_decompress_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_decompress_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_decompress(ecr_stream_t *stream, ecr_stream_t *source, ecr_allocator_t *allocator) {
+    struct ecr_stream_decompress *decompress;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &decompress, sizeof(*decompress)));
+
+    decompress->source = source;
+    decompress->allocator = allocator;
+    decompress->status = ECR_SUCCESS;
+    decompress->block = (ecr_buffer_t) { 0 };
+    decompress->input = (ecr_buffer_t) { 0 };
+
+    stream->version = 0;
+    stream->data = decompress;
+
+    stream->readbuf  = ecr_stream_decompress_readbuf;
+    stream->writebuf = ecr_stream_decompress_writebuf;
+    stream->close    = ecr_stream_decompress_close;
+    stream->getpos   = ecr_stream_decompress_getpos;
+    stream->setpos   = ecr_stream_decompress_setpos;
+    return ECR_SUCCESS;
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdckdint.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/uio.h>
+
+#include "ecr/allocator.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/concurrent.h"
+
+#include "futex.h"
+#include "posix.h"
+
+#define CACHE_LINE_SIZE 64
+#define BATCH_MAX IOV_MAX
+
+enum {
+    CONSUMER_RUNNING  = 0,
+    CONSUMER_SLEEPING = 1,
+};
+
+struct ecr_stream_concurrent_record {
+    _Atomic(struct ecr_stream_concurrent_record *) next;
+    size_t length;
+    unsigned char memory[];
+};
+
+struct ecr_stream_concurrent {
+    ecr_stream_t *sink;
+    ecr_allocator_t *allocator;
+    pthread_t consumer;
+
+    _Atomic(struct ecr_stream_concurrent_record *) head;
+    char head_padding[CACHE_LINE_SIZE - sizeof(void *)];
+
+    _Atomic uint32_t consumer_state;
+    atomic_bool closing;
+    _Atomic ecr_status_t status;
+    char state_padding[CACHE_LINE_SIZE];
+
+    struct ecr_stream_concurrent_record *tail;
+    struct ecr_stream_concurrent_record stub;
+};
+
+static void ecr_stream_concurrent_push(struct ecr_stream_concurrent *concurrent, struct ecr_stream_concurrent_record *record) {
+    atomic_store_explicit(&record->next, NULL, memory_order_relaxed);
+
+    struct ecr_stream_concurrent_record *previous = atomic_exchange(&concurrent->head, record);
+    atomic_store_explicit(&previous->next, record, memory_order_release);
+}
+
+static struct ecr_stream_concurrent_record * ecr_stream_concurrent_pop(struct ecr_stream_concurrent *concurrent) {
+    struct ecr_stream_concurrent_record *tail = concurrent->tail;
+    struct ecr_stream_concurrent_record *next = atomic_load_explicit(&tail->next, memory_order_acquire);
+
+    if(tail == &concurrent->stub) {
+        if(!next) {
+            return NULL;
+        }
+
+        concurrent->tail = next;
+        tail = next;
+        next = atomic_load_explicit(&next->next, memory_order_acquire);
+    }
+
+    if(next) {
+        concurrent->tail = next;
+        return tail;
+    }
+
+    if(tail != atomic_load(&concurrent->head)) {
+        return NULL;
+    }
+
+    ecr_stream_concurrent_push(concurrent, &concurrent->stub);
+
+    next = atomic_load_explicit(&tail->next, memory_order_acquire);
+    if(next) {
+        concurrent->tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+static void ecr_stream_concurrent_wake(struct ecr_stream_concurrent *concurrent) {
+    if(atomic_load(&concurrent->consumer_state) == CONSUMER_SLEEPING
+            && atomic_exchange(&concurrent->consumer_state, CONSUMER_RUNNING) == CONSUMER_SLEEPING) {
+        ecr_futex_wake(&concurrent->consumer_state, 1, false);
+    }
+}
+
+static void ecr_stream_concurrent_drain(struct ecr_stream_concurrent *concurrent, struct ecr_stream_concurrent_record **batch, int count) {
+    ecr_status_t status = ECR_SUCCESS;
+
+    int fd;
+    bool is_fd = ecr_stream_get_fd(concurrent->sink, &fd);
+    if(is_fd || ecr_stream_is_socket(concurrent->sink)) {
+        struct iovec iov[BATCH_MAX];
+        for(int i = 0; i < count; i++) {
+            iov[i].iov_base = batch[i]->memory;
+            iov[i].iov_len  = batch[i]->length;
+        }
+
+        if(is_fd) {
+            status = ecr_fd_writev_full(fd, iov, count);
+        } else {
+            status = ecr_stream_socket_writev_full(concurrent->sink, iov, count);
+        }
+    } else {
+        for(int i = 0; i < count && !status; i++) {
+            ecr_buffer_t buffer = {
+                .memory   = batch[i]->memory,
+                .capacity = batch[i]->length,
+                .position = 0,
+                .length   = batch[i]->length,
+            };
+
+            status = ecr_stream_writebuf_full(concurrent->sink, &buffer);
+        }
+    }
+
+    if(status) {
+        ecr_status_t expected = ECR_SUCCESS;
+        atomic_compare_exchange_strong(&concurrent->status, &expected, status);
+    }
+
+    for(int i = 0; i < count; i++) {
+        ecr_free(concurrent->allocator, batch[i]);
+    }
+}
+
+static void * ecr_stream_concurrent_consume(void *data) {
+    struct ecr_stream_concurrent *concurrent = data;
+    struct ecr_stream_concurrent_record *batch[BATCH_MAX];
+
+    while(true) {
+        int count = 0;
+        while(count < BATCH_MAX) {
+            struct ecr_stream_concurrent_record *record = ecr_stream_concurrent_pop(concurrent);
+            if(!record) {
+                break;
+            }
+
+            batch[count++] = record;
+        }
+
+        if(count > 0) {
+            ecr_stream_concurrent_drain(concurrent, batch, count);
+            continue;
+        }
+
+        if(atomic_load(&concurrent->head) != concurrent->tail) {
+            // a producer is midway through appending a record
+            sched_yield();
+            continue;
+        }
+
+        if(atomic_load(&concurrent->closing)) {
+            break;
+        }
+
+        atomic_store(&concurrent->consumer_state, CONSUMER_SLEEPING);
+        if(atomic_load(&concurrent->head) == concurrent->tail && !atomic_load(&concurrent->closing)) {
+            ecr_futex_wait(&concurrent->consumer_state, CONSUMER_SLEEPING, NULL, false);
+        }
+        atomic_store(&concurrent->consumer_state, CONSUMER_RUNNING);
+    }
+
+    return NULL;
+}
+
+static ecr_status_t ecr_stream_concurrent_readbuf(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_concurrent_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_concurrent *concurrent = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ECR_STATUS_GUARD(atomic_load_explicit(&concurrent->status, memory_order_relaxed));
+
+    size_t size;
+    if(ckd_add(&size, sizeof(struct ecr_stream_concurrent_record), length)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    struct ecr_stream_concurrent_record *record;
+    ECR_STATUS_GUARD(ecr_allocate(concurrent->allocator, (void **) &record, size));
+
+    record->length = length;
+    memcpy(record->memory, buffer->memory + buffer->position, length);
+
+    ecr_stream_concurrent_push(concurrent, record);
+    ecr_stream_concurrent_wake(concurrent);
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_concurrent_close(void *data) {
+    struct ecr_stream_concurrent *concurrent = data;
+
+    atomic_store(&concurrent->closing, true);
+    atomic_store(&concurrent->consumer_state, CONSUMER_RUNNING);
+    ecr_futex_wake(&concurrent->consumer_state, 1, false);
+
+    int error = pthread_join(concurrent->consumer, NULL);
+    if(error) {
+        errno = error;
+        return ecr_get_system_error();
+    }
+
+    ecr_status_t status = atomic_load(&concurrent->status);
+    ecr_status_t free_status = ecr_free(concurrent->allocator, concurrent);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_concurrent_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_concurrent_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_concurrent(ecr_stream_t *stream, ecr_stream_t *sink, ecr_allocator_t *allocator) {
+    struct ecr_stream_concurrent *concurrent;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &concurrent, sizeof(*concurrent)));
+
+    concurrent->sink = sink;
+    concurrent->allocator = allocator;
+
+    atomic_init(&concurrent->stub.next, NULL);
+    atomic_init(&concurrent->head, &concurrent->stub);
+    concurrent->tail = &concurrent->stub;
+
+    atomic_init(&concurrent->consumer_state, CONSUMER_RUNNING);
+    atomic_init(&concurrent->closing, false);
+    atomic_init(&concurrent->status, ECR_SUCCESS);
+
+    int error = pthread_create(&concurrent->consumer, NULL, ecr_stream_concurrent_consume, concurrent);
+    if(error) {
+        ecr_free(allocator, concurrent);
+
+        errno = error;
+        return ecr_get_system_error();
+    }
+
+    stream->version = 0;
+    stream->data = concurrent;
+
+    stream->readbuf  = ecr_stream_concurrent_readbuf;
+    stream->writebuf = ecr_stream_concurrent_writebuf;
+    stream->close    = ecr_stream_concurrent_close;
+    stream->getpos   = ecr_stream_concurrent_getpos;
+    stream->setpos   = ecr_stream_concurrent_setpos;
+    return ECR_SUCCESS;
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/buffered.h"
+#include "ecr/stream/csv.h"
+
+#define BLOCK_SIZE 64
+
+struct ecr_csv_scan {
+    unsigned char delimiter;
+    bool quoting;
+
+    // field ends are recorded as offsets in the fields' lengths until the whole record is buffered
+    ecr_csv_field_t *fields;
+    size_t max_fields;
+
+    size_t offset, count;
+    uint64_t quoted;
+    bool found;
+    size_t end;
+};
+
+static void ecr_csv_classify(const unsigned char *block, unsigned char delimiter, uint64_t *quotes, uint64_t *delimiters, uint64_t *newlines) {
+    *quotes = *delimiters = *newlines = 0;
+
+#if defined(__SSE2__)
+    const __m128i quote_byte = _mm_set1_epi8('"');
+    const __m128i delimiter_byte = _mm_set1_epi8(delimiter);
+    const __m128i newline_byte = _mm_set1_epi8('\n');
+
+    for(size_t i = 0; i < BLOCK_SIZE; i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *) (block + i));
+        *quotes     |= (uint64_t) (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote_byte)) << i;
+        *delimiters |= (uint64_t) (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, delimiter_byte)) << i;
+        *newlines   |= (uint64_t) (uint16_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline_byte)) << i;
+    }
+#else
+    for(size_t i = 0; i < BLOCK_SIZE; i++) {
+        *quotes     |= (uint64_t) (block[i] == '"') << i;
+        *delimiters |= (uint64_t) (block[i] == delimiter) << i;
+        *newlines   |= (uint64_t) (block[i] == '\n') << i;
+    }
+#endif
+}
+
+// each bit becomes the parity of the bits up to and including it, so that the bytes from an opening quote up to its closing one are set
+static uint64_t ecr_csv_prefix_xor(uint64_t bits) {
+    for(size_t shift = 1; shift < 64; shift <<= 1) {
+        bits ^= bits << shift;
+    }
+    return bits;
+}
+
+// scans up to one block of a record, returning whether its end was found
+static bool ecr_csv_scan_block(struct ecr_csv_scan *scan, const unsigned char *memory, size_t size) {
+    const unsigned char *block = memory + scan->offset;
+
+    unsigned char padded[BLOCK_SIZE];
+    if(size < BLOCK_SIZE) {
+        memset(padded, 0, sizeof(padded));
+        memcpy(padded, block, size);
+        block = padded;
+    }
+
+    uint64_t quotes, delimiters, newlines;
+    ecr_csv_classify(block, scan->delimiter, &quotes, &delimiters, &newlines);
+
+    uint64_t valid = size < BLOCK_SIZE ? (UINT64_C(1) << size) - 1 : UINT64_MAX;
+    if(!scan->quoting) {
+        quotes = 0;
+    }
+
+    uint64_t inside = ecr_csv_prefix_xor(quotes & valid) ^ scan->quoted;
+    uint64_t structural = (delimiters | newlines) & valid & ~inside;
+
+    for(; structural; structural &= structural - 1) {
+        size_t bit = __builtin_ctzll(structural);
+
+        if(scan->count < scan->max_fields) {
+            scan->fields[scan->count].length = scan->offset + bit;
+        }
+        scan->count++;
+
+        if(newlines & (UINT64_C(1) << bit)) {
+            scan->found = true;
+            scan->end = scan->offset + bit;
+            return true;
+        }
+    }
+
+    scan->quoted = -(inside >> 63);
+    scan->offset += size;
+    return false;
+}
+
+// turns the recorded field ends into views of the fields
+static void ecr_csv_finish(struct ecr_csv_scan *scan, const char *memory) {
+    size_t start = 0;
+    for(size_t i = 0; i < scan->count; i++) {
+        ecr_csv_field_t *field = &scan->fields[i];
+        size_t end = field->length;
+
+        field->memory = memory + start;
+        field->length = end - start;
+        field->escaped = false;
+
+        if(i == scan->count - 1 && field->length > 0 && field->memory[field->length - 1] == '\r') {
+            field->length--;
+        }
+
+        if(scan->quoting && field->length >= 2 && field->memory[0] == '"' && field->memory[field->length - 1] == '"') {
+            field->memory++;
+            field->length -= 2;
+            field->escaped = memchr(field->memory, '"', field->length) != NULL;
+        }
+
+        start = end + 1;
+    }
+}
+
+ecr_status_t ecr_stream_read_csv(ecr_stream_t *stream, unsigned char delimiter, bool quoting, size_t max_length, ecr_csv_field_t *fields, size_t max_fields, size_t *count) {
+    const unsigned char *memory;
+    size_t available;
+    ECR_STATUS_GUARD(ecr_stream_buffered_fill(stream, 1, (const void **) &memory, &available));
+
+    struct ecr_csv_scan scan = {
+        .delimiter  = delimiter,
+        .quoting    = quoting,
+        .fields     = fields,
+        .max_fields = max_fields,
+    };
+
+    while(true) {
+        while(!scan.found && scan.offset + BLOCK_SIZE <= available) {
+            ecr_csv_scan_block(&scan, memory, BLOCK_SIZE);
+        }
+
+        if(!scan.found && scan.offset < available) {
+            // the rest of the buffered data may be scanned again once more of it is read, so keep the progress up to here
+            struct ecr_csv_scan tail = scan;
+            if(ecr_csv_scan_block(&tail, memory, available - scan.offset)) {
+                scan = tail;
+            }
+        }
+
+        if(scan.found) {
+            break;
+        }
+        if(scan.offset >= max_length) {
+            return ECR_ERROR_FULL_BUFFER;
+        }
+
+        ecr_status_t status = ecr_stream_buffered_fill(stream, available + 1, (const void **) &memory, &available);
+        if(status == ECR_ERROR_EOF) {
+            // the last record may lack a line ending
+            struct ecr_csv_scan tail = scan;
+            if(available > scan.offset) {
+                ecr_csv_scan_block(&tail, memory, available - scan.offset);
+            }
+            if(tail.quoted) {
+                return ECR_ERROR_INVALID_DATA;
+            }
+
+            scan = tail;
+            if(scan.count < scan.max_fields) {
+                scan.fields[scan.count].length = available;
+            }
+            scan.count++;
+            scan.end = available;
+            break;
+        }
+        ECR_STATUS_GUARD(status);
+    }
+
+    size_t length = scan.end + scan.found;
+    if(length > max_length || scan.count > max_fields) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ecr_csv_finish(&scan, (const char *) memory);
+    ECR_STATUS_GUARD(ecr_stream_buffered_consume(stream, length));
+
+    *count = scan.count;
+    return ECR_SUCCESS;
+}
+
+size_t ecr_csv_unescape(const ecr_csv_field_t *field, char *out) {
+    const char *in = field->memory, *end = field->memory + field->length;
+    char *start = out;
+
+    while(in < end) {
+        const char *quote = memchr(in, '"', end - in);
+        size_t length = (quote ? quote + 1 : end) - in;
+
+        memcpy(out, in, length);
+        out += length;
+        in += length;
+
+        if(quote && in < end && *in == '"') {
+            in++;
+        }
+    }
+
+    return out - start;
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdckdint.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "ecr/allocator.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/durable.h"
+
+#include "posix.h"
+
+struct ecr_stream_durable_record {
+    struct ecr_stream_durable_record *next;
+    const void *memory;
+    size_t length;
+    bool owned;
+};
+
+struct ecr_stream_durable {
+    int fd;
+    ecr_allocator_t *allocator;
+
+    pthread_mutex_t lock;
+    pthread_cond_t committed;
+
+    struct ecr_stream_durable_record *pending, **pending_tail;
+    ecr_stream_durable_ticket_t submitted, durable;
+    bool committing;
+    ecr_status_t status;
+};
+
+static ecr_status_t ecr_stream_durable_append(struct ecr_stream_durable *durable, struct ecr_stream_durable_record *records) {
+    struct iovec iov[IOV_MAX];
+    while(records) {
+        int count = 0;
+        for(; records && count < IOV_MAX; records = records->next) {
+            iov[count].iov_base = (void *) records->memory;
+            iov[count].iov_len  = records->length;
+            count++;
+        }
+
+        ECR_STATUS_GUARD(ecr_fd_writev_full(durable->fd, iov, count));
+    }
+
+    if(fdatasync(durable->fd)) {
+        return ecr_get_system_error();
+    }
+
+    return ECR_SUCCESS;
+}
+
+static void ecr_stream_durable_enqueue(struct ecr_stream_durable *durable, struct ecr_stream_durable_record *record, ecr_stream_durable_ticket_t *ticket) {
+    record->next = NULL;
+    *durable->pending_tail = record;
+    durable->pending_tail = &record->next;
+
+    *ticket = ++durable->submitted;
+}
+
+static void ecr_stream_durable_dequeue(struct ecr_stream_durable *durable, struct ecr_stream_durable_record *record) {
+    struct ecr_stream_durable_record **link = &durable->pending;
+    while(*link && *link != record) {
+        link = &(*link)->next;
+    }
+    if(!*link) {
+        return;
+    }
+
+    *link = record->next;
+    if(durable->pending_tail == &record->next) {
+        durable->pending_tail = link;
+    }
+}
+
+static ecr_status_t ecr_stream_durable_commit_until(struct ecr_stream_durable *durable, ecr_stream_durable_ticket_t ticket) {
+    while(durable->durable < ticket && !durable->status) {
+        if(durable->committing) {
+            pthread_cond_wait(&durable->committed, &durable->lock);
+            continue;
+        }
+
+        struct ecr_stream_durable_record *records = durable->pending;
+        ecr_stream_durable_ticket_t last = durable->submitted;
+
+        durable->pending = NULL;
+        durable->pending_tail = &durable->pending;
+        durable->committing = true;
+        pthread_mutex_unlock(&durable->lock);
+
+        ecr_status_t status = ecr_stream_durable_append(durable, records);
+        while(records) {
+            struct ecr_stream_durable_record *next = records->next;
+            if(records->owned) {
+                ecr_free(durable->allocator, records);
+            }
+            records = next;
+        }
+
+        pthread_mutex_lock(&durable->lock);
+        durable->committing = false;
+        if(status) {
+            durable->status = status;
+        } else {
+            durable->durable = last;
+        }
+        pthread_cond_broadcast(&durable->committed);
+    }
+
+    if(durable->durable >= ticket) {
+        return ECR_SUCCESS;
+    }
+
+    return durable->status;
+}
+
+static ecr_status_t ecr_stream_durable_readbuf(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_durable_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_durable *durable = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    struct ecr_stream_durable_record record = {
+        .memory = buffer->memory + buffer->position,
+        .length = length,
+        .owned  = false,
+    };
+
+    pthread_mutex_lock(&durable->lock);
+
+    ecr_status_t status = durable->status;
+    if(!status) {
+        ecr_stream_durable_ticket_t ticket;
+        ecr_stream_durable_enqueue(durable, &record, &ticket);
+
+        status = ecr_stream_durable_commit_until(durable, ticket);
+        if(status) {
+            // another thread's commit failed before taking the record, which lives on this stack frame
+            ecr_stream_durable_dequeue(durable, &record);
+        }
+    }
+
+    pthread_mutex_unlock(&durable->lock);
+
+    ECR_STATUS_GUARD(status);
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_durable_close(void *data) {
+    struct ecr_stream_durable *durable = data;
+
+    pthread_mutex_lock(&durable->lock);
+    ecr_status_t status = ecr_stream_durable_commit_until(durable, durable->submitted);
+    pthread_mutex_unlock(&durable->lock);
+
+    while(durable->pending) {
+        struct ecr_stream_durable_record *next = durable->pending->next;
+        if(durable->pending->owned) {
+            ecr_free(durable->allocator, durable->pending);
+        }
+        durable->pending = next;
+    }
+
+    pthread_cond_destroy(&durable->committed);
+    pthread_mutex_destroy(&durable->lock);
+
+    ecr_status_t free_status = ecr_free(durable->allocator, durable);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_durable_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_durable_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_durable(ecr_stream_t *stream, ecr_stream_t *file, ecr_allocator_t *allocator) {
+    int fd;
+    if(!ecr_stream_get_fd(file, &fd)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    int flags = fcntl(fd, F_GETFL);
+    if(flags < 0) {
+        return ecr_get_system_error();
+    }
+    if(!(flags & O_APPEND)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_durable *durable;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &durable, sizeof(*durable)));
+
+    durable->fd = fd;
+    durable->allocator = allocator;
+    durable->pending = NULL;
+    durable->pending_tail = &durable->pending;
+    durable->submitted = 0;
+    durable->durable = 0;
+    durable->committing = false;
+    durable->status = ECR_SUCCESS;
+
+    pthread_mutex_init(&durable->lock, NULL);
+    pthread_cond_init(&durable->committed, NULL);
+
+    stream->version = 0;
+    stream->data = durable;
+
+    stream->readbuf  = ecr_stream_durable_readbuf;
+    stream->writebuf = ecr_stream_durable_writebuf;
+    stream->close    = ecr_stream_durable_close;
+    stream->getpos   = ecr_stream_durable_getpos;
+    stream->setpos   = ecr_stream_durable_setpos;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_durable_submit(ecr_stream_t *stream, ecr_buffer_t *restrict buffer, ecr_stream_durable_ticket_t *ticket) {
+    if(stream->close != ecr_stream_durable_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_durable *durable = stream->data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    size_t size;
+    if(ckd_add(&size, sizeof(struct ecr_stream_durable_record), length)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    struct ecr_stream_durable_record *record;
+    ECR_STATUS_GUARD(ecr_allocate(durable->allocator, (void **) &record, size));
+
+    memcpy(record + 1, buffer->memory + buffer->position, length);
+    record->memory = record + 1;
+    record->length = length;
+    record->owned  = true;
+
+    pthread_mutex_lock(&durable->lock);
+
+    ecr_status_t status = durable->status;
+    if(!status) {
+        ecr_stream_durable_enqueue(durable, record, ticket);
+    }
+
+    pthread_mutex_unlock(&durable->lock);
+
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(status, { ecr_free(durable->allocator, record); });
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_durable_wait(ecr_stream_t *stream, ecr_stream_durable_ticket_t ticket) {
+    if(stream->close != ecr_stream_durable_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_durable *durable = stream->data;
+
+    pthread_mutex_lock(&durable->lock);
+    ecr_status_t status = ecr_stream_durable_commit_until(durable, ticket);
+    pthread_mutex_unlock(&durable->lock);
+
+    return status;
+}
@@ -0,0 +1,540 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include <pthread.h>
+
+#if defined(__x86_64__)
+#include <tmmintrin.h>
+#endif
+
+#include "ecr/allocator.h"
+#include "ecr/buffer.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/encoding.h"
+
+#define ENCODE_BUFFER_SIZE 16384
+#define DECODE_BUFFER_SIZE 16384
+
+#define INVALID 0xFF
+
+struct ecr_stream_encode {
+    ecr_stream_t *sink;
+    ecr_allocator_t *allocator;
+    ecr_encoding_t encoding;
+
+    unsigned char pending[3];
+    size_t pending_length;
+
+    unsigned char output[ENCODE_BUFFER_SIZE];
+};
+
+struct ecr_stream_decode {
+    ecr_stream_t *source;
+    ecr_allocator_t *allocator;
+    ecr_encoding_t encoding;
+    ecr_status_t status;
+    bool finished;
+
+    unsigned char carry[3];
+    size_t carry_position, carry_length;
+
+    size_t input_position, input_length;
+    unsigned char input[DECODE_BUFFER_SIZE];
+};
+
+typedef void ecr_encode_fn_t(const unsigned char *in, size_t length, unsigned char *out);
+typedef bool ecr_decode_fn_t(const unsigned char *in, size_t length, unsigned char *out);
+
+static const char hex_digits[] = "0123456789abcdef";
+static const char base64_digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static unsigned char hex_values[256];
+static unsigned char base64_values[256];
+
+static ecr_encode_fn_t *hex_encode;
+static ecr_decode_fn_t *hex_decode;
+static ecr_encode_fn_t *base64_encode;
+static pthread_once_t kernels_once = PTHREAD_ONCE_INIT;
+
+static void hex_encode_scalar(const unsigned char *in, size_t length, unsigned char *out) {
+    for(size_t i = 0; i < length; i++) {
+        out[2 * i]     = hex_digits[in[i] >> 4];
+        out[2 * i + 1] = hex_digits[in[i] & 0xF];
+    }
+}
+
+// decodes **length** pairs of digits
+static bool hex_decode_scalar(const unsigned char *in, size_t length, unsigned char *out) {
+    unsigned char invalid = 0;
+    for(size_t i = 0; i < length; i++) {
+        unsigned char high = hex_values[in[2 * i]], low = hex_values[in[2 * i + 1]];
+        invalid |= high | low;
+        out[i] = high << 4 | low;
+    }
+
+    return !(invalid & 0x80);
+}
+
+// encodes **length** bytes, which must be a multiple of 3
+static void base64_encode_scalar(const unsigned char *in, size_t length, unsigned char *out) {
+    for(; length >= 3; length -= 3) {
+        uint32_t group = (uint32_t) in[0] << 16 | (uint32_t) in[1] << 8 | in[2];
+        out[0] = base64_digits[group >> 18];
+        out[1] = base64_digits[(group >> 12) & 0x3F];
+        out[2] = base64_digits[(group >> 6) & 0x3F];
+        out[3] = base64_digits[group & 0x3F];
+
+        in += 3;
+        out += 4;
+    }
+}
+
+#if defined(__x86_64__)
+[[gnu::target("ssse3")]]
+static void hex_encode_ssse3(const unsigned char *in, size_t length, unsigned char *out) {
+    const __m128i digits = _mm_loadu_si128((const __m128i *) hex_digits);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+
+    for(; length >= 16; length -= 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *) in);
+        __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble));
+        __m128i low  = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, nibble));
+
+        _mm_storeu_si128((__m128i *) out, _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i *) (out + 16), _mm_unpackhi_epi8(high, low));
+
+        in += 16;
+        out += 32;
+    }
+
+    hex_encode_scalar(in, length, out);
+}
+
+[[gnu::target("ssse3")]]
+static __m128i hex_values_ssse3(__m128i chars, __m128i *valid) {
+    __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+
+    // unsigned range checks: x <= n exactly when min(x, n) == x
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+    *valid = _mm_and_si128(*valid, _mm_or_si128(is_digit, is_letter));
+    return _mm_or_si128(_mm_and_si128(is_digit, digit), _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+[[gnu::target("ssse3")]]
+static bool hex_decode_ssse3(const unsigned char *in, size_t length, unsigned char *out) {
+    // multiplies each even (high) digit by 16 and adds the following odd (low) digit to it
+    const __m128i weights = _mm_set1_epi16(0x0110);
+
+    __m128i valid = _mm_set1_epi8(-1);
+    for(; length >= 16; length -= 16) {
+        __m128i first = hex_values_ssse3(_mm_loadu_si128((const __m128i *) in), &valid);
+        __m128i second = hex_values_ssse3(_mm_loadu_si128((const __m128i *) (in + 16)), &valid);
+
+        __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+        _mm_storeu_si128((__m128i *) out, bytes);
+
+        in += 32;
+        out += 16;
+    }
+
+    if(_mm_movemask_epi8(valid) != 0xFFFF) {
+        return false;
+    }
+
+    return hex_decode_scalar(in, length, out);
+}
+
+[[gnu::target("ssse3")]]
+static void base64_encode_ssse3(const unsigned char *in, size_t length, unsigned char *out) {
+    // each step loads 16 bytes and encodes the first 12 of them
+    for(; length >= 16; length -= 12) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *) in);
+        bytes = _mm_shuffle_epi8(bytes, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+        // split each 24-bit group into four 6-bit indices, one per byte
+        __m128i high = _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        __m128i low = _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(high, low);
+
+        // map each index range (A-Z, a-z, 0-9, +, /) to the offset added to it
+        __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+
+        const __m128i offsets = _mm_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+        );
+        _mm_storeu_si128((__m128i *) out, _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, range)));
+
+        in += 12;
+        out += 16;
+    }
+
+    base64_encode_scalar(in, length, out);
+}
+#endif
+
+static void ecr_encoding_init() {
+    memset(hex_values, INVALID, sizeof(hex_values));
+    for(int i = 0; i < 16; i++) {
+        hex_values[(unsigned char) hex_digits[i]] = i;
+        if(i >= 10) {
+            hex_values[(unsigned char) hex_digits[i] - 'a' + 'A'] = i;
+        }
+    }
+
+    memset(base64_values, INVALID, sizeof(base64_values));
+    for(int i = 0; i < 64; i++) {
+        base64_values[(unsigned char) base64_digits[i]] = i;
+    }
+
+    hex_encode = hex_encode_scalar;
+    hex_decode = hex_decode_scalar;
+    base64_encode = base64_encode_scalar;
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("ssse3")) {
+        hex_encode = hex_encode_ssse3;
+        hex_decode = hex_decode_ssse3;
+        base64_encode = base64_encode_ssse3;
+    }
+#endif
+}
+
+// decodes **count** groups of 4 characters, of which only the last one may contain padding
+static bool base64_decode(const unsigned char *in, size_t count, unsigned char *out, size_t *length, bool *finished) {
+    unsigned char *out_start = out;
+
+    for(; count > 0; count--) {
+        if(*finished) {
+            return false;
+        }
+
+        unsigned char a = base64_values[in[0]], b = base64_values[in[1]], c = base64_values[in[2]], d = base64_values[in[3]];
+        if((a | b | c | d) & 0x80) {
+            if((a | b) & 0x80 || in[3] != '=') {
+                return false;
+            }
+
+            *out++ = a << 2 | b >> 4;
+            if(in[2] != '=') {
+                if(c & 0x80) {
+                    return false;
+                }
+                *out++ = b << 4 | c >> 2;
+            }
+
+            *finished = true;
+        } else {
+            *out++ = a << 2 | b >> 4;
+            *out++ = b << 4 | c >> 2;
+            *out++ = c << 6 | d;
+        }
+
+        in += 4;
+    }
+
+    *length = out - out_start;
+    return true;
+}
+
+static size_t ecr_encoding_group_bytes(ecr_encoding_t encoding) {
+    return encoding == ECR_ENCODING_BASE64 ? 3 : 1;
+}
+
+static size_t ecr_encoding_group_chars(ecr_encoding_t encoding) {
+    return encoding == ECR_ENCODING_BASE64 ? 4 : 2;
+}
+
+static ecr_status_t ecr_stream_encode_readbuf(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_encode_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_encode *encode = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    const unsigned char *in = buffer->memory + buffer->position;
+    if(encode->encoding == ECR_ENCODING_HEX) {
+        if(length > ENCODE_BUFFER_SIZE / 2) {
+            length = ENCODE_BUFFER_SIZE / 2;
+        }
+
+        hex_encode(in, length, encode->output);
+
+        size_t output_length = length * 2;
+        ECR_STATUS_GUARD(ecr_stream_write_full(encode->sink, encode->output, &output_length));
+
+        buffer->position += length;
+        return ECR_SUCCESS;
+    }
+
+    size_t consumed = 0, output_length = 0;
+    if(encode->pending_length > 0) {
+        size_t missing = 3 - encode->pending_length;
+        if(length < missing) {
+            memcpy(encode->pending + encode->pending_length, in, length);
+            encode->pending_length += length;
+
+            buffer->position += length;
+            return ECR_SUCCESS;
+        }
+
+        unsigned char group[3];
+        memcpy(group, encode->pending, encode->pending_length);
+        memcpy(group + encode->pending_length, in, missing);
+        base64_encode(group, 3, encode->output);
+
+        consumed = missing;
+        output_length = 4;
+    }
+
+    size_t groups = (length - consumed) / 3;
+    if(groups > (ENCODE_BUFFER_SIZE - output_length) / 4) {
+        groups = (ENCODE_BUFFER_SIZE - output_length) / 4;
+    }
+
+    base64_encode(in + consumed, groups * 3, encode->output + output_length);
+    consumed += groups * 3;
+    output_length += groups * 4;
+
+    if(output_length > 0) {
+        ECR_STATUS_GUARD(ecr_stream_write_full(encode->sink, encode->output, &output_length));
+    }
+
+    encode->pending_length = 0;
+    if(length - consumed < 3) {
+        encode->pending_length = length - consumed;
+        memcpy(encode->pending, in + consumed, encode->pending_length);
+        consumed = length;
+    }
+
+    buffer->position += consumed;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_encode_close(void *data) {
+    struct ecr_stream_encode *encode = data;
+
+    ecr_status_t status = ECR_SUCCESS;
+    if(encode->pending_length > 0) {
+        unsigned char group[3] = { 0 };
+        memcpy(group, encode->pending, encode->pending_length);
+        base64_encode_scalar(group, 3, encode->output);
+
+        encode->output[3] = '=';
+        if(encode->pending_length == 1) {
+            encode->output[2] = '=';
+        }
+
+        size_t output_length = 4;
+        status = ecr_stream_write_full(encode->sink, encode->output, &output_length);
+    }
+
+    ecr_status_t free_status = ecr_free(encode->allocator, encode);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_encode_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_encode_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_encode(ecr_stream_t *stream, ecr_stream_t *sink, ecr_encoding_t encoding, ecr_allocator_t *allocator) {
+    if(encoding != ECR_ENCODING_HEX && encoding != ECR_ENCODING_BASE64) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    pthread_once(&kernels_once, ecr_encoding_init);
+
+    struct ecr_stream_encode *encode;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &encode, sizeof(*encode)));
+
+    encode->sink = sink;
+    encode->allocator = allocator;
+    encode->encoding = encoding;
+    encode->pending_length = 0;
+
+    stream->version = 0;
+    stream->data = encode;
+
+    stream->readbuf  = ecr_stream_encode_readbuf;
+    stream->writebuf = ecr_stream_encode_writebuf;
+    stream->close    = ecr_stream_encode_close;
+    stream->getpos   = ecr_stream_encode_getpos;
+    stream->setpos   = ecr_stream_encode_setpos;
+    return ECR_SUCCESS;
+}
+
+static bool ecr_stream_decode_groups(struct ecr_stream_decode *decode, const unsigned char *in, size_t count, unsigned char *out, size_t *length) {
+    if(decode->encoding == ECR_ENCODING_HEX) {
+        *length = count;
+        return hex_decode(in, count, out);
+    }
+
+    return base64_decode(in, count, out, length, &decode->finished);
+}
+
+static ecr_status_t ecr_stream_decode_readbuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_decode *decode = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    if(decode->carry_position < decode->carry_length) {
+        if(length > decode->carry_length - decode->carry_position) {
+            length = decode->carry_length - decode->carry_position;
+        }
+
+        memcpy(buffer->memory + buffer->position, decode->carry + decode->carry_position, length);
+        decode->carry_position += length;
+
+        buffer->position += length;
+        return ECR_SUCCESS;
+    }
+
+    size_t group_bytes = ecr_encoding_group_bytes(decode->encoding);
+    size_t group_chars = ecr_encoding_group_chars(decode->encoding);
+
+    while(true) {
+        size_t available = decode->input_length - decode->input_position;
+        if(available >= group_chars) {
+            break;
+        }
+
+        if(decode->status) {
+            return decode->status == ECR_ERROR_EOF && available > 0 ? ECR_ERROR_INVALID_DATA : decode->status;
+        }
+
+        memmove(decode->input, decode->input + decode->input_position, available);
+        decode->input_position = 0;
+
+        ecr_buffer_t input = {
+            .memory = decode->input,
+            .capacity = DECODE_BUFFER_SIZE,
+            .position = available,
+            .length = DECODE_BUFFER_SIZE,
+        };
+        ecr_status_t status = ecr_stream_readbuf(decode->source, &input);
+        decode->input_length = input.position;
+
+        if(status == ECR_ERROR_EOF) {
+            decode->status = status;
+        } else if(status) {
+            return status;
+        }
+    }
+
+    if(decode->status == ECR_ERROR_INVALID_DATA) {
+        return decode->status;
+    }
+
+    const unsigned char *in = decode->input + decode->input_position;
+    size_t count = (decode->input_length - decode->input_position) / group_chars;
+
+    bool valid;
+    if(length < group_bytes) {
+        // too little room for a whole group, so decode one and hand it out piece by piece
+        valid = ecr_stream_decode_groups(decode, in, 1, decode->carry, &decode->carry_length);
+        count = 1;
+
+        decode->carry_position = length < decode->carry_length ? length : decode->carry_length;
+        memcpy(buffer->memory + buffer->position, decode->carry, decode->carry_position);
+        length = decode->carry_position;
+    } else {
+        if(count > length / group_bytes) {
+            count = length / group_bytes;
+        }
+
+        valid = ecr_stream_decode_groups(decode, in, count, buffer->memory + buffer->position, &length);
+    }
+
+    if(!valid) {
+        decode->carry_position = decode->carry_length = 0;
+        decode->status = ECR_ERROR_INVALID_DATA;
+        return decode->status;
+    }
+
+    decode->input_position += count * group_chars;
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_decode_writebuf(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_decode_close(void *data) {
+    struct ecr_stream_decode *decode = data;
+    return ecr_free(decode->allocator, decode);
+}
+
+static ecr_status_t ecr_stream_decode_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_decode_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_decode(ecr_stream_t *stream, ecr_stream_t *source, ecr_encoding_t encoding, ecr_allocator_t *allocator) {
+    if(encoding != ECR_ENCODING_HEX && encoding != ECR_ENCODING_BASE64) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    pthread_once(&kernels_once, ecr_encoding_init);
+
+    struct ecr_stream_decode *decode;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &decode, sizeof(*decode)));
+
+    decode->source = source;
+    decode->allocator = allocator;
+    decode->encoding = encoding;
+    decode->status = ECR_SUCCESS;
+    decode->finished = false;
+    decode->carry_position = decode->carry_length = 0;
+    decode->input_position = decode->input_length = 0;
+
+    stream->version = 0;
+    stream->data = decode;
+
+    stream->readbuf  = ecr_stream_decode_readbuf;
+    stream->writebuf = ecr_stream_decode_writebuf;
+    stream->close    = ecr_stream_decode_close;
+    stream->getpos   = ecr_stream_decode_getpos;
+    stream->setpos   = ecr_stream_decode_setpos;
+    return ECR_SUCCESS;
+}
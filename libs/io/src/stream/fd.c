@@ -17,6 +17,7 @@
 #include <limits.h>
 #include <stdckdint.h>
 
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "ecr/error.h"
@@ -144,6 +145,37 @@ void ecr_stream_from_fd_nodup(ecr_stream_t *stream, int fd) {
     stream->setpos   = ecr_stream_fd_setpos;
 }
 
+bool ecr_stream_get_fd(ecr_stream_t *stream, int *fd) {
+    if(stream->readbuf != ecr_stream_fd_readbuf) {
+        return false;
+    }
+
+    *fd = *(int *)(&stream->data);
+    return true;
+}
+
+ecr_status_t ecr_fd_writev_full(int fd, struct iovec *iov, int count) {
+    while(count > 0) {
+        ssize_t write_length = writev(fd, iov, count);
+        if(write_length < 0) {
+            return ecr_get_system_error();
+        }
+
+        size_t length = (size_t) write_length;
+        while(count > 0 && length >= iov->iov_len) {
+            length -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if(count > 0) {
+            iov->iov_base += length;
+            iov->iov_len -= length;
+        }
+    }
+
+    return ECR_SUCCESS;
+}
+
 ecr_status_t ecr_stream_from_fd(ecr_stream_t *stream, int fd) {
     fd = dup(fd);
     if(fd < 0) {
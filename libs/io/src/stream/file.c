@@ -53,6 +53,10 @@ ecr_status_t ecr_stream_open_file(ecr_stream_t *stream, const char *pathname, ec
         fcntl_flags |= O_CREAT;
     }
 
+    if(mode_flags & ECR_FILEMODE_NONBLOCK) {
+        fcntl_flags |= O_NONBLOCK;
+    }
+
     int fd;
     if(fcntl_flags & O_CREAT) {
         fd = open(pathname, fcntl_flags, 0600);
@@ -14,32 +14,120 @@
  * limitations under the License.
  */
 
-#include <limits.h>
-
+#include <errno.h>
 #include <stdio.h>
+#include <stdio_ext.h>
+#include <string.h>
+
+#include <pthread.h>
 
 #include "ecr/error.h"
 #include "ecr/stream.h"
 #include "ecr/stream/formatted.h"
+#include "ecr/stream/number.h"
 
-ecr_status_t ecr_stream_vprintf(ecr_stream_t *stream, const char *format, va_list vlist) {
-    int size = vsnprintf(NULL, 0, format, vlist);
-    if(size < 0) {
-        return ecr_get_system_error();
+#define PRINTER_BUFFER_SIZE 1024
+#define SEGMENT_BUFFER_SIZE 256
+
+/*
+ * Formatting goes through a `FILE` whose writes are forwarded to the target stream,
+ * so that output is formatted once, into a bounded buffer which is flushed in chunks.
+ */
+struct ecr_stream_printer {
+    FILE *file;
+    ecr_stream_t *stream;
+    ecr_status_t status;
+    bool busy;
+
+    char buffer[PRINTER_BUFFER_SIZE];
+};
+
+static thread_local struct ecr_stream_printer thread_printer;
+
+static pthread_key_t printer_key;
+static pthread_once_t printer_key_once = PTHREAD_ONCE_INIT;
+
+static ssize_t ecr_stream_printer_write(void *cookie, const char *memory, size_t length) {
+    struct ecr_stream_printer *printer = cookie;
+
+    size_t written = length;
+    printer->status = ecr_stream_write_full(printer->stream, (void *) memory, &written);
+    if(printer->status) {
+        errno = EIO;
+        return -1;
     }
-    if(size == INT_MAX) {
-        return ECR_ERROR_TYPE_OVERFLOW;
+
+    return length;
+}
+
+static FILE * ecr_stream_printer_open(struct ecr_stream_printer *printer) {
+    FILE *file = fopencookie(printer, "w", (cookie_io_functions_t) { .write = ecr_stream_printer_write });
+    if(!file) {
+        return NULL;
     }
 
-    char buffer[size + 1];
-    int printed = vsnprintf(buffer, sizeof(buffer), format, vlist);
-    if(printed < 0) {
-        return ecr_get_system_error();
+    setvbuf(file, printer->buffer, _IOFBF, sizeof(printer->buffer));
+    return file;
+}
+
+static void ecr_stream_printer_destroy(void *file) {
+    fclose(file);
+}
+
+static void ecr_stream_printer_key_init() {
+    pthread_key_create(&printer_key, ecr_stream_printer_destroy);
+}
+
+static ecr_status_t ecr_stream_printer_print(struct ecr_stream_printer *printer, ecr_stream_t *stream, const char *format, va_list vlist) {
+    printer->stream = stream;
+    printer->status = ECR_SUCCESS;
+
+    ecr_status_t status = ECR_SUCCESS;
+    if(vfprintf(printer->file, format, vlist) < 0 || fflush(printer->file) == EOF) {
+        status = printer->status ? printer->status : ecr_get_system_error();
+
+        // drop whatever could not be written, so that it doesn't end up in the next stream printed to
+        __fpurge(printer->file);
+        clearerr(printer->file);
     }
-    ecr_assert(printed == size);
 
-    size_t length = (size_t) printed;
-    return ecr_stream_write_full(stream, buffer, &length);
+    printer->stream = NULL;
+    return status;
+}
+
+ecr_status_t ecr_stream_vprintf(ecr_stream_t *stream, const char *format, va_list vlist) {
+    struct ecr_stream_printer *printer = &thread_printer;
+
+    if(printer->busy) {
+        // printing from within a stream which is being printed to
+        struct ecr_stream_printer nested = { 0 };
+        nested.file = ecr_stream_printer_open(&nested);
+        if(!nested.file) {
+            return ecr_get_system_error();
+        }
+
+        ecr_status_t status = ecr_stream_printer_print(&nested, stream, format, vlist);
+        fclose(nested.file);
+        return status;
+    }
+
+    if(!printer->file) {
+        pthread_once(&printer_key_once, ecr_stream_printer_key_init);
+
+        printer->file = ecr_stream_printer_open(printer);
+        if(!printer->file) {
+            return ecr_get_system_error();
+        }
+
+        // close the file when the thread exits
+        pthread_setspecific(printer_key, printer->file);
+    }
+
+    printer->busy = true;
+    ecr_status_t status = ecr_stream_printer_print(printer, stream, format, vlist);
+    printer->busy = false;
+
+    return status;
 }
 
 ecr_status_t ecr_stream_printf(ecr_stream_t *stream, const char *format, ...) {
@@ -50,3 +138,71 @@ ecr_status_t ecr_stream_printf(ecr_stream_t *stream, const char *format, ...) {
     va_end(vlist);
     return status;
 }
+
+ecr_status_t ecr_format_segments(ecr_stream_t *stream, const ecr_format_segment_t *segments, size_t count) {
+    char buffer[SEGMENT_BUFFER_SIZE];
+    size_t length = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        const ecr_format_segment_t *segment = &segments[i];
+
+        if(SEGMENT_BUFFER_SIZE - length < ECR_NUMBER_MAX_LENGTH) {
+            ECR_STATUS_GUARD(ecr_stream_write_full(stream, buffer, &length));
+            length = 0;
+        }
+
+        switch(segment->kind) {
+            case ECR_FORMAT_STRING: {
+                size_t string_length = strlen(segment->string);
+                if(string_length <= SEGMENT_BUFFER_SIZE - length) {
+                    memcpy(buffer + length, segment->string, string_length);
+                    length += string_length;
+                    break;
+                }
+
+                // too long to be worth copying
+                if(length > 0) {
+                    ECR_STATUS_GUARD(ecr_stream_write_full(stream, buffer, &length));
+                    length = 0;
+                }
+                ECR_STATUS_GUARD(ecr_stream_write_full(stream, (void *) segment->string, &string_length));
+                break;
+            }
+            case ECR_FORMAT_CHAR:
+                buffer[length++] = segment->character;
+                break;
+            case ECR_FORMAT_INT:
+                length += ecr_format_i64(buffer + length, segment->integer);
+                break;
+            case ECR_FORMAT_UINT:
+                length += ecr_format_u64(buffer + length, segment->unsigned_integer);
+                break;
+            case ECR_FORMAT_FLOAT:
+                length += ecr_format_f64(buffer + length, segment->floating);
+                break;
+            case ECR_FORMAT_BOOL:
+                if(segment->boolean) {
+                    memcpy(buffer + length, "true", 4);
+                    length += 4;
+                } else {
+                    memcpy(buffer + length, "false", 5);
+                    length += 5;
+                }
+                break;
+            case ECR_FORMAT_POINTER:
+                memcpy(buffer + length, "0x", 2);
+                length += 2;
+                length += ecr_format_hex(buffer + length, (uintptr_t) segment->pointer);
+                break;
+
+            default:
+                return ECR_ERROR_INVALID_ARGUMENT;
+        }
+    }
+
+    if(length == 0) {
+        return ECR_SUCCESS;
+    }
+
+    return ecr_stream_write_full(stream, buffer, &length);
+}
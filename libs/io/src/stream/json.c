@@ -0,0 +1,301 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/buffered.h"
+#include "ecr/stream/json.h"
+#include "ecr/stream/number.h"
+
+// longest escape sequence, "\u00XX"
+#define ESCAPE_MAX 6
+
+static const char hex_digits[] = "0123456789abcdef";
+
+static bool ecr_json_needs_escape(unsigned char c) {
+    return c < 0x20 || c == '"' || c == '\\';
+}
+
+static size_t ecr_json_find_escape(const unsigned char *memory, size_t offset, size_t length) {
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+
+    for(; offset + 16 <= length; offset += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *) (memory + offset));
+
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+
+        unsigned mask = _mm_movemask_epi8(special);
+        if(mask) {
+            return offset + __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    for(; offset < length && !ecr_json_needs_escape(memory[offset]); offset++);
+    return offset;
+}
+
+static size_t ecr_json_escape(unsigned char c, char *out) {
+    out[0] = '\\';
+    switch(c) {
+        case '"':  out[1] = '"';  return 2;
+        case '\\': out[1] = '\\'; return 2;
+        case '\b': out[1] = 'b';  return 2;
+        case '\f': out[1] = 'f';  return 2;
+        case '\n': out[1] = 'n';  return 2;
+        case '\r': out[1] = 'r';  return 2;
+        case '\t': out[1] = 't';  return 2;
+    }
+
+    memcpy(out + 1, "u00", 3);
+    out[4] = hex_digits[c >> 4];
+    out[5] = hex_digits[c & 0xF];
+    return 6;
+}
+
+static ecr_status_t ecr_json_put(ecr_stream_t *stream, const void *memory, size_t length) {
+    void *out;
+    size_t space;
+    ECR_STATUS_GUARD(ecr_stream_buffered_reserve(stream, 1, &out, &space));
+
+    if(length <= space) {
+        memcpy(out, memory, length);
+        return ecr_stream_buffered_commit(stream, length);
+    }
+
+    // longer than the buffer's free space, so let the buffered stream decide how to write it
+    return ecr_stream_write_full(stream, (void *) memory, &length);
+}
+
+// writes **separator** (unless it's 0), the quoted and escaped **string**, then **suffix** (unless it's 0)
+static ecr_status_t ecr_json_put_string(ecr_stream_t *stream, char separator, const char *string, size_t length, char suffix) {
+    const unsigned char *in = (const unsigned char *) string;
+    size_t escape = ecr_json_find_escape(in, 0, length);
+
+    if(escape == length) {
+        // nothing to escape, so the whole string is copied at once if it fits
+        char *out;
+        size_t space;
+        ECR_STATUS_GUARD(ecr_stream_buffered_reserve(stream, 4, (void **) &out, &space));
+
+        if(length <= space - 4) {
+            size_t size = 0;
+            if(separator) {
+                out[size++] = separator;
+            }
+            out[size++] = '"';
+            memcpy(out + size, in, length);
+            size += length;
+            out[size++] = '"';
+            if(suffix) {
+                out[size++] = suffix;
+            }
+            return ecr_stream_buffered_commit(stream, size);
+        }
+    }
+
+    char opening[2] = { separator, '"' };
+    ECR_STATUS_GUARD(ecr_json_put(stream, separator ? opening : opening + 1, separator ? 2 : 1));
+
+    size_t position = 0;
+    while(true) {
+        ECR_STATUS_GUARD(ecr_json_put(stream, in + position, escape - position));
+        if(escape == length) {
+            break;
+        }
+
+        char sequence[ESCAPE_MAX];
+        ECR_STATUS_GUARD(ecr_json_put(stream, sequence, ecr_json_escape(in[escape], sequence)));
+
+        position = escape + 1;
+        escape = ecr_json_find_escape(in, position, length);
+    }
+
+    char closing[2] = { '"', suffix };
+    return ecr_json_put(stream, closing, suffix ? 2 : 1);
+}
+
+// checks that a value may be written next, and finds what must separate it from the previous one
+static ecr_status_t ecr_json_before_value(ecr_json_writer_t *writer, char *separator) {
+    if(writer->depth == 0) {
+        *separator = writer->comma ? '\n' : 0;
+        return ECR_SUCCESS;
+    }
+
+    bool object = writer->objects >> (writer->depth - 1) & 1;
+    if(object && !writer->key) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    *separator = writer->comma && !writer->key ? ',' : 0;
+    return ECR_SUCCESS;
+}
+
+static void ecr_json_after_value(ecr_json_writer_t *writer) {
+    writer->comma = true;
+    writer->key = false;
+}
+
+// writes a scalar value, formatted by **format** straight into the buffer after its separator
+static ecr_status_t ecr_json_put_value(ecr_json_writer_t *writer, size_t (*format)(char *, const void *), const void *value) {
+    char separator;
+    ECR_STATUS_GUARD(ecr_json_before_value(writer, &separator));
+
+    char *out;
+    size_t space;
+    ECR_STATUS_GUARD(ecr_stream_buffered_reserve(writer->stream, 1 + ECR_NUMBER_MAX_LENGTH, (void **) &out, &space));
+
+    size_t size = 0;
+    if(separator) {
+        out[size++] = separator;
+    }
+    size += format(out + size, value);
+
+    ECR_STATUS_GUARD(ecr_stream_buffered_commit(writer->stream, size));
+
+    ecr_json_after_value(writer);
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_json_begin(ecr_json_writer_t *writer, bool object) {
+    char separator;
+    ECR_STATUS_GUARD(ecr_json_before_value(writer, &separator));
+    if(writer->depth == ECR_JSON_MAX_DEPTH) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    char opening[2] = { separator, object ? '{' : '[' };
+    ECR_STATUS_GUARD(ecr_json_put(writer->stream, separator ? opening : opening + 1, separator ? 2 : 1));
+
+    uint_least64_t bit = (uint_least64_t) 1 << writer->depth;
+    writer->objects = object ? writer->objects | bit : writer->objects & ~bit;
+    writer->depth++;
+    writer->comma = false;
+    writer->key = false;
+
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_json_end(ecr_json_writer_t *writer, bool object) {
+    if(writer->depth == 0 || (bool) (writer->objects >> (writer->depth - 1) & 1) != object || writer->key) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    char closing = object ? '}' : ']';
+    ECR_STATUS_GUARD(ecr_json_put(writer->stream, &closing, 1));
+
+    writer->depth--;
+    ecr_json_after_value(writer);
+
+    return ECR_SUCCESS;
+}
+
+void ecr_json_writer_init(ecr_json_writer_t *writer, ecr_stream_t *stream) {
+    writer->stream  = stream;
+    writer->objects = 0;
+    writer->depth   = 0;
+    writer->comma   = false;
+    writer->key     = false;
+}
+
+ecr_status_t ecr_json_begin_object(ecr_json_writer_t *writer) {
+    return ecr_json_begin(writer, true);
+}
+
+ecr_status_t ecr_json_end_object(ecr_json_writer_t *writer) {
+    return ecr_json_end(writer, true);
+}
+
+ecr_status_t ecr_json_begin_array(ecr_json_writer_t *writer) {
+    return ecr_json_begin(writer, false);
+}
+
+ecr_status_t ecr_json_end_array(ecr_json_writer_t *writer) {
+    return ecr_json_end(writer, false);
+}
+
+ecr_status_t ecr_json_key(ecr_json_writer_t *writer, const char *key, size_t length) {
+    if(writer->depth == 0 || !(writer->objects >> (writer->depth - 1) & 1) || writer->key) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    ECR_STATUS_GUARD(ecr_json_put_string(writer->stream, writer->comma ? ',' : 0, key, length, ':'));
+
+    writer->key = true;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_json_string(ecr_json_writer_t *writer, const char *string, size_t length) {
+    char separator;
+    ECR_STATUS_GUARD(ecr_json_before_value(writer, &separator));
+
+    ECR_STATUS_GUARD(ecr_json_put_string(writer->stream, separator, string, length, 0));
+
+    ecr_json_after_value(writer);
+    return ECR_SUCCESS;
+}
+
+static size_t ecr_json_format_u64(char *out, const void *value) {
+    return ecr_format_u64(out, *(const uint_least64_t *) value);
+}
+
+static size_t ecr_json_format_i64(char *out, const void *value) {
+    return ecr_format_i64(out, *(const int_least64_t *) value);
+}
+
+static size_t ecr_json_format_f64(char *out, const void *value) {
+    return ecr_format_f64(out, *(const double *) value);
+}
+
+static size_t ecr_json_format_literal(char *out, const void *value) {
+    size_t length = strlen(value);
+    memcpy(out, value, length);
+    return length;
+}
+
+ecr_status_t ecr_json_u64(ecr_json_writer_t *writer, uint_least64_t value) {
+    return ecr_json_put_value(writer, ecr_json_format_u64, &value);
+}
+
+ecr_status_t ecr_json_i64(ecr_json_writer_t *writer, int_least64_t value) {
+    return ecr_json_put_value(writer, ecr_json_format_i64, &value);
+}
+
+ecr_status_t ecr_json_f64(ecr_json_writer_t *writer, double value) {
+    if(__builtin_isinf(value) || __builtin_isnan(value)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+    return ecr_json_put_value(writer, ecr_json_format_f64, &value);
+}
+
+ecr_status_t ecr_json_bool(ecr_json_writer_t *writer, bool value) {
+    return ecr_json_put_value(writer, ecr_json_format_literal, value ? "true" : "false");
+}
+
+ecr_status_t ecr_json_null(ecr_json_writer_t *writer) {
+    return ecr_json_put_value(writer, ecr_json_format_literal, "null");
+}
@@ -0,0 +1,379 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/number.h"
+
+#include "pow10.h"
+
+#define POW10_MIN ECR_POW10_128_MIN
+#define POW10_MAX ECR_POW10_128_MAX
+
+#define BIGNUM_LIMBS 40
+
+typedef unsigned __int128 uint128_t;
+
+static const char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// 128-bit approximations (high word first) of powers of ten, scaled into [2^127, 2^128) and rounded down
+static uint64_t pow10_table[POW10_MAX - POW10_MIN + 1][2];
+static pthread_once_t pow10_once = PTHREAD_ONCE_INIT;
+
+static size_t ecr_format_digits(char *out, uint64_t value) {
+    char digits[20];
+    char *end = digits + sizeof(digits), *start = end;
+
+    for(; value >= 100; value /= 100) {
+        start -= 2;
+        memcpy(start, digit_pairs + 2 * (value % 100), 2);
+    }
+    if(value >= 10) {
+        start -= 2;
+        memcpy(start, digit_pairs + 2 * value, 2);
+    } else {
+        *--start = '0' + value;
+    }
+
+    memcpy(out, start, end - start);
+    return end - start;
+}
+
+size_t ecr_format_u64(char *out, uint_least64_t value) {
+    return ecr_format_digits(out, value);
+}
+
+size_t ecr_format_i64(char *out, int_least64_t value) {
+    if(value < 0) {
+        *out = '-';
+        return 1 + ecr_format_digits(out + 1, -(uint64_t) value);
+    }
+
+    return ecr_format_digits(out, value);
+}
+
+size_t ecr_format_hex(char *out, uint_least64_t value) {
+    static const char hex_digits[] = "0123456789abcdef";
+
+    size_t length = value == 0 ? 1 : (64 - __builtin_clzll(value) + 3) / 4;
+    for(size_t i = length; i > 0; i--) {
+        out[i - 1] = hex_digits[value & 0xF];
+        value >>= 4;
+    }
+
+    return length;
+}
+
+/*
+ * Shortest round-trip formatting follows the Schubfach algorithm (R. Giulietti, "The Schubfach way to render doubles").
+ * The logarithm approximations below are exact over the range of exponents they're used with.
+ */
+static int floor_log10_pow2(int e) {
+    return (e * 315653) >> 20;
+}
+
+static int floor_log10_three_quarters_pow2(int e) {
+    return (e * 315653 - 131237) >> 20;
+}
+
+static int floor_log2_pow10(int e) {
+    return (e * 1741647) >> 19;
+}
+
+static size_t bignum_mul_small(uint32_t *limbs, size_t count, uint32_t factor) {
+    uint64_t carry = 0;
+    for(size_t i = 0; i < count; i++) {
+        carry += (uint64_t) limbs[i] * factor;
+        limbs[i] = carry;
+        carry >>= 32;
+    }
+
+    if(carry) {
+        limbs[count++] = carry;
+    }
+    return count;
+}
+
+static size_t bignum_div_small(uint32_t *limbs, size_t count, uint32_t divisor) {
+    uint64_t remainder = 0;
+    for(size_t i = count; i > 0; i--) {
+        remainder = remainder << 32 | limbs[i - 1];
+        limbs[i - 1] = remainder / divisor;
+        remainder %= divisor;
+    }
+
+    while(count > 0 && limbs[count - 1] == 0) {
+        count--;
+    }
+    return count;
+}
+
+// floor(limbs / 2^shift), for results below 2^128
+static uint128_t bignum_shift_right(const uint32_t *limbs, size_t count, size_t shift) {
+    uint128_t value = 0;
+    for(size_t bit = 0; bit < 128; bit += 32) {
+        size_t index = (shift + bit) / 32, offset = (shift + bit) % 32;
+
+        uint64_t word = 0;
+        if(index < count) {
+            word = limbs[index];
+        }
+        if(index + 1 < count) {
+            word |= (uint64_t) limbs[index + 1] << 32;
+        }
+
+        value |= (uint128_t) (uint32_t) (word >> offset) << bit;
+    }
+
+    return value;
+}
+
+static void ecr_pow10_init() {
+    uint32_t limbs[BIGNUM_LIMBS];
+
+    // non-negative powers are exact integers, built up one multiplication at a time
+    size_t count = 1;
+    limbs[0] = 1;
+    for(int k = 0; k <= POW10_MAX; k++) {
+        int e = floor_log2_pow10(k) - 127;
+
+        uint128_t g;
+        if(e >= 0) {
+            g = bignum_shift_right(limbs, count, e);
+        } else {
+            g = bignum_shift_right(limbs, count, 0) << -e;
+        }
+
+        pow10_table[k - POW10_MIN][0] = g >> 64;
+        pow10_table[k - POW10_MIN][1] = g;
+
+        count = bignum_mul_small(limbs, count, 10);
+    }
+
+    // negative powers are 2^-e / 10^-k, divided out nine digits at a time
+    for(int k = POW10_MIN; k < 0; k++) {
+        int shift = 127 - floor_log2_pow10(k);
+
+        memset(limbs, 0, sizeof(limbs));
+        count = shift / 32 + 1;
+        limbs[shift / 32] = (uint32_t) 1 << (shift % 32);
+
+        int remaining = -k;
+        for(; remaining >= 9; remaining -= 9) {
+            count = bignum_div_small(limbs, count, 1000000000);
+        }
+        uint32_t divisor = 1;
+        for(; remaining > 0; remaining--) {
+            divisor *= 10;
+        }
+        count = bignum_div_small(limbs, count, divisor);
+
+        uint128_t g = bignum_shift_right(limbs, count, 0);
+        pow10_table[k - POW10_MIN][0] = g >> 64;
+        pow10_table[k - POW10_MIN][1] = g;
+    }
+}
+
+const uint64_t * ecr_pow10_128(int k) {
+    pthread_once(&pow10_once, ecr_pow10_init);
+    return pow10_table[k - POW10_MIN];
+}
+
+static uint64_t round_to_odd(const uint64_t *g, uint64_t cp) {
+    uint128_t x = (uint128_t) g[1] * cp;
+    uint128_t y = (uint128_t) g[0] * cp + (uint64_t) (x >> 64);
+
+    uint64_t y1 = y >> 64, y0 = y;
+    return y1 | (y0 > 1);
+}
+
+// finds the shortest decimal significand and exponent which round to **c** * 2^**q**
+static void ecr_f64_to_decimal(uint64_t c, int q, bool lower_closer, uint64_t *significand, int *exponent) {
+    bool even = (c & 1) == 0;
+
+    uint64_t cbl = 4 * c - 2 + lower_closer;
+    uint64_t cb = 4 * c;
+    uint64_t cbr = 4 * c + 2;
+
+    int k = lower_closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+    int h = q + floor_log2_pow10(-k) + 1;
+
+    // the table is rounded down, this needs it rounded up
+    const uint64_t *lower_bound = pow10_table[-k - POW10_MIN];
+    uint64_t g[2] = { lower_bound[0] + (lower_bound[1] == UINT64_MAX), lower_bound[1] + 1 };
+
+    uint64_t vbl = round_to_odd(g, cbl << h);
+    uint64_t vb = round_to_odd(g, cb << h);
+    uint64_t vbr = round_to_odd(g, cbr << h);
+
+    uint64_t lower = vbl + !even;
+    uint64_t upper = vbr - !even;
+
+    uint64_t s = vb / 4;
+    if(s >= 10) {
+        uint64_t sp = s / 10;
+        bool up_inside = lower <= 40 * sp;
+        bool wp_inside = 40 * sp + 40 <= upper;
+        if(up_inside != wp_inside) {
+            *significand = sp + wp_inside;
+            *exponent = k + 1;
+            return;
+        }
+    }
+
+    bool u_inside = lower <= 4 * s;
+    bool w_inside = 4 * s + 4 <= upper;
+    if(u_inside != w_inside) {
+        *significand = s + w_inside;
+        *exponent = k;
+        return;
+    }
+
+    uint64_t middle = 4 * s + 2;
+    bool round_up = vb > middle || (vb == middle && (s & 1) != 0);
+    *significand = s + round_up;
+    *exponent = k;
+}
+
+size_t ecr_format_f64(char *out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint64_t fraction = bits & ((UINT64_C(1) << 52) - 1);
+    int biased_exponent = (bits >> 52) & 0x7FF;
+
+    char *start = out;
+    if(bits >> 63) {
+        *out++ = '-';
+    }
+
+    if(biased_exponent == 0x7FF) {
+        if(fraction) {
+            memcpy(start, "nan", 3);
+            return 3;
+        }
+
+        memcpy(out, "inf", 3);
+        return out + 3 - start;
+    }
+
+    if(biased_exponent == 0 && fraction == 0) {
+        *out++ = '0';
+        return out - start;
+    }
+
+    uint64_t significand;
+    int exponent;
+
+    uint64_t c = biased_exponent == 0 ? fraction : fraction | UINT64_C(1) << 52;
+    int q = (biased_exponent == 0 ? 1 : biased_exponent) - 1075;
+
+    if(q <= 0 && q > -53 && (c & ((UINT64_C(1) << -q) - 1)) == 0) {
+        // small integers are exact
+        significand = c >> -q;
+        exponent = 0;
+    } else {
+        pthread_once(&pow10_once, ecr_pow10_init);
+        ecr_f64_to_decimal(c, q, fraction == 0 && biased_exponent > 1, &significand, &exponent);
+    }
+
+    while(significand % 10 == 0) {
+        significand /= 10;
+        exponent++;
+    }
+
+    char digits[20];
+    int count = ecr_format_digits(digits, significand);
+    int scientific = exponent + count - 1;
+
+    if(scientific < -4 || scientific > 16) {
+        *out++ = digits[0];
+        if(count > 1) {
+            *out++ = '.';
+            memcpy(out, digits + 1, count - 1);
+            out += count - 1;
+        }
+
+        *out++ = 'e';
+        *out++ = scientific < 0 ? '-' : '+';
+        if(scientific < 0) {
+            scientific = -scientific;
+        }
+        if(scientific < 10) {
+            *out++ = '0';
+        }
+        out += ecr_format_digits(out, scientific);
+    } else if(exponent >= 0) {
+        memcpy(out, digits, count);
+        out += count;
+        memset(out, '0', exponent);
+        out += exponent;
+    } else if(scientific >= 0) {
+        memcpy(out, digits, scientific + 1);
+        out += scientific + 1;
+        *out++ = '.';
+        memcpy(out, digits + scientific + 1, count - scientific - 1);
+        out += count - scientific - 1;
+    } else {
+        *out++ = '0';
+        *out++ = '.';
+        memset(out, '0', -scientific - 1);
+        out += -scientific - 1;
+        memcpy(out, digits, count);
+        out += count;
+    }
+
+    return out - start;
+}
+
+ecr_status_t ecr_stream_write_u64(ecr_stream_t *stream, uint_least64_t value) {
+    char out[ECR_NUMBER_MAX_LENGTH];
+    size_t length = ecr_format_u64(out, value);
+    return ecr_stream_write_full(stream, out, &length);
+}
+
+ecr_status_t ecr_stream_write_i64(ecr_stream_t *stream, int_least64_t value) {
+    char out[ECR_NUMBER_MAX_LENGTH];
+    size_t length = ecr_format_i64(out, value);
+    return ecr_stream_write_full(stream, out, &length);
+}
+
+ecr_status_t ecr_stream_write_hex(ecr_stream_t *stream, uint_least64_t value) {
+    char out[ECR_NUMBER_MAX_LENGTH];
+    size_t length = ecr_format_hex(out, value);
+    return ecr_stream_write_full(stream, out, &length);
+}
+
+ecr_status_t ecr_stream_write_f64(ecr_stream_t *stream, double value) {
+    char out[ECR_NUMBER_MAX_LENGTH];
+    size_t length = ecr_format_f64(out, value);
+    return ecr_stream_write_full(stream, out, &length);
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdatomic.h>
+#include <stdckdint.h>
+
+#include "ecr/allocator.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/file.h"
+#include "ecr/stream/pipe.h"
+
+#include "ring.h"
+
+struct ecr_stream_pipe {
+    struct ecr_ring ring;
+
+    ecr_allocator_t *allocator;
+    atomic_int references;
+    bool blocking;
+
+    unsigned char memory[];
+};
+
+static ecr_status_t ecr_stream_pipe_release(struct ecr_stream_pipe *pipe, uint32_t side) {
+    ecr_ring_close(&pipe->ring, side, false);
+
+    if(atomic_fetch_sub(&pipe->references, 1) == 1) {
+        return ecr_free(pipe->allocator, pipe);
+    }
+
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_pipe_readbuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_pipe *pipe = data;
+    return ecr_ring_readbuf(&pipe->ring, pipe->memory, buffer, pipe->blocking, false);
+}
+
+static ecr_status_t ecr_stream_pipe_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_pipe *pipe = data;
+    return ecr_ring_writebuf(&pipe->ring, pipe->memory, buffer, pipe->blocking, false);
+}
+
+static ecr_status_t ecr_stream_pipe_unsupported(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_pipe_close_reader(void *data) {
+    return ecr_stream_pipe_release(data, ECR_RING_READER_CLOSED);
+}
+
+static ecr_status_t ecr_stream_pipe_close_writer(void *data) {
+    return ecr_stream_pipe_release(data, ECR_RING_WRITER_CLOSED);
+}
+
+static ecr_status_t ecr_stream_pipe_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_pipe_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_pipe(ecr_stream_t *reader, ecr_stream_t *writer, ecr_allocator_t *allocator, size_t capacity, ecr_filemode_t mode_flags) {
+    if(capacity == 0 || (mode_flags & ~ECR_FILEMODE_NONBLOCK)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t ring_capacity = 1;
+    while(ring_capacity < capacity) {
+        if(ckd_mul(&ring_capacity, ring_capacity, 2)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+    }
+
+    size_t size;
+    if(ckd_add(&size, sizeof(struct ecr_stream_pipe), ring_capacity)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    struct ecr_stream_pipe *pipe;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &pipe, size));
+
+    ecr_ring_init(&pipe->ring, ring_capacity);
+    pipe->allocator = allocator;
+    atomic_init(&pipe->references, 2);
+    pipe->blocking = !(mode_flags & ECR_FILEMODE_NONBLOCK);
+
+    reader->version = 0;
+    reader->data = pipe;
+
+    reader->readbuf  = ecr_stream_pipe_readbuf;
+    reader->writebuf = ecr_stream_pipe_unsupported;
+    reader->close    = ecr_stream_pipe_close_reader;
+    reader->getpos   = ecr_stream_pipe_getpos;
+    reader->setpos   = ecr_stream_pipe_setpos;
+
+    writer->version = 0;
+    writer->data = pipe;
+
+    writer->readbuf  = ecr_stream_pipe_unsupported;
+    writer->writebuf = ecr_stream_pipe_writebuf;
+    writer->close    = ecr_stream_pipe_close_writer;
+    writer->getpos   = ecr_stream_pipe_getpos;
+    writer->setpos   = ecr_stream_pipe_setpos;
+    return ECR_SUCCESS;
+}
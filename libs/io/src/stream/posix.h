@@ -16,8 +16,17 @@
 
 #pragma once
 
+#include <sys/uio.h>
+
+#include <ecr/error.h>
 #include <ecr/macro/attributes.h>
 #include <ecr/stream.h>
 
 internal void ecr_stream_from_fd_nodup(ecr_stream_t *stream, int fd);
 internal void ecr_stream_from_file_nodup(ecr_stream_t *stream, int fd);
+
+internal bool ecr_stream_is_socket(ecr_stream_t *stream);
+internal ecr_status_t ecr_stream_socket_writev_full(ecr_stream_t *stream, struct iovec *iov, int count);
+
+internal bool ecr_stream_get_fd(ecr_stream_t *stream, int *fd);
+internal ecr_status_t ecr_fd_writev_full(int fd, struct iovec *iov, int count);
@@ -0,0 +1,29 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <ecr/macro/attributes.h>
+
+#define ECR_POW10_128_MIN (-342)
+#define ECR_POW10_128_MAX 324
+
+/**
+ * Returns the 128-bit approximation (high word first) of 10^**k**, scaled into [2^127, 2^128) and rounded down.
+ * **k** must lie within [{@link ECR_POW10_128_MIN}, {@link ECR_POW10_128_MAX}].
+ */
+internal const uint64_t * ecr_pow10_128(int k);
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <stdckdint.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include "ecr/allocator.h"
+#include "ecr/buffer.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/readahead.h"
+
+#define CHUNK_MIN     4096
+#define CHUNK_INITIAL 65536
+
+struct ecr_stream_readahead_chunk {
+    ecr_buffer_t buffer;
+    ecr_status_t status;
+};
+
+struct ecr_stream_readahead {
+    ecr_stream_t *source;
+    ecr_allocator_t *allocator;
+    pthread_t reader;
+
+    pthread_mutex_t lock;
+    pthread_cond_t filled, emptied;
+
+    size_t count, ready;
+    size_t fill_index, consume_index;
+    size_t chunk_size, chunk_min;
+    bool closing;
+
+    struct ecr_stream_readahead_chunk chunks[];
+};
+
+static void * ecr_stream_readahead_fill(void *data) {
+    struct ecr_stream_readahead *readahead = data;
+
+    pthread_mutex_lock(&readahead->lock);
+    while(!readahead->closing) {
+        if(readahead->ready == readahead->count) {
+            // the consumer is the bottleneck, so there's no point in reading large chunks
+            if(readahead->chunk_size / 2 >= readahead->chunk_min) {
+                readahead->chunk_size /= 2;
+            }
+
+            pthread_cond_wait(&readahead->emptied, &readahead->lock);
+            continue;
+        }
+
+        struct ecr_stream_readahead_chunk *chunk = &readahead->chunks[readahead->fill_index];
+        chunk->buffer.position = 0;
+        chunk->buffer.length = readahead->chunk_size;
+        pthread_mutex_unlock(&readahead->lock);
+
+        ecr_status_t status = ecr_stream_readbuf(readahead->source, &chunk->buffer);
+
+        pthread_mutex_lock(&readahead->lock);
+        chunk->status = status;
+        chunk->buffer.length = chunk->buffer.position;
+        chunk->buffer.position = 0;
+
+        readahead->fill_index = (readahead->fill_index + 1) % readahead->count;
+        readahead->ready++;
+        pthread_cond_signal(&readahead->filled);
+
+        if(status) {
+            break;
+        }
+    }
+    pthread_mutex_unlock(&readahead->lock);
+
+    return NULL;
+}
+
+static ecr_status_t ecr_stream_readahead_readbuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_readahead *readahead = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    pthread_mutex_lock(&readahead->lock);
+    while(true) {
+        if(readahead->ready == 0) {
+            // the consumer is starved, so read larger chunks
+            if(readahead->chunk_size * 2 <= readahead->chunks[0].buffer.capacity) {
+                readahead->chunk_size *= 2;
+            }
+
+            pthread_cond_wait(&readahead->filled, &readahead->lock);
+            continue;
+        }
+
+        struct ecr_stream_readahead_chunk *chunk = &readahead->chunks[readahead->consume_index];
+        if(chunk->buffer.position < chunk->buffer.length) {
+            break;
+        }
+        if(chunk->status) {
+            ecr_status_t status = chunk->status;
+            pthread_mutex_unlock(&readahead->lock);
+            return status;
+        }
+
+        readahead->consume_index = (readahead->consume_index + 1) % readahead->count;
+        readahead->ready--;
+        pthread_cond_signal(&readahead->emptied);
+    }
+    pthread_mutex_unlock(&readahead->lock);
+
+    // the background thread never touches a ready chunk, so it can be read without the lock
+    struct ecr_stream_readahead_chunk *chunk = &readahead->chunks[readahead->consume_index];
+    if(length > chunk->buffer.length - chunk->buffer.position) {
+        length = chunk->buffer.length - chunk->buffer.position;
+    }
+
+    memcpy(buffer->memory + buffer->position, chunk->buffer.memory + chunk->buffer.position, length);
+    chunk->buffer.position += length;
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_readahead_writebuf(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_readahead_free(struct ecr_stream_readahead *readahead, size_t count) {
+    ecr_status_t status = ECR_SUCCESS;
+    for(size_t i = 0; i < count; i++) {
+        ecr_status_t free_status = ecr_buffer_free(&readahead->chunks[i].buffer, readahead->allocator);
+        if(!status) {
+            status = free_status;
+        }
+    }
+
+    ecr_status_t free_status = ecr_free(readahead->allocator, readahead);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_readahead_close(void *data) {
+    struct ecr_stream_readahead *readahead = data;
+
+    pthread_mutex_lock(&readahead->lock);
+    readahead->closing = true;
+    pthread_cond_signal(&readahead->emptied);
+    pthread_mutex_unlock(&readahead->lock);
+
+    int error = pthread_join(readahead->reader, NULL);
+    if(error) {
+        errno = error;
+        return ecr_get_system_error();
+    }
+
+    pthread_cond_destroy(&readahead->emptied);
+    pthread_cond_destroy(&readahead->filled);
+    pthread_mutex_destroy(&readahead->lock);
+
+    return ecr_stream_readahead_free(readahead, readahead->count);
+}
+
+static ecr_status_t ecr_stream_readahead_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_readahead_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_readahead(ecr_stream_t *stream, ecr_stream_t *source, ecr_allocator_t *allocator, size_t buffer_count, size_t buffer_size) {
+    if(buffer_count < 2 || buffer_size == 0) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t size;
+    if(ckd_mul(&size, sizeof(struct ecr_stream_readahead_chunk), buffer_count) || ckd_add(&size, size, sizeof(struct ecr_stream_readahead))) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    struct ecr_stream_readahead *readahead;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &readahead, size));
+    readahead->allocator = allocator;
+
+    for(size_t i = 0; i < buffer_count; i++) {
+        ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_buffer_allocate(&readahead->chunks[i].buffer, allocator, buffer_size), {
+            ecr_stream_readahead_free(readahead, i);
+        });
+        readahead->chunks[i].status = ECR_SUCCESS;
+    }
+
+    readahead->source = source;
+    readahead->count = buffer_count;
+    readahead->ready = 0;
+    readahead->fill_index = 0;
+    readahead->consume_index = 0;
+    readahead->chunk_min = buffer_size < CHUNK_MIN ? buffer_size : CHUNK_MIN;
+    readahead->chunk_size = buffer_size < CHUNK_INITIAL ? buffer_size : CHUNK_INITIAL;
+    readahead->closing = false;
+
+    pthread_mutex_init(&readahead->lock, NULL);
+    pthread_cond_init(&readahead->filled, NULL);
+    pthread_cond_init(&readahead->emptied, NULL);
+
+    int error = pthread_create(&readahead->reader, NULL, ecr_stream_readahead_fill, readahead);
+    if(error) {
+        pthread_cond_destroy(&readahead->emptied);
+        pthread_cond_destroy(&readahead->filled);
+        pthread_mutex_destroy(&readahead->lock);
+        ecr_stream_readahead_free(readahead, buffer_count);
+
+        errno = error;
+        return ecr_get_system_error();
+    }
+
+    stream->version = 0;
+    stream->data = readahead;
+
+    stream->readbuf  = ecr_stream_readahead_readbuf;
+    stream->writebuf = ecr_stream_readahead_writebuf;
+    stream->close    = ecr_stream_readahead_close;
+    stream->getpos   = ecr_stream_readahead_getpos;
+    stream->setpos   = ecr_stream_readahead_setpos;
+    return ECR_SUCCESS;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdckdint.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ecr/buffer.h"
+#include "ecr/codec.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/record.h"
+
+static ecr_status_t ecr_record_put_prefix(ecr_buffer_t *buffer, ecr_record_prefix_t prefix, uint_least64_t length) {
+    if(prefix == ECR_RECORD_PREFIX_FIXED32) {
+        return ecr_codec_put_u32le(buffer, length);
+    }
+    return ecr_codec_put_varint(buffer, length);
+}
+
+static ecr_status_t ecr_record_get_prefix(ecr_buffer_t *buffer, ecr_record_prefix_t prefix, uint_least64_t *length) {
+    if(prefix == ECR_RECORD_PREFIX_FIXED32) {
+        uint_least32_t fixed;
+        ECR_STATUS_GUARD(ecr_codec_get_u32le(buffer, &fixed));
+
+        *length = fixed;
+        return ECR_SUCCESS;
+    }
+    return ecr_codec_get_varint(buffer, length);
+}
+
+ecr_status_t ecr_stream_write_record(ecr_stream_t *stream, ecr_record_prefix_t prefix, const void *memory, size_t length) {
+    if(prefix != ECR_RECORD_PREFIX_VARINT && prefix != ECR_RECORD_PREFIX_FIXED32) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+    if(prefix == ECR_RECORD_PREFIX_FIXED32 && length > UINT32_MAX) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    ecr_buffer_t buffer;
+    ECR_STATUS_GUARD(ecr_codec_begin_write(stream, ECR_CODEC_VARINT_MAX, &buffer));
+    ECR_STATUS_GUARD(ecr_record_put_prefix(&buffer, prefix, length));
+
+    if(length <= buffer.capacity - buffer.length) {
+        memcpy(buffer.memory + buffer.length, memory, length);
+        buffer.length += length;
+        return ecr_codec_end_write(stream, &buffer);
+    }
+
+    // the record doesn't fit alongside the buffered data, so let the buffered stream decide how to write it
+    ECR_STATUS_GUARD(ecr_codec_end_write(stream, &buffer));
+    return ecr_stream_write_full(stream, (void *) memory, &length);
+}
+
+ecr_status_t ecr_stream_read_record(ecr_stream_t *stream, ecr_record_prefix_t prefix, size_t max_length, const void **record, size_t *length) {
+    if(prefix != ECR_RECORD_PREFIX_VARINT && prefix != ECR_RECORD_PREFIX_FIXED32) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    ecr_buffer_t buffer;
+    ECR_STATUS_GUARD(ecr_codec_begin_read(stream, 1, &buffer));
+
+    uint_least64_t record_length;
+    while(true) {
+        ecr_status_t status = ecr_record_get_prefix(&buffer, prefix, &record_length);
+        if(status != ECR_ERROR_EOF) {
+            ECR_STATUS_GUARD(status);
+            break;
+        }
+
+        status = ecr_codec_begin_read(stream, buffer.length + 1, &buffer);
+        if(status == ECR_ERROR_EOF) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+        ECR_STATUS_GUARD(status);
+    }
+
+    if(record_length > max_length) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    size_t prefix_size = buffer.position, total;
+    if(ckd_add(&total, prefix_size, record_length)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    if(buffer.length < total) {
+        ecr_status_t status = ecr_codec_begin_read(stream, total, &buffer);
+        if(status == ECR_ERROR_EOF) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+        ECR_STATUS_GUARD(status);
+    }
+
+    buffer.position = total;
+    ECR_STATUS_GUARD(ecr_codec_end_read(stream, &buffer));
+
+    *record = buffer.memory + prefix_size;
+    *length = record_length;
+    return ECR_SUCCESS;
+}
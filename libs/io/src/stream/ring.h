@@ -0,0 +1,204 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ecr/buffer.h>
+#include <ecr/error.h>
+
+#include "futex.h"
+
+#define ECR_RING_CACHE_LINE_SIZE 64
+
+enum {
+    ECR_RING_READER_CLOSED = (1 << 0),
+    ECR_RING_WRITER_CLOSED = (1 << 1),
+};
+
+/**
+ * Header of a single-producer/single-consumer byte ring. It contains no pointers,
+ * so that it may be placed in memory shared between processes.
+ *
+ * **head** and **tail** count the total number of bytes written and read respectively,
+ * and live on separate cache lines along with the futex words used to wait on them.
+ */
+struct ecr_ring {
+    _Atomic uint64_t head;
+    _Atomic uint32_t written;
+    _Atomic uint32_t reader_waiting;
+    char head_padding[ECR_RING_CACHE_LINE_SIZE - 16];
+
+    _Atomic uint64_t tail;
+    _Atomic uint32_t read;
+    _Atomic uint32_t writer_waiting;
+    char tail_padding[ECR_RING_CACHE_LINE_SIZE - 16];
+
+    _Atomic uint32_t closed;
+    uint32_t reserved;
+    uint64_t capacity;
+};
+
+/**
+ * Initialize a ring whose data block holds **capacity** bytes, which must be a power of two.
+ */
+[[maybe_unused]]
+static void ecr_ring_init(struct ecr_ring *ring, uint64_t capacity) {
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->written, 0);
+    atomic_init(&ring->reader_waiting, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->read, 0);
+    atomic_init(&ring->writer_waiting, 0);
+    atomic_init(&ring->closed, 0);
+    ring->reserved = 0;
+    ring->capacity = capacity;
+}
+
+/**
+ * Read from a ring's data block **memory** into a **buffer**, as the ring's only reader.
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_ring_readbuf(struct ecr_ring *ring, const void *memory, ecr_buffer_t *restrict buffer, bool blocking, bool shared) {
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    while(head == tail) {
+        if(atomic_load(&ring->closed) & ECR_RING_WRITER_CLOSED) {
+            head = atomic_load_explicit(&ring->head, memory_order_acquire);
+            if(head != tail) {
+                break;
+            }
+
+            return ECR_ERROR_EOF;
+        }
+        if(!blocking) {
+            return ECR_ERROR_AGAIN;
+        }
+
+        uint32_t written = atomic_load(&ring->written);
+        atomic_store(&ring->reader_waiting, 1);
+        if(atomic_load(&ring->head) == tail && !(atomic_load(&ring->closed) & ECR_RING_WRITER_CLOSED)) {
+            ecr_futex_wait(&ring->written, written, NULL, shared);
+        }
+        atomic_store(&ring->reader_waiting, 0);
+
+        head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    }
+
+    if(length > head - tail) {
+        length = head - tail;
+    }
+
+    size_t offset = tail & (ring->capacity - 1);
+    size_t first = ring->capacity - offset;
+    if(first > length) {
+        first = length;
+    }
+
+    memcpy(buffer->memory + buffer->position, memory + offset, first);
+    memcpy(buffer->memory + buffer->position + first, memory, length - first);
+
+    atomic_store(&ring->tail, tail + length);
+    if(atomic_load(&ring->writer_waiting)) {
+        atomic_fetch_add(&ring->read, 1);
+        ecr_futex_wake(&ring->read, 1, shared);
+    }
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+/**
+ * Write from a **buffer** into a ring's data block **memory**, as the ring's only writer.
+ */
+[[maybe_unused]]
+static ecr_status_t ecr_ring_writebuf(struct ecr_ring *ring, void *memory, ecr_buffer_t *restrict buffer, bool blocking, bool shared) {
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    while(true) {
+        if(atomic_load(&ring->closed) & ECR_RING_READER_CLOSED) {
+            errno = EPIPE;
+            return ecr_get_system_error();
+        }
+        if(head - tail < ring->capacity) {
+            break;
+        }
+        if(!blocking) {
+            return ECR_ERROR_AGAIN;
+        }
+
+        uint32_t read = atomic_load(&ring->read);
+        atomic_store(&ring->writer_waiting, 1);
+        if(atomic_load(&ring->tail) == tail && !(atomic_load(&ring->closed) & ECR_RING_READER_CLOSED)) {
+            ecr_futex_wait(&ring->read, read, NULL, shared);
+        }
+        atomic_store(&ring->writer_waiting, 0);
+
+        tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    }
+
+    if(length > ring->capacity - (head - tail)) {
+        length = ring->capacity - (head - tail);
+    }
+
+    size_t offset = head & (ring->capacity - 1);
+    size_t first = ring->capacity - offset;
+    if(first > length) {
+        first = length;
+    }
+
+    memcpy(memory + offset, buffer->memory + buffer->position, first);
+    memcpy(memory, buffer->memory + buffer->position + first, length - first);
+
+    atomic_store(&ring->head, head + length);
+    if(atomic_load(&ring->reader_waiting)) {
+        atomic_fetch_add(&ring->written, 1);
+        ecr_futex_wake(&ring->written, 1, shared);
+    }
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+/**
+ * Mark one side of a ring as closed and wake up the other.
+ *
+ * @param side {@link ECR_RING_READER_CLOSED} or {@link ECR_RING_WRITER_CLOSED}
+ */
+[[maybe_unused]]
+static void ecr_ring_close(struct ecr_ring *ring, uint32_t side, bool shared) {
+    atomic_fetch_or(&ring->closed, side);
+
+    atomic_fetch_add(&ring->written, 1);
+    ecr_futex_wake(&ring->written, INT_MAX, shared);
+    atomic_fetch_add(&ring->read, 1);
+    ecr_futex_wake(&ring->read, INT_MAX, shared);
+}
@@ -0,0 +1,465 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <locale.h>
+#include <stdckdint.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/buffered.h"
+#include "ecr/stream/scan.h"
+
+#include "pow10.h"
+
+// significant digits which always fit in 64 bits
+#define SIGNIFICAND_DIGITS 19
+
+typedef unsigned __int128 uint128_t;
+
+// powers of ten which doubles hold exactly
+static const double exact_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static locale_t c_locale;
+static pthread_once_t c_locale_once = PTHREAD_ONCE_INIT;
+
+static void ecr_scan_locale_init() {
+    c_locale = newlocale(LC_ALL_MASK, "C", (locale_t) 0);
+}
+
+static bool ecr_scan_is_space(unsigned char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+static bool ecr_scan_is_number(unsigned char c) {
+    return (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z') || c == '.' || c == '+' || c == '-';
+}
+
+// finds the first byte at or after **offset** which is whitespace if **space**, or isn't otherwise
+static size_t ecr_scan_find_space(const unsigned char *memory, size_t offset, size_t length, bool space) {
+#if defined(__SSE2__)
+    const __m128i blank = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i control_range = _mm_set1_epi8('\r' - '\t');
+
+    unsigned flip = space ? 0 : 0xFFFF;
+    for(; offset + 16 <= length; offset += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *) (memory + offset));
+
+        // '\t' through '\r' are the bytes which wrap into [0, 4] when '\t' is subtracted
+        __m128i control = _mm_sub_epi8(chunk, tab);
+        __m128i spaces = _mm_or_si128(_mm_cmpeq_epi8(chunk, blank), _mm_cmpeq_epi8(_mm_min_epu8(control, control_range), control));
+
+        unsigned mask = _mm_movemask_epi8(spaces) ^ flip;
+        if(mask) {
+            return offset + __builtin_ctz(mask);
+        }
+    }
+#endif
+
+    for(; offset < length && ecr_scan_is_space(memory[offset]) != space; offset++);
+    return offset;
+}
+
+static size_t ecr_scan_find_number_end(const unsigned char *memory, size_t offset, size_t length) {
+    for(; offset < length && ecr_scan_is_number(memory[offset]); offset++);
+    return offset;
+}
+
+static uint64_t ecr_scan_load_eight(const unsigned char *memory) {
+    uint64_t chunk;
+    memcpy(&chunk, memory, sizeof(chunk));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+    return chunk;
+}
+
+// checks eight ASCII bytes at once: each high nibble must be 3, and adding 6 to the low nibble mustn't carry into it
+static bool ecr_scan_is_eight_digits(uint64_t chunk) {
+    return ((chunk & UINT64_C(0xF0F0F0F0F0F0F0F0)) | (((chunk + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0)) >> 4)) == UINT64_C(0x3333333333333333);
+}
+
+// converts eight digits, first digit in the lowest byte, by combining pairs, then quads, then both halves
+static uint32_t ecr_scan_parse_eight_digits(uint64_t chunk) {
+    chunk -= UINT64_C(0x3030303030303030);
+    chunk = chunk * 10 + (chunk >> 8);
+    chunk = ((chunk & UINT64_C(0x000000FF000000FF)) * UINT64_C(0x000F424000000064) + ((chunk >> 16) & UINT64_C(0x000000FF000000FF)) * UINT64_C(0x0000271000000001)) >> 32;
+    return chunk;
+}
+
+// accumulates up to **limit** leading digits of **memory** into **value**, returning how many were accumulated
+static size_t ecr_scan_digits(const unsigned char *memory, size_t length, size_t limit, uint64_t *value) {
+    if(limit > length) {
+        limit = length;
+    }
+
+    size_t count = 0;
+    for(; count + 8 <= limit; count += 8) {
+        uint64_t chunk = ecr_scan_load_eight(memory + count);
+        if(!ecr_scan_is_eight_digits(chunk)) {
+            break;
+        }
+        *value = *value * 100000000 + ecr_scan_parse_eight_digits(chunk);
+    }
+
+    for(; count < limit && (unsigned char) (memory[count] - '0') < 10; count++) {
+        *value = *value * 10 + (memory[count] - '0');
+    }
+
+    return count;
+}
+
+static ecr_status_t ecr_scan_parse_u64(const unsigned char *memory, size_t length, uint_least64_t *value) {
+    if(length == 0) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    uint64_t result = 0;
+    size_t count = ecr_scan_digits(memory, length, SIGNIFICAND_DIGITS, &result);
+
+    bool overflow = false;
+    for(; count < length; count++) {
+        unsigned digit = (unsigned char) (memory[count] - '0');
+        if(digit >= 10) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+
+        overflow |= ckd_mul(&result, result, 10) || ckd_add(&result, result, digit);
+    }
+
+    if(overflow) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    *value = result;
+    return ECR_SUCCESS;
+}
+
+static bool ecr_scan_match(const unsigned char *memory, size_t length, const char *word) {
+    if(length != strlen(word)) {
+        return false;
+    }
+
+    for(size_t i = 0; i < length; i++) {
+        if((memory[i] | 0x20) != word[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Eisel-Lemire: multiplies the normalized significand by a truncated 128-bit power of ten,
+ * and gives up if the truncation could have affected the rounding.
+ */
+static bool ecr_scan_eisel_lemire(uint64_t significand, int exponent, uint64_t *bits) {
+    int shift = __builtin_clzll(significand);
+    significand <<= shift;
+
+    const uint64_t *power = ecr_pow10_128(exponent);
+    int binary_exponent = ((exponent * 1741647) >> 19) + 64 + 1023 - shift;
+
+    uint128_t product = (uint128_t) significand * power[0];
+    uint64_t high = product >> 64, low = product;
+
+    if((high & 0x1FF) == 0x1FF && low + significand < significand) {
+        // the low word of the power may still carry into the bits that matter
+        uint128_t extra = (uint128_t) significand * power[1];
+        uint64_t merged_high = high, merged_low = low + (uint64_t) (extra >> 64);
+        if(merged_low < low) {
+            merged_high++;
+        }
+
+        if((merged_high & 0x1FF) == 0x1FF && merged_low + 1 == 0 && (uint64_t) extra + significand < significand) {
+            return false;
+        }
+
+        high = merged_high;
+        low = merged_low;
+    }
+
+    unsigned top = high >> 63;
+    uint64_t mantissa = high >> (top + 9);
+    binary_exponent -= 1 ^ top;
+
+    if(low == 0 && (high & 0x1FF) == 0 && (mantissa & 3) == 1) {
+        // possibly exactly halfway between two doubles
+        return false;
+    }
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if(mantissa >> 53) {
+        mantissa >>= 1;
+        binary_exponent++;
+    }
+
+    if(binary_exponent <= 0 || binary_exponent >= 0x7FF) {
+        // subnormal or infinite
+        return false;
+    }
+
+    *bits = (uint64_t) binary_exponent << 52 | (mantissa & ((UINT64_C(1) << 52) - 1));
+    return true;
+}
+
+static ecr_status_t ecr_scan_parse_f64_slow(const unsigned char *memory, size_t length, double *value) {
+    pthread_once(&c_locale_once, ecr_scan_locale_init);
+    if(c_locale == (locale_t) 0) {
+        return ECR_ERROR_SYSTEM;
+    }
+
+    char copy[ECR_SCAN_NUMBER_MAX_LENGTH + 1];
+    memcpy(copy, memory, length);
+    copy[length] = '\0';
+
+    double result = strtod_l(copy, NULL, c_locale);
+    if(__builtin_isinf(result)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    *value = result;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_scan_parse_f64(const unsigned char *memory, size_t length, double *value) {
+    const unsigned char *p = memory, *end = memory + length;
+
+    bool negative = false;
+    if(p < end && (*p == '+' || *p == '-')) {
+        negative = *p++ == '-';
+    }
+
+    if(p < end && ((*p | 0x20) == 'i' || (*p | 0x20) == 'n')) {
+        if(ecr_scan_match(p, end - p, "inf") || ecr_scan_match(p, end - p, "infinity")) {
+            *value = negative ? -__builtin_inf() : __builtin_inf();
+            return ECR_SUCCESS;
+        }
+        if(ecr_scan_match(p, end - p, "nan")) {
+            *value = negative ? -__builtin_nan("") : __builtin_nan("");
+            return ECR_SUCCESS;
+        }
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    // the significand keeps the first 19 significant digits, with any further ones scaling the exponent
+    uint64_t significand = 0;
+    int digits = 0, exponent = 0;
+    bool any_digits = false, truncated = false;
+
+    for(; p < end && *p == '0'; p++) {
+        any_digits = true;
+    }
+    size_t count = ecr_scan_digits(p, end - p, SIGNIFICAND_DIGITS, &significand);
+    digits += count;
+    p += count;
+    for(; p < end && (unsigned char) (*p - '0') < 10; p++) {
+        truncated |= *p != '0';
+        exponent++;
+    }
+    any_digits |= count > 0 || exponent > 0;
+
+    if(p < end && *p == '.') {
+        p++;
+
+        const unsigned char *fraction = p;
+        if(significand == 0) {
+            for(; p < end && *p == '0'; p++) {
+                exponent--;
+            }
+        }
+        count = ecr_scan_digits(p, end - p, SIGNIFICAND_DIGITS - digits, &significand);
+        digits += count;
+        exponent -= count;
+        p += count;
+        for(; p < end && (unsigned char) (*p - '0') < 10; p++) {
+            truncated |= *p != '0';
+        }
+        any_digits |= p > fraction;
+    }
+
+    if(!any_digits) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    if(p < end && (*p | 0x20) == 'e') {
+        p++;
+
+        bool negative_exponent = false;
+        if(p < end && (*p == '+' || *p == '-')) {
+            negative_exponent = *p++ == '-';
+        }
+        if(p == end) {
+            return ECR_ERROR_INVALID_DATA;
+        }
+
+        // saturate well beyond any exponent that can matter, without overflowing
+        int explicit_exponent = 0;
+        for(; p < end && (unsigned char) (*p - '0') < 10; p++) {
+            if(explicit_exponent < 100000) {
+                explicit_exponent = explicit_exponent * 10 + (*p - '0');
+            }
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    if(p != end) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    double result;
+    if(significand == 0) {
+        result = 0.0;
+    } else if(exponent > 308) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    } else if(exponent < ECR_POW10_128_MIN) {
+        // below 10^-323 even with all 19 digits, so it rounds to zero
+        result = 0.0;
+    } else if(!truncated && significand <= UINT64_C(1) << 53 && exponent >= -22 && exponent <= 22) {
+        // both operands are exact, so one correctly rounded operation gives the answer
+        result = (double) significand;
+        result = exponent < 0 ? result / exact_pow10[-exponent] : result * exact_pow10[exponent];
+    } else {
+        uint64_t bits, bits_above;
+        bool found = ecr_scan_eisel_lemire(significand, exponent, &bits);
+        if(found && truncated) {
+            // the digits lie somewhere between the significand and the next one up, which must agree
+            found = ecr_scan_eisel_lemire(significand + 1, exponent, &bits_above) && bits == bits_above;
+        }
+
+        if(!found) {
+            return ecr_scan_parse_f64_slow(memory, length, value);
+        }
+        memcpy(&result, &bits, sizeof(result));
+    }
+
+    *value = negative ? -result : result;
+    return ECR_SUCCESS;
+}
+
+// consumes whitespace until something else is buffered
+static ecr_status_t ecr_scan_skip_space(ecr_stream_t *stream) {
+    while(true) {
+        const unsigned char *memory;
+        size_t available;
+        ECR_STATUS_GUARD(ecr_stream_buffered_fill(stream, 1, (const void **) &memory, &available));
+
+        size_t skip = ecr_scan_find_space(memory, 0, available, false);
+        if(skip == 0) {
+            return ECR_SUCCESS;
+        }
+
+        ECR_STATUS_GUARD(ecr_stream_buffered_consume(stream, skip));
+    }
+}
+
+// gets a view of the token at the start of the buffered data, reading ahead until it ends or grows past **max_length**
+static ecr_status_t ecr_scan_span(ecr_stream_t *stream, bool number, size_t max_length, const unsigned char **memory, size_t *length) {
+    ECR_STATUS_GUARD(ecr_scan_skip_space(stream));
+
+    size_t available, end = 0;
+    ECR_STATUS_GUARD(ecr_stream_buffered_fill(stream, 1, (const void **) memory, &available));
+
+    while(true) {
+        end = number ? ecr_scan_find_number_end(*memory, end, available) : ecr_scan_find_space(*memory, end, available, true);
+        if(end < available || end > max_length) {
+            break;
+        }
+
+        ecr_status_t status = ecr_stream_buffered_fill(stream, available + 1, (const void **) memory, &available);
+        if(status == ECR_ERROR_EOF) {
+            // the token runs to the end of the stream
+            break;
+        }
+        ECR_STATUS_GUARD(status);
+    }
+
+    if(end > max_length) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    *length = end;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_scan_number_span(ecr_stream_t *stream, const unsigned char **memory, size_t *length) {
+    ecr_status_t status = ecr_scan_span(stream, true, ECR_SCAN_NUMBER_MAX_LENGTH, memory, length);
+    if(status == ECR_ERROR_FULL_BUFFER || (!status && *length == 0)) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+    return status;
+}
+
+ecr_status_t ecr_stream_scan_u64(ecr_stream_t *stream, uint_least64_t *value) {
+    const unsigned char *memory;
+    size_t length;
+    ECR_STATUS_GUARD(ecr_scan_number_span(stream, &memory, &length));
+
+    size_t sign = memory[0] == '+';
+    ECR_STATUS_GUARD(ecr_scan_parse_u64(memory + sign, length - sign, value));
+
+    return ecr_stream_buffered_consume(stream, length);
+}
+
+ecr_status_t ecr_stream_scan_i64(ecr_stream_t *stream, int_least64_t *value) {
+    const unsigned char *memory;
+    size_t length;
+    ECR_STATUS_GUARD(ecr_scan_number_span(stream, &memory, &length));
+
+    bool negative = memory[0] == '-';
+    size_t sign = negative || memory[0] == '+';
+
+    uint_least64_t magnitude;
+    ECR_STATUS_GUARD(ecr_scan_parse_u64(memory + sign, length - sign, &magnitude));
+    if(magnitude > (uint_least64_t) INT_LEAST64_MAX + negative) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    *value = negative ? -(int_least64_t) (magnitude - 1) - 1 : (int_least64_t) magnitude;
+    return ecr_stream_buffered_consume(stream, length);
+}
+
+ecr_status_t ecr_stream_scan_f64(ecr_stream_t *stream, double *value) {
+    const unsigned char *memory;
+    size_t length;
+    ECR_STATUS_GUARD(ecr_scan_number_span(stream, &memory, &length));
+
+    ECR_STATUS_GUARD(ecr_scan_parse_f64(memory, length, value));
+
+    return ecr_stream_buffered_consume(stream, length);
+}
+
+ecr_status_t ecr_stream_scan_token(ecr_stream_t *stream, size_t max_length, const char **token, size_t *length) {
+    const unsigned char *memory;
+    ECR_STATUS_GUARD(ecr_scan_span(stream, false, max_length, &memory, length));
+
+    ECR_STATUS_GUARD(ecr_stream_buffered_consume(stream, *length));
+
+    *token = (const char *) memory;
+    return ECR_SUCCESS;
+}
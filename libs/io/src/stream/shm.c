@@ -0,0 +1,269 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdatomic.h>
+#include <stdckdint.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ecr/allocator.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/file.h"
+#include "ecr/stream/shm.h"
+
+#include "ring.h"
+
+#define SHM_MAGIC 0x65637272
+
+#define SHM_MODE_FLAGS (ECR_FILEMODE_ACCESS_MODE_RDWR_MASK | ECR_FILEMODE_CREATE | ECR_FILEMODE_NONBLOCK)
+
+struct ecr_stream_shm_header {
+    struct ecr_ring ring;
+    _Atomic uint32_t magic;
+};
+
+struct ecr_stream_shm {
+    ecr_allocator_t *allocator;
+    int fd;
+    bool blocking;
+
+    void *mapping;
+    size_t mapping_size, header_size;
+
+    bool unlink;
+    char name[];
+};
+
+static struct ecr_ring * ecr_stream_shm_ring(struct ecr_stream_shm *shm) {
+    return &((struct ecr_stream_shm_header *) shm->mapping)->ring;
+}
+
+static ecr_status_t ecr_stream_shm_readbuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_shm *shm = data;
+    return ecr_ring_readbuf(ecr_stream_shm_ring(shm), shm->mapping + shm->header_size, buffer, shm->blocking, true);
+}
+
+static ecr_status_t ecr_stream_shm_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_shm *shm = data;
+    return ecr_ring_writebuf(ecr_stream_shm_ring(shm), shm->mapping + shm->header_size, buffer, shm->blocking, true);
+}
+
+static ecr_status_t ecr_stream_shm_unsupported(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_shm_release(struct ecr_stream_shm *shm, uint32_t side) {
+    ecr_status_t status = ECR_SUCCESS;
+
+    ecr_ring_close(ecr_stream_shm_ring(shm), side, true);
+    if(munmap(shm->mapping, shm->mapping_size)) {
+        status = ecr_get_system_error();
+    }
+    if(close(shm->fd) && !status) {
+        status = ecr_get_system_error();
+    }
+    if(shm->unlink && shm_unlink(shm->name) && !status) {
+        status = ecr_get_system_error();
+    }
+
+    ecr_status_t free_status = ecr_free(shm->allocator, shm);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_shm_close_reader(void *data) {
+    return ecr_stream_shm_release(data, ECR_RING_READER_CLOSED);
+}
+
+static ecr_status_t ecr_stream_shm_close_writer(void *data) {
+    return ecr_stream_shm_release(data, ECR_RING_WRITER_CLOSED);
+}
+
+static ecr_status_t ecr_stream_shm_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_shm_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static size_t ecr_stream_shm_header_size() {
+    size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+    return (sizeof(struct ecr_stream_shm_header) + page_size - 1) / page_size * page_size;
+}
+
+static ecr_status_t ecr_stream_shm_map(struct ecr_stream_shm *shm, size_t capacity, bool create) {
+    shm->header_size = ecr_stream_shm_header_size();
+
+    if(create) {
+        size_t ring_capacity = 1;
+        while(ring_capacity < capacity) {
+            if(ckd_mul(&ring_capacity, ring_capacity, 2)) {
+                return ECR_ERROR_TYPE_OVERFLOW;
+            }
+        }
+
+        off_t size;
+        if(ckd_add(&shm->mapping_size, shm->header_size, ring_capacity) || ckd_add(&size, 0, shm->mapping_size)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+        if(ftruncate(shm->fd, size)) {
+            return ecr_get_system_error();
+        }
+    } else {
+        struct stat file_status;
+        if(fstat(shm->fd, &file_status)) {
+            return ecr_get_system_error();
+        }
+        if(file_status.st_size < (off_t) shm->header_size) {
+            return ECR_ERROR_AGAIN;
+        }
+
+        shm->mapping_size = (size_t) file_status.st_size;
+    }
+
+    void *mapping = mmap(NULL, shm->mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, shm->fd, 0);
+    if(mapping == MAP_FAILED) {
+        return ecr_get_system_error();
+    }
+
+    struct ecr_stream_shm_header *header = mapping;
+    if(create) {
+        ecr_ring_init(&header->ring, shm->mapping_size - shm->header_size);
+        atomic_store_explicit(&header->magic, SHM_MAGIC, memory_order_release);
+    } else {
+        ecr_status_t status = ECR_SUCCESS;
+        if(atomic_load_explicit(&header->magic, memory_order_acquire) != SHM_MAGIC) {
+            status = ECR_ERROR_AGAIN;
+        } else {
+            uint64_t ring_capacity = header->ring.capacity;
+            if(ring_capacity == 0 || (ring_capacity & (ring_capacity - 1)) || ring_capacity > shm->mapping_size - shm->header_size) {
+                status = ECR_ERROR_IO;
+            }
+        }
+
+        ECR_STATUS_GUARD_WITH_DESTRUCTOR(status, { munmap(mapping, shm->mapping_size); });
+    }
+
+    shm->mapping = mapping;
+    return ECR_SUCCESS;
+}
+
+static bool ecr_stream_shm_valid_mode(ecr_filemode_t mode_flags) {
+    ecr_filemode_t access_mode = mode_flags & ECR_FILEMODE_ACCESS_MODE_RDWR_MASK;
+    if(access_mode != ECR_FILEMODE_READ_ONLY && access_mode != ECR_FILEMODE_WRITE_ONLY) {
+        return false;
+    }
+
+    return !(mode_flags & ~SHM_MODE_FLAGS);
+}
+
+static ecr_status_t ecr_stream_shm_open(ecr_stream_t *stream, int fd, const char *unlink_name, ecr_filemode_t mode_flags, size_t capacity, ecr_allocator_t *allocator) {
+    size_t name_size = unlink_name ? strlen(unlink_name) + 1 : 0;
+
+    struct ecr_stream_shm *shm;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &shm, sizeof(*shm) + name_size));
+
+    shm->allocator = allocator;
+    shm->fd = fd;
+    shm->blocking = !(mode_flags & ECR_FILEMODE_NONBLOCK);
+    shm->unlink = unlink_name;
+    if(unlink_name) {
+        memcpy(shm->name, unlink_name, name_size);
+    }
+
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_stream_shm_map(shm, capacity, mode_flags & ECR_FILEMODE_CREATE), {
+        ecr_free(allocator, shm);
+    });
+
+    stream->version = 0;
+    stream->data = shm;
+
+    if((mode_flags & ECR_FILEMODE_ACCESS_MODE_RDWR_MASK) == ECR_FILEMODE_READ_ONLY) {
+        stream->readbuf  = ecr_stream_shm_readbuf;
+        stream->writebuf = ecr_stream_shm_unsupported;
+        stream->close    = ecr_stream_shm_close_reader;
+    } else {
+        stream->readbuf  = ecr_stream_shm_unsupported;
+        stream->writebuf = ecr_stream_shm_writebuf;
+        stream->close    = ecr_stream_shm_close_writer;
+    }
+    stream->getpos   = ecr_stream_shm_getpos;
+    stream->setpos   = ecr_stream_shm_setpos;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_open_shm(ecr_stream_t *stream, const char *name, ecr_filemode_t mode_flags, size_t capacity, ecr_allocator_t *allocator) {
+    if(!ecr_stream_shm_valid_mode(mode_flags)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    bool create = mode_flags & ECR_FILEMODE_CREATE;
+
+    int fd;
+    if(name) {
+        fd = shm_open(name, create ? O_RDWR | O_CREAT | O_EXCL : O_RDWR, 0600);
+    } else if(create) {
+        fd = memfd_create("ecr-shm", MFD_CLOEXEC);
+    } else {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+    if(fd < 0) {
+        return ecr_get_system_error();
+    }
+
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_stream_shm_open(stream, fd, create ? name : NULL, mode_flags, capacity, allocator), {
+        close(fd);
+        if(name && create) {
+            shm_unlink(name);
+        }
+    });
+
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_open_shm_fd(ecr_stream_t *stream, int fd, ecr_filemode_t mode_flags, ecr_allocator_t *allocator) {
+    if(!ecr_stream_shm_valid_mode(mode_flags) || (mode_flags & ECR_FILEMODE_CREATE)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+    if(fd < 0) {
+        return ecr_get_system_error();
+    }
+
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_stream_shm_open(stream, fd, NULL, mode_flags, 0, allocator), { close(fd); });
+
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_shm_fd(ecr_stream_t *stream, int *fd) {
+    if(stream->close != ecr_stream_shm_close_reader && stream->close != ecr_stream_shm_close_writer) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    *fd = ((struct ecr_stream_shm *) stream->data)->fd;
+    return ECR_SUCCESS;
+}
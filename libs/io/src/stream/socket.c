@@ -0,0 +1,471 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include <linux/errqueue.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/socket.h"
+
+#include "posix.h"
+
+#define ZEROCOPY_THRESHOLD_MAX ((UINT32_C(1) << 31) - 1)
+
+/*
+ * Like file descriptor streams, socket streams keep their entire state in the stream's data pointer,
+ * with the file descriptor coming first.
+ */
+struct ecr_stream_socket {
+    int fd;
+    uint32_t corked : 1;
+    uint32_t zerocopy_threshold : 31;
+};
+static_assert(sizeof(struct ecr_stream_socket) <= sizeof(void *), "socket state must fit in a pointer");
+
+static struct ecr_stream_socket ecr_stream_socket_state(void *data) {
+    struct ecr_stream_socket socket;
+    memcpy(&socket, &data, sizeof(socket));
+    return socket;
+}
+
+static ecr_status_t ecr_stream_socket_setsockopt(int fd, int level, int name, int value) {
+    if(setsockopt(fd, level, name, &value, sizeof(value))) {
+        return ecr_get_system_error();
+    }
+
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_socket_zerocopy_wait(int fd) {
+    while(true) {
+        char control[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+        struct msghdr message = {
+            .msg_control    = control,
+            .msg_controllen = sizeof(control),
+        };
+
+        if(recvmsg(fd, &message, MSG_ERRQUEUE) < 0) {
+            if(errno != EAGAIN) {
+                return ecr_get_system_error();
+            }
+
+            struct pollfd poll_fd = { .fd = fd, .events = 0 };
+            if(poll(&poll_fd, 1, -1) < 0) {
+                return ecr_get_system_error();
+            }
+            continue;
+        }
+
+        for(struct cmsghdr *header = CMSG_FIRSTHDR(&message); header; header = CMSG_NXTHDR(&message, header)) {
+            if((header->cmsg_level == SOL_IP && header->cmsg_type == IP_RECVERR)
+                    || (header->cmsg_level == SOL_IPV6 && header->cmsg_type == IPV6_RECVERR)) {
+                struct sock_extended_err error;
+                memcpy(&error, CMSG_DATA(header), sizeof(error));
+                if(error.ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+                    return ECR_SUCCESS;
+                }
+            }
+        }
+    }
+}
+
+static ecr_status_t ecr_stream_socket_readbuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_socket socket = ecr_stream_socket_state(data);
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+    if(length > SSIZE_MAX) {
+        length = SSIZE_MAX;
+    }
+
+    ssize_t read_length = recv(socket.fd, buffer->memory + buffer->position, length, 0);
+    if(read_length < 0) {
+        return ecr_get_system_error();
+    }
+    if(read_length == 0) {
+        return ECR_ERROR_EOF;
+    }
+
+    buffer->position += (size_t) read_length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_socket_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_socket socket = ecr_stream_socket_state(data);
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+    if(length > SSIZE_MAX) {
+        length = SSIZE_MAX;
+    }
+
+    int flags = MSG_NOSIGNAL;
+    if(socket.corked) {
+        flags |= MSG_MORE;
+    }
+
+    ssize_t write_length;
+    if(socket.zerocopy_threshold && length >= socket.zerocopy_threshold) {
+        write_length = send(socket.fd, buffer->memory + buffer->position, length, flags | MSG_ZEROCOPY);
+        if(write_length >= 0) {
+            ECR_STATUS_GUARD(ecr_stream_socket_zerocopy_wait(socket.fd));
+        } else if(errno == ENOBUFS) {
+            write_length = send(socket.fd, buffer->memory + buffer->position, length, flags);
+        }
+    } else {
+        write_length = send(socket.fd, buffer->memory + buffer->position, length, flags);
+    }
+    if(write_length < 0) {
+        return ecr_get_system_error();
+    }
+
+    buffer->position += (size_t) write_length;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_socket_writev_full(ecr_stream_t *stream, struct iovec *iov, int count) {
+    struct ecr_stream_socket socket = ecr_stream_socket_state(stream->data);
+
+    int flags = MSG_NOSIGNAL;
+    if(socket.corked) {
+        flags |= MSG_MORE;
+    }
+
+    while(count > 0) {
+        size_t total = 0;
+        for(int i = 0; i < count && total < socket.zerocopy_threshold; i++) {
+            total += iov[i].iov_len;
+        }
+
+        struct msghdr message = {
+            .msg_iov    = iov,
+            .msg_iovlen = (size_t) count,
+        };
+
+        ssize_t write_length;
+        if(socket.zerocopy_threshold && total >= socket.zerocopy_threshold) {
+            write_length = sendmsg(socket.fd, &message, flags | MSG_ZEROCOPY);
+            if(write_length >= 0) {
+                ECR_STATUS_GUARD(ecr_stream_socket_zerocopy_wait(socket.fd));
+            } else if(errno == ENOBUFS) {
+                write_length = sendmsg(socket.fd, &message, flags);
+            }
+        } else {
+            write_length = sendmsg(socket.fd, &message, flags);
+        }
+        if(write_length < 0) {
+            return ecr_get_system_error();
+        }
+
+        size_t length = (size_t) write_length;
+        while(count > 0 && length >= iov->iov_len) {
+            length -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if(count > 0) {
+            iov->iov_base += length;
+            iov->iov_len -= length;
+        }
+    }
+
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_socket_close(void *data) {
+    struct ecr_stream_socket socket = ecr_stream_socket_state(data);
+    if(close(socket.fd)) {
+        return ecr_get_system_error();
+    }
+
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_socket_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_socket_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_listener_unsupported(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static void ecr_stream_from_socket_state(ecr_stream_t *stream, struct ecr_stream_socket socket) {
+    stream->version = 0;
+    stream->data = NULL;
+    memcpy(&stream->data, &socket, sizeof(socket));
+}
+
+static void ecr_stream_from_socket(ecr_stream_t *stream, int fd) {
+    ecr_stream_from_socket_state(stream, (struct ecr_stream_socket) { .fd = fd, .corked = 0, .zerocopy_threshold = 0 });
+
+    stream->readbuf  = ecr_stream_socket_readbuf;
+    stream->writebuf = ecr_stream_socket_writebuf;
+    stream->close    = ecr_stream_socket_close;
+    stream->getpos   = ecr_stream_socket_getpos;
+    stream->setpos   = ecr_stream_socket_setpos;
+}
+
+static void ecr_stream_from_listener(ecr_stream_t *stream, int fd) {
+    ecr_stream_from_socket_state(stream, (struct ecr_stream_socket) { .fd = fd, .corked = 0, .zerocopy_threshold = 0 });
+
+    stream->readbuf  = ecr_stream_listener_unsupported;
+    stream->writebuf = ecr_stream_listener_unsupported;
+    stream->close    = ecr_stream_socket_close;
+    stream->getpos   = ecr_stream_socket_getpos;
+    stream->setpos   = ecr_stream_socket_setpos;
+}
+
+bool ecr_stream_is_socket(ecr_stream_t *stream) {
+    return stream->readbuf == ecr_stream_socket_readbuf;
+}
+
+static bool ecr_stream_is_listener(ecr_stream_t *stream) {
+    return stream->readbuf == ecr_stream_listener_unsupported;
+}
+
+static ecr_status_t ecr_stream_socket_unix_address(struct sockaddr_un *address, const char *path) {
+    size_t length = strlen(path);
+    if(length >= sizeof(address->sun_path)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+    memcpy(address->sun_path, path, length + 1);
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_socket_resolve(const char *host, const char *service, int flags, struct addrinfo **addresses) {
+    struct addrinfo hints = {
+        .ai_family   = AF_UNSPEC,
+        .ai_socktype = SOCK_STREAM,
+        .ai_flags    = flags,
+    };
+
+    switch(getaddrinfo(host, service, &hints, addresses)) {
+        case 0:
+            return ECR_SUCCESS;
+        case EAI_SYSTEM:
+            return ecr_get_system_error();
+        case EAI_AGAIN:
+            return ECR_ERROR_AGAIN;
+        default:
+            return ECR_ERROR_INVALID_ARGUMENT;
+    }
+}
+
+ecr_status_t ecr_stream_connect_unix(ecr_stream_t *stream, const char *path) {
+    struct sockaddr_un address;
+    ECR_STATUS_GUARD(ecr_stream_socket_unix_address(&address, path));
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(fd < 0) {
+        return ecr_get_system_error();
+    }
+
+    if(connect(fd, (struct sockaddr *) &address, sizeof(address))) {
+        ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_get_system_error(), { close(fd); });
+    }
+
+    ecr_stream_from_socket(stream, fd);
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_connect_tcp(ecr_stream_t *stream, const char *host, const char *service) {
+    struct addrinfo *addresses;
+    ECR_STATUS_GUARD(ecr_stream_socket_resolve(host, service, 0, &addresses));
+
+    ecr_status_t status = ECR_ERROR_INVALID_ARGUMENT;
+    int fd = -1;
+    for(struct addrinfo *address = addresses; address; address = address->ai_next) {
+        fd = socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if(fd < 0) {
+            status = ecr_get_system_error();
+            continue;
+        }
+
+        if(!connect(fd, address->ai_addr, address->ai_addrlen)) {
+            status = ECR_SUCCESS;
+            break;
+        }
+
+        status = ecr_get_system_error();
+        close(fd);
+    }
+
+    freeaddrinfo(addresses);
+    ECR_STATUS_GUARD(status);
+
+    ecr_stream_from_socket(stream, fd);
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_listen_unix(ecr_stream_t *listener, const char *path, int backlog) {
+    struct sockaddr_un address;
+    ECR_STATUS_GUARD(ecr_stream_socket_unix_address(&address, path));
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(fd < 0) {
+        return ecr_get_system_error();
+    }
+
+    if(bind(fd, (struct sockaddr *) &address, sizeof(address)) || listen(fd, backlog)) {
+        ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_get_system_error(), { close(fd); });
+    }
+
+    ecr_stream_from_listener(listener, fd);
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_listen_tcp(ecr_stream_t *listener, const char *host, const char *service, int backlog) {
+    struct addrinfo *addresses;
+    ECR_STATUS_GUARD(ecr_stream_socket_resolve(host, service, AI_PASSIVE, &addresses));
+
+    ecr_status_t status = ECR_ERROR_INVALID_ARGUMENT;
+    int fd = -1;
+    for(struct addrinfo *address = addresses; address; address = address->ai_next) {
+        fd = socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if(fd < 0) {
+            status = ecr_get_system_error();
+            continue;
+        }
+
+        status = ecr_stream_socket_setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, 1);
+        if(!status && !bind(fd, address->ai_addr, address->ai_addrlen) && !listen(fd, backlog)) {
+            break;
+        }
+
+        if(!status) {
+            status = ecr_get_system_error();
+        }
+        close(fd);
+    }
+
+    freeaddrinfo(addresses);
+    ECR_STATUS_GUARD(status);
+
+    ecr_stream_from_listener(listener, fd);
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_accept(ecr_stream_t *listener, ecr_stream_t *stream) {
+    if(!ecr_stream_is_listener(listener)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    int fd = accept4(ecr_stream_socket_state(listener->data).fd, NULL, NULL, SOCK_CLOEXEC);
+    if(fd < 0) {
+        return ecr_get_system_error();
+    }
+
+    ecr_stream_from_socket(stream, fd);
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_socket_set_option(ecr_stream_t *stream, ecr_socket_option_t option, uint_least32_t value) {
+    if(!ecr_stream_is_socket(stream) && !ecr_stream_is_listener(stream)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_socket socket = ecr_stream_socket_state(stream->data);
+    int size = value > INT_MAX ? INT_MAX : (int) value;
+
+    switch(option) {
+        case ECR_SOCKET_NODELAY:
+            ECR_STATUS_GUARD(ecr_stream_socket_setsockopt(socket.fd, IPPROTO_TCP, TCP_NODELAY, value != 0));
+            break;
+        case ECR_SOCKET_CORK:
+            ECR_STATUS_GUARD(ecr_stream_socket_setsockopt(socket.fd, IPPROTO_TCP, TCP_CORK, value != 0));
+            socket.corked = value != 0;
+            break;
+        case ECR_SOCKET_RCVBUF:
+            ECR_STATUS_GUARD(ecr_stream_socket_setsockopt(socket.fd, SOL_SOCKET, SO_RCVBUF, size));
+            break;
+        case ECR_SOCKET_SNDBUF:
+            ECR_STATUS_GUARD(ecr_stream_socket_setsockopt(socket.fd, SOL_SOCKET, SO_SNDBUF, size));
+            break;
+        case ECR_SOCKET_ZEROCOPY:
+            if(value) {
+                ECR_STATUS_GUARD(ecr_stream_socket_setsockopt(socket.fd, SOL_SOCKET, SO_ZEROCOPY, 1));
+            }
+            socket.zerocopy_threshold = value > ZEROCOPY_THRESHOLD_MAX ? ZEROCOPY_THRESHOLD_MAX : value;
+            break;
+        default:
+            return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    ecr_stream_from_socket_state(stream, socket);
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_socket_flush(ecr_stream_t *stream) {
+    if(!ecr_stream_is_socket(stream)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_socket socket = ecr_stream_socket_state(stream->data);
+    if(!socket.corked) {
+        return ECR_SUCCESS;
+    }
+
+    ECR_STATUS_GUARD(ecr_stream_socket_setsockopt(socket.fd, IPPROTO_TCP, TCP_CORK, 0));
+    return ecr_stream_socket_setsockopt(socket.fd, IPPROTO_TCP, TCP_CORK, 1);
+}
+
+ecr_status_t ecr_stream_socket_local_port(ecr_stream_t *stream, uint_least16_t *port) {
+    if(!ecr_stream_is_socket(stream) && !ecr_stream_is_listener(stream)) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct sockaddr_storage address;
+    socklen_t address_length = sizeof(address);
+    if(getsockname(ecr_stream_socket_state(stream->data).fd, (struct sockaddr *) &address, &address_length)) {
+        return ecr_get_system_error();
+    }
+
+    switch(address.ss_family) {
+        case AF_INET:
+            *port = ntohs(((struct sockaddr_in *) &address)->sin_port);
+            return ECR_SUCCESS;
+        case AF_INET6:
+            *port = ntohs(((struct sockaddr_in6 *) &address)->sin6_port);
+            return ECR_SUCCESS;
+        default:
+            return ECR_ERROR_NOT_SUPPORTED;
+    }
+}
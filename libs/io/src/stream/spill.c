@@ -0,0 +1,300 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdckdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ecr/allocator.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/spill.h"
+
+#define SPILL_MIN_CAPACITY 4096
+
+struct ecr_stream_spill {
+    ecr_allocator_t *allocator;
+    size_t threshold;
+
+    void *memory;
+    size_t capacity;
+
+    int fd;
+    ecr_stream_pos_t position, size;
+};
+
+static ecr_status_t ecr_stream_spill_pwrite_full(int fd, const void *memory, size_t length) {
+    off_t offset = 0;
+    while(length > 0) {
+        size_t chunk = length;
+        if(chunk > SSIZE_MAX) {
+            chunk = SSIZE_MAX;
+        }
+
+        ssize_t write_length = pwrite(fd, memory, chunk, offset);
+        if(write_length < 0) {
+            return ecr_get_system_error();
+        }
+
+        memory += write_length;
+        length -= (size_t) write_length;
+        offset += write_length;
+    }
+
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_spill_to_file(struct ecr_stream_spill *spill) {
+    int fd = memfd_create("ecr-spill", MFD_CLOEXEC);
+    if(fd < 0) {
+        fd = open(P_tmpdir, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+    }
+    if(fd < 0) {
+        return ecr_get_system_error();
+    }
+
+    ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_stream_spill_pwrite_full(fd, spill->memory, spill->size), { close(fd); });
+
+    if(spill->memory) {
+        ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_free(spill->allocator, spill->memory), { close(fd); });
+    }
+
+    spill->memory = NULL;
+    spill->capacity = 0;
+    spill->fd = fd;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_spill_reserve(struct ecr_stream_spill *spill, size_t capacity) {
+    size_t new_capacity = spill->capacity < SPILL_MIN_CAPACITY ? SPILL_MIN_CAPACITY : spill->capacity;
+    while(new_capacity < capacity) {
+        if(ckd_mul(&new_capacity, new_capacity, 2)) {
+            new_capacity = capacity;
+        }
+    }
+    if(new_capacity > spill->threshold) {
+        new_capacity = spill->threshold;
+    }
+
+    void *memory;
+    ECR_STATUS_GUARD(ecr_allocate(spill->allocator, &memory, new_capacity));
+
+    if(spill->memory) {
+        memcpy(memory, spill->memory, spill->size);
+        ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_free(spill->allocator, spill->memory), { ecr_free(spill->allocator, memory); });
+    }
+
+    spill->memory = memory;
+    spill->capacity = new_capacity;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_spill_readbuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_spill *spill = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+    if(spill->position >= spill->size) {
+        return ECR_ERROR_EOF;
+    }
+
+    if(spill->fd < 0) {
+        if(length > spill->size - spill->position) {
+            length = spill->size - spill->position;
+        }
+
+        memcpy(buffer->memory + buffer->position, spill->memory + spill->position, length);
+    } else {
+        off_t offset;
+        if(ckd_add(&offset, 0, spill->position)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+        if(length > SSIZE_MAX) {
+            length = SSIZE_MAX;
+        }
+
+        ssize_t read_length = pread(spill->fd, buffer->memory + buffer->position, length, offset);
+        if(read_length < 0) {
+            return ecr_get_system_error();
+        }
+        if(read_length == 0) {
+            return ECR_ERROR_EOF;
+        }
+
+        length = (size_t) read_length;
+    }
+
+    spill->position += length;
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_spill_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_spill *spill = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ecr_stream_pos_t end;
+    if(ckd_add(&end, spill->position, length)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    if(spill->fd < 0 && end > spill->threshold) {
+        ECR_STATUS_GUARD(ecr_stream_spill_to_file(spill));
+    }
+
+    if(spill->fd < 0) {
+        if(end > spill->capacity) {
+            ECR_STATUS_GUARD(ecr_stream_spill_reserve(spill, end));
+        }
+        if(spill->position > spill->size) {
+            memset(spill->memory + spill->size, 0, spill->position - spill->size);
+        }
+
+        memcpy(spill->memory + spill->position, buffer->memory + buffer->position, length);
+    } else {
+        off_t offset;
+        if(ckd_add(&offset, 0, spill->position)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+        if(length > SSIZE_MAX) {
+            length = SSIZE_MAX;
+        }
+
+        ssize_t write_length = pwrite(spill->fd, buffer->memory + buffer->position, length, offset);
+        if(write_length < 0) {
+            return ecr_get_system_error();
+        }
+
+        length = (size_t) write_length;
+    }
+
+    spill->position += length;
+    if(spill->position > spill->size) {
+        spill->size = spill->position;
+    }
+
+    buffer->position += length;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_spill_close(void *data) {
+    struct ecr_stream_spill *spill = data;
+    ecr_status_t status = ECR_SUCCESS;
+
+    if(spill->fd >= 0 && close(spill->fd)) {
+        status = ecr_get_system_error();
+    }
+    if(spill->memory) {
+        ecr_status_t free_status = ecr_free(spill->allocator, spill->memory);
+        if(!status) {
+            status = free_status;
+        }
+    }
+
+    ecr_status_t free_status = ecr_free(spill->allocator, spill);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_spill_getpos(void *data, ecr_stream_pos_t *restrict position_ptr) {
+    struct ecr_stream_spill *spill = data;
+
+    *position_ptr = spill->position;
+    return ECR_SUCCESS;
+}
+
+static ecr_status_t ecr_stream_spill_setpos(void *data, ecr_stream_pos_t *restrict position_ptr, ecr_stream_dir_t direction) {
+    struct ecr_stream_spill *spill = data;
+
+    ecr_stream_pos_t base;
+    if(direction & (1 << 1)) {
+        if(direction & ECR_STREAM_DIR_REWIND) {
+            base = spill->size;
+        } else {
+            base = 0;
+        }
+    } else {
+        base = spill->position;
+    }
+
+    ecr_stream_pos_t position;
+    if(direction & ECR_STREAM_DIR_REWIND) {
+        if(ckd_sub(&position, base, *position_ptr)) {
+            return ECR_ERROR_INVALID_ARGUMENT;
+        }
+    } else {
+        if(ckd_add(&position, base, *position_ptr)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+    }
+
+    spill->position = position;
+    *position_ptr = position;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_open_spill(ecr_stream_t *stream, ecr_allocator_t *allocator, size_t threshold) {
+    struct ecr_stream_spill *spill;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &spill, sizeof(*spill)));
+
+    *spill = (struct ecr_stream_spill) {
+        .allocator = allocator,
+        .threshold = threshold,
+        .memory    = NULL,
+        .capacity  = 0,
+        .fd        = -1,
+        .position  = 0,
+        .size      = 0,
+    };
+
+    stream->version = 0;
+    stream->data = spill;
+
+    stream->readbuf  = ecr_stream_spill_readbuf;
+    stream->writebuf = ecr_stream_spill_writebuf;
+    stream->close    = ecr_stream_spill_close;
+    stream->getpos   = ecr_stream_spill_getpos;
+    stream->setpos   = ecr_stream_spill_setpos;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_spill_fd(ecr_stream_t *stream, int *fd) {
+    if(stream->close != ecr_stream_spill_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_spill *spill = stream->data;
+    if(spill->fd < 0) {
+        ECR_STATUS_GUARD(ecr_stream_spill_to_file(spill));
+    }
+
+    *fd = spill->fd;
+    return ECR_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdckdint.h>
+#include <stdint.h>
+
+#include "ecr/allocator.h"
+#include "ecr/buffer.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/concurrent.h"
+#include "ecr/stream/tee.h"
+
+struct ecr_stream_tee_target {
+    ecr_stream_t *stream;
+    ecr_stream_t queue;
+    bool async;
+
+    uint_least64_t written;
+};
+
+struct ecr_stream_tee {
+    ecr_allocator_t *allocator;
+    uint_least64_t written;
+
+    size_t count;
+    struct ecr_stream_tee_target targets[];
+};
+
+static ecr_status_t ecr_stream_tee_readbuf(void *, ecr_buffer_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_tee_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_tee *tee = data;
+
+    size_t length = buffer->length - buffer->position;
+    if(length <= 0) {
+        return ECR_ERROR_FULL_BUFFER;
+    }
+
+    ecr_status_t status = ECR_SUCCESS;
+    uint_least64_t written = UINT_LEAST64_MAX;
+    for(size_t i = 0; i < tee->count; i++) {
+        struct ecr_stream_tee_target *target = &tee->targets[i];
+
+        // a child may already hold part of this data from a write which failed on another child
+        ecr_buffer_t view = {
+            .memory = buffer->memory + buffer->position,
+            .capacity = length,
+            .length = length,
+            .position = target->written - tee->written,
+        };
+
+        while(view.position < view.length) {
+            size_t position = view.position;
+            ecr_status_t write_status = ecr_stream_writebuf(target->async ? &target->queue : target->stream, &view);
+            target->written += view.position - position;
+
+            if(write_status) {
+                if(!status) {
+                    status = write_status;
+                }
+                break;
+            }
+        }
+
+        if(target->written < written) {
+            written = target->written;
+        }
+    }
+
+    if(tee->count > 0) {
+        buffer->position += written - tee->written;
+        tee->written = written;
+    } else {
+        buffer->position = buffer->length;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_tee_free(struct ecr_stream_tee *tee, size_t count) {
+    ecr_status_t status = ECR_SUCCESS;
+    for(size_t i = 0; i < count; i++) {
+        if(tee->targets[i].async) {
+            ecr_status_t close_status = ecr_stream_close(&tee->targets[i].queue);
+            if(!status) {
+                status = close_status;
+            }
+        }
+    }
+
+    ecr_status_t free_status = ecr_free(tee->allocator, tee);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_tee_close(void *data) {
+    struct ecr_stream_tee *tee = data;
+    return ecr_stream_tee_free(tee, tee->count);
+}
+
+static ecr_status_t ecr_stream_tee_getpos(void *, ecr_stream_pos_t *restrict) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+static ecr_status_t ecr_stream_tee_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_tee(ecr_stream_t *stream, const ecr_stream_tee_child_t *children, size_t count, ecr_allocator_t *allocator) {
+    size_t size;
+    if(ckd_mul(&size, sizeof(struct ecr_stream_tee_target), count) || ckd_add(&size, size, sizeof(struct ecr_stream_tee))) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    struct ecr_stream_tee *tee;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &tee, size));
+    tee->allocator = allocator;
+    tee->written = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        struct ecr_stream_tee_target *target = &tee->targets[i];
+        target->stream = children[i].stream;
+        target->async = false;
+        target->written = 0;
+
+        if(children[i].async) {
+            ECR_STATUS_GUARD_WITH_DESTRUCTOR(ecr_stream_open_concurrent(&target->queue, target->stream, allocator), {
+                ecr_stream_tee_free(tee, i);
+            });
+            target->async = true;
+        }
+    }
+    tee->count = count;
+
+    stream->version = 0;
+    stream->data = tee;
+
+    stream->readbuf  = ecr_stream_tee_readbuf;
+    stream->writebuf = ecr_stream_tee_writebuf;
+    stream->close    = ecr_stream_tee_close;
+    stream->getpos   = ecr_stream_tee_getpos;
+    stream->setpos   = ecr_stream_tee_setpos;
+    return ECR_SUCCESS;
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ecr/allocator.h"
+#include "ecr/buffer.h"
+#include "ecr/error.h"
+#include "ecr/stream.h"
+#include "ecr/stream/utf8.h"
+
+struct ecr_utf8_state {
+    // number of continuation bytes still expected, and the range the next one must fall in
+    uint32_t need;
+    unsigned char lower, upper;
+
+    uint_least64_t offset, sequence_start;
+};
+
+struct ecr_stream_utf8 {
+    ecr_stream_t *inner;
+    ecr_allocator_t *allocator;
+
+    struct ecr_utf8_state state;
+    bool invalid;
+};
+
+static size_t utf8_ascii_prefix(const unsigned char *memory, size_t length) {
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for(; i + 16 <= length; i += 16) {
+        int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) (memory + i)));
+        if(mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#else
+    for(; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, memory + i, sizeof(word));
+        if(word & 0x8080808080808080) {
+            break;
+        }
+    }
+#endif
+
+    while(i < length && memory[i] < 0x80) {
+        i++;
+    }
+
+    return i;
+}
+
+static bool utf8_validate(struct ecr_utf8_state *state, const unsigned char *memory, size_t length) {
+    for(size_t i = 0; i < length; i++) {
+        unsigned char byte = memory[i];
+
+        if(state->need > 0) {
+            if(byte < state->lower || byte > state->upper) {
+                return false;
+            }
+
+            state->need--;
+            state->lower = 0x80;
+            state->upper = 0xBF;
+            continue;
+        }
+
+        // most text is mostly ASCII, so skip over runs of it a vector at a time
+        i += utf8_ascii_prefix(memory + i, length - i);
+        if(i == length) {
+            break;
+        }
+
+        byte = memory[i];
+        state->sequence_start = state->offset + i;
+
+        state->lower = 0x80;
+        state->upper = 0xBF;
+        if(byte < 0xC2) {
+            // stray continuation byte or overlong 2-byte sequence
+            return false;
+        } else if(byte < 0xE0) {
+            state->need = 1;
+        } else if(byte < 0xF0) {
+            state->need = 2;
+            if(byte == 0xE0) {
+                state->lower = 0xA0;
+            } else if(byte == 0xED) {
+                state->upper = 0x9F;
+            }
+        } else if(byte < 0xF5) {
+            state->need = 3;
+            if(byte == 0xF0) {
+                state->lower = 0x90;
+            } else if(byte == 0xF4) {
+                state->upper = 0x8F;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    state->offset += length;
+    return true;
+}
+
+static ecr_status_t ecr_stream_utf8_readbuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_utf8 *utf8 = data;
+
+    if(utf8->invalid) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    size_t position = buffer->position;
+    ecr_status_t status = ecr_stream_readbuf(utf8->inner, buffer);
+
+    uint_least64_t offset = utf8->state.offset;
+    if(!utf8_validate(&utf8->state, buffer->memory + position, buffer->position - position)) {
+        utf8->invalid = true;
+    } else if(status == ECR_ERROR_EOF && utf8->state.need > 0) {
+        utf8->invalid = true;
+    }
+
+    if(utf8->invalid) {
+        // hold back the invalid sequence, and anything read after it
+        if(utf8->state.sequence_start > offset) {
+            buffer->position = position + (utf8->state.sequence_start - offset);
+        } else {
+            buffer->position = position;
+        }
+
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_utf8_writebuf(void *data, ecr_buffer_t *restrict buffer) {
+    struct ecr_stream_utf8 *utf8 = data;
+
+    if(utf8->invalid) {
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    size_t position = buffer->position;
+    size_t length = buffer->length - buffer->position;
+
+    struct ecr_utf8_state state = utf8->state;
+    if(!utf8_validate(&state, buffer->memory + position, length)) {
+        utf8->state = state;
+        utf8->invalid = true;
+        return ECR_ERROR_INVALID_DATA;
+    }
+
+    ecr_status_t status = ecr_stream_writebuf(utf8->inner, buffer);
+
+    if(buffer->position - position == length) {
+        utf8->state = state;
+    } else {
+        // the data has already been found valid, so revalidating only what was written just moves the state along
+        utf8_validate(&utf8->state, buffer->memory + position, buffer->position - position);
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_utf8_close(void *data) {
+    struct ecr_stream_utf8 *utf8 = data;
+
+    ecr_status_t status = ECR_SUCCESS;
+    if(utf8->invalid || utf8->state.need > 0) {
+        status = ECR_ERROR_INVALID_DATA;
+    }
+
+    ecr_status_t free_status = ecr_free(utf8->allocator, utf8);
+    if(!status) {
+        status = free_status;
+    }
+
+    return status;
+}
+
+static ecr_status_t ecr_stream_utf8_getpos(void *data, ecr_stream_pos_t *restrict position) {
+    struct ecr_stream_utf8 *utf8 = data;
+    return ecr_stream_getpos(utf8->inner, position);
+}
+
+static ecr_status_t ecr_stream_utf8_setpos(void *, ecr_stream_pos_t *restrict, ecr_stream_dir_t) {
+    return ECR_ERROR_NOT_SUPPORTED;
+}
+
+ecr_status_t ecr_stream_open_utf8(ecr_stream_t *stream, ecr_stream_t *inner, ecr_allocator_t *allocator) {
+    struct ecr_stream_utf8 *utf8;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, (void **) &utf8, sizeof(*utf8)));
+
+    utf8->inner = inner;
+    utf8->allocator = allocator;
+    utf8->state = (struct ecr_utf8_state) { .need = 0, .lower = 0x80, .upper = 0xBF };
+    utf8->invalid = false;
+
+    stream->version = 0;
+    stream->data = utf8;
+
+    stream->readbuf  = ecr_stream_utf8_readbuf;
+    stream->writebuf = ecr_stream_utf8_writebuf;
+    stream->close    = ecr_stream_utf8_close;
+    stream->getpos   = ecr_stream_utf8_getpos;
+    stream->setpos   = ecr_stream_utf8_setpos;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_stream_utf8_error(ecr_stream_t *stream, uint_least64_t *offset) {
+    if(stream->close != ecr_stream_utf8_close) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    struct ecr_stream_utf8 *utf8 = stream->data;
+    if(!utf8->invalid) {
+        return ECR_SUCCESS;
+    }
+
+    *offset = utf8->state.sequence_start;
+    return ECR_ERROR_INVALID_DATA;
+}
@@ -64,11 +64,16 @@ const char * ecr_status_string(ecr_status_t status) {
             return "operation not supported";
         case ECR_ERROR_INVALID_ARGUMENT:
             return "invalid argument provided";
+
+        case ECR_ERROR_INVALID_DATA:
+            return "invalid or corrupt data";
         
         case ECR_ERROR_IO:
             return "i/o error";
         case ECR_ERROR_EOF:
             return "end of stream reached";
+        case ECR_ERROR_AGAIN:
+            return "operation would block";
 
         default:
             return UNKNOWN_STATUS_STRING;
@@ -89,6 +94,8 @@ ecr_status_t ecr_get_system_error() {
             return ECR_ERROR_FULL_BUFFER;
         case EOVERFLOW:
             return ECR_ERROR_TYPE_OVERFLOW;
+        case EAGAIN:
+            return ECR_ERROR_AGAIN;
     }
 
     return ECR_ERROR_SYSTEM;
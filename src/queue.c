@@ -0,0 +1,278 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <stdckdint.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ecr/allocator.h"
+#include "ecr/error.h"
+#include "ecr/macro/guards.h"
+#include "ecr/queue.h"
+
+#include "futex.h"
+
+// a producer's slot is ready when its sequence equals its position, a consumer's when it's one past
+#define PUSH_READY 0
+#define POP_READY  1
+
+// set in the head once the queue is closed, so that no producer can claim slots afterwards
+#define HEAD_CLOSED (SIZE_MAX - SIZE_MAX / 2)
+
+static _Atomic(size_t) * ecr_queue_sequence(ecr_queue_t *queue, size_t position) {
+    return queue->slots + (position & queue->mask) * queue->slot_size;
+}
+
+static void * ecr_queue_element(ecr_queue_t *queue, size_t position) {
+    return queue->slots + (position & queue->mask) * queue->slot_size + queue->element_offset;
+}
+
+static size_t ecr_queue_element_alignment(size_t element_size) {
+    size_t alignment = element_size & -element_size;
+    return alignment < 16 ? alignment : 16;
+}
+
+ecr_status_t ecr_queue_init(ecr_queue_t *queue, ecr_allocator_t *allocator, size_t element_size, size_t capacity) {
+    if(element_size == 0 || capacity == 0) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t slots = 2;
+    while(slots < capacity) {
+        if(ckd_mul(&slots, slots, 2)) {
+            return ECR_ERROR_TYPE_OVERFLOW;
+        }
+    }
+
+    size_t element_offset = sizeof(size_t);
+    if(element_offset < ecr_queue_element_alignment(element_size)) {
+        element_offset = ecr_queue_element_alignment(element_size);
+    }
+
+    size_t slot_size, storage_size;
+    if(ckd_add(&slot_size, element_offset + ECR_QUEUE_CACHE_LINE_SIZE - 1, element_size) || ckd_mul(&storage_size, slots, slot_size & -ECR_QUEUE_CACHE_LINE_SIZE) || ckd_add(&storage_size, storage_size, ECR_QUEUE_CACHE_LINE_SIZE - 1)) {
+        return ECR_ERROR_TYPE_OVERFLOW;
+    }
+
+    void *storage;
+    ECR_STATUS_GUARD(ecr_allocate(allocator, &storage, storage_size));
+
+    queue->allocator      = allocator;
+    queue->storage        = storage;
+    queue->slots          = (void *) (((uintptr_t) storage + ECR_QUEUE_CACHE_LINE_SIZE - 1) & -(uintptr_t) ECR_QUEUE_CACHE_LINE_SIZE);
+    queue->element_size   = element_size;
+    queue->element_offset = element_offset;
+    queue->slot_size      = slot_size & -ECR_QUEUE_CACHE_LINE_SIZE;
+    queue->mask           = slots - 1;
+
+    for(size_t i = 0; i < slots; i++) {
+        atomic_init(ecr_queue_sequence(queue, i), i);
+    }
+
+    atomic_init(&queue->closed, 0);
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->pushed, 0);
+    atomic_init(&queue->pop_waiting, 0);
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->popped, 0);
+    atomic_init(&queue->push_waiting, 0);
+
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_queue_free(ecr_queue_t *queue) {
+    ECR_STATUS_GUARD(ecr_free(queue->allocator, queue->storage));
+
+    queue->storage = NULL;
+    queue->slots   = NULL;
+
+    return ECR_SUCCESS;
+}
+
+void ecr_queue_close(ecr_queue_t *queue) {
+    atomic_store(&queue->closed, 1);
+    atomic_fetch_or(&queue->head, HEAD_CLOSED);
+
+    atomic_fetch_add(&queue->pushed, 1);
+    ecr_futex_wake(&queue->pushed, INT_MAX, false);
+    atomic_fetch_add(&queue->popped, 1);
+    ecr_futex_wake(&queue->popped, INT_MAX, false);
+}
+
+/**
+ * Claim a run of up to **count** ready slots starting at **index**, storing the position of the first.
+ * Returns zero if the first slot isn't ready, meaning the queue is full for producers or empty for consumers,
+ * or if the queue is closed for producers.
+ */
+static size_t ecr_queue_claim(ecr_queue_t *queue, _Atomic(size_t) *index, size_t ready, size_t count, size_t *position) {
+    size_t start = atomic_load_explicit(index, memory_order_relaxed);
+    while(true) {
+        if(start & HEAD_CLOSED) {
+            return 0;
+        }
+
+        // a ready slot stays ready until it's claimed, which moves the index and fails the exchange below
+        size_t claimed = 0;
+        intptr_t lag = 0;
+        for(; claimed < count; claimed++) {
+            size_t sequence = atomic_load_explicit(ecr_queue_sequence(queue, start + claimed), memory_order_acquire);
+            lag = (intptr_t) (sequence - (start + claimed + ready));
+            if(lag != 0) {
+                break;
+            }
+        }
+
+        if(claimed == 0) {
+            if(lag < 0) {
+                return 0;
+            }
+
+            // another thread claimed the slot since the index was read
+            start = atomic_load_explicit(index, memory_order_relaxed);
+            continue;
+        }
+
+        if(atomic_compare_exchange_weak_explicit(index, &start, start + claimed, memory_order_relaxed, memory_order_relaxed)) {
+            *position = start;
+            return claimed;
+        }
+    }
+}
+
+/**
+ * Whether a closed queue has no elements left, including those in slots claimed by producers but not yet filled.
+ */
+static bool ecr_queue_drained(ecr_queue_t *queue) {
+    size_t head = atomic_load(&queue->head);
+    return (head & HEAD_CLOSED) && atomic_load(&queue->tail) == (head & ~HEAD_CLOSED);
+}
+
+/**
+ * Whether the slot at **index** looks unready with the index freshly read, so that a waiter may sleep.
+ * Once the queue is closed, only consumers waiting for claimed slots to be filled may sleep.
+ */
+static bool ecr_queue_blocked(ecr_queue_t *queue, _Atomic(size_t) *index, size_t ready) {
+    size_t position = atomic_load(index);
+    if((intptr_t) (atomic_load(ecr_queue_sequence(queue, position)) - (position + ready)) >= 0) {
+        return false;
+    }
+    if(atomic_load(&queue->closed)) {
+        return ready == POP_READY && !ecr_queue_drained(queue);
+    }
+
+    return true;
+}
+
+/**
+ * Wake waiters on the other side after handing over slots, if there are any.
+ * The fence pairs with the one in {@link ecr_queue_wait}, so that either the waiter sees the slots or this sees the waiter.
+ */
+static void ecr_queue_notify(_Atomic(uint32_t) *event, _Atomic(uint32_t) *waiting, size_t count) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if(atomic_load_explicit(waiting, memory_order_relaxed)) {
+        atomic_fetch_add(event, 1);
+        ecr_futex_wake(event, count < INT_MAX ? (int) count : INT_MAX, false);
+    }
+}
+
+static void ecr_queue_wait(ecr_queue_t *queue, _Atomic(size_t) *index, size_t ready, _Atomic(uint32_t) *event, _Atomic(uint32_t) *waiting) {
+    uint32_t expected = atomic_load(event);
+    atomic_fetch_add(waiting, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+    if(ecr_queue_blocked(queue, index, ready)) {
+        ecr_futex_wait(event, expected, NULL, false);
+    }
+    atomic_fetch_sub(waiting, 1);
+}
+
+ecr_status_t ecr_queue_push_batch(ecr_queue_t *queue, const void *elements, size_t count, size_t *pushed, bool blocking) {
+    if(count == 0) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t position, claimed;
+    while(true) {
+        claimed = ecr_queue_claim(queue, &queue->head, PUSH_READY, count, &position);
+        if(claimed > 0) {
+            break;
+        }
+
+        if(atomic_load(&queue->closed)) {
+            errno = EPIPE;
+            return ecr_get_system_error();
+        }
+        if(!blocking) {
+            return ECR_ERROR_AGAIN;
+        }
+
+        ecr_queue_wait(queue, &queue->head, PUSH_READY, &queue->popped, &queue->push_waiting);
+    }
+
+    for(size_t i = 0; i < claimed; i++) {
+        memcpy(ecr_queue_element(queue, position + i), elements + i * queue->element_size, queue->element_size);
+        atomic_store_explicit(ecr_queue_sequence(queue, position + i), position + i + 1, memory_order_release);
+    }
+    ecr_queue_notify(&queue->pushed, &queue->pop_waiting, claimed);
+
+    *pushed = claimed;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_queue_pop_batch(ecr_queue_t *queue, void *elements, size_t count, size_t *popped, bool blocking) {
+    if(count == 0) {
+        return ECR_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t position, claimed;
+    while(true) {
+        claimed = ecr_queue_claim(queue, &queue->tail, POP_READY, count, &position);
+        if(claimed > 0) {
+            break;
+        }
+
+        // producers that claimed slots before the queue was closed still fill them, and must be waited for
+        if(atomic_load(&queue->closed) && ecr_queue_drained(queue)) {
+            return ECR_ERROR_EOF;
+        }
+        if(!blocking) {
+            return ECR_ERROR_AGAIN;
+        }
+
+        ecr_queue_wait(queue, &queue->tail, POP_READY, &queue->pushed, &queue->pop_waiting);
+    }
+
+    for(size_t i = 0; i < claimed; i++) {
+        memcpy(elements + i * queue->element_size, ecr_queue_element(queue, position + i), queue->element_size);
+        atomic_store_explicit(ecr_queue_sequence(queue, position + i), position + i + queue->mask + 1, memory_order_release);
+    }
+    ecr_queue_notify(&queue->popped, &queue->push_waiting, claimed);
+
+    *popped = claimed;
+    return ECR_SUCCESS;
+}
+
+ecr_status_t ecr_queue_push(ecr_queue_t *queue, const void *element, bool blocking) {
+    size_t pushed;
+    return ecr_queue_push_batch(queue, element, 1, &pushed, blocking);
+}
+
+ecr_status_t ecr_queue_pop(ecr_queue_t *queue, void *element, bool blocking) {
+    size_t popped;
+    return ecr_queue_pop_batch(queue, element, 1, &popped, blocking);
+}
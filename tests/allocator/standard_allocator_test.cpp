@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <cstring>
+
 #include "allocator_test.hpp"
 
 TEST_F(allocator_test, alloc_and_free) {
@@ -21,3 +23,24 @@ TEST_F(allocator_test, alloc_and_free) {
     ASSERT_EQ(ecr_allocate(&allocator, (void **)(&mem), 16), ECR_SUCCESS);
     ASSERT_EQ(ecr_free(&allocator, (void *) mem), ECR_SUCCESS);
 }
+
+TEST_F(allocator_test, resize) {
+    void *mem;
+    ASSERT_EQ(ecr_allocate(&allocator, &mem, 16), ECR_SUCCESS);
+    std::memset(mem, 0x5A, 16);
+
+    ASSERT_EQ(ecr_resize(&allocator, &mem, 4096), ECR_SUCCESS);
+    for(size_t i = 0; i < 16; i++) {
+        ASSERT_EQ(((unsigned char *) mem)[i], 0x5A);
+    }
+
+    ASSERT_EQ(ecr_free(&allocator, mem), ECR_SUCCESS);
+}
+
+TEST_F(allocator_test, resize_unsupported) {
+    allocator.version = 0;
+
+    void *mem = nullptr;
+    ASSERT_EQ(ecr_resize(&allocator, &mem, 16), ECR_ERROR_NOT_SUPPORTED);
+    ASSERT_EQ(mem, nullptr);
+}
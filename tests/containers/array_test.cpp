@@ -0,0 +1,148 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+
+#include "containers_test.hpp"
+
+#include <ecr/containers/array.h>
+
+ECR_ARRAY_DEFINE(u32_array, uint32_t)
+
+struct point {
+    double x, y, z;
+};
+
+ECR_ARRAY_DEFINE(point_array, point)
+
+TEST_F(containers_test, array_push_and_pop) {
+    u32_array_t array;
+    u32_array_init(&array, &allocator);
+    ASSERT_EQ(live_allocations, 0);
+
+    for(uint32_t i = 0; i < 10000; i++) {
+        ASSERT_EQ(u32_array_push(&array, i * 7), ECR_SUCCESS);
+    }
+    ASSERT_EQ(array.length, 10000);
+    ASSERT_GE(array.capacity, 10000);
+    ASSERT_EQ(live_allocations, 1);
+
+    for(uint32_t i = 10000; i-- > 0;) {
+        uint32_t value;
+        ASSERT_TRUE(u32_array_pop(&array, &value));
+        ASSERT_EQ(value, i * 7);
+    }
+    uint32_t value;
+    ASSERT_FALSE(u32_array_pop(&array, &value));
+
+    ASSERT_EQ(u32_array_free(&array), ECR_SUCCESS);
+}
+
+TEST_F(containers_test, array_append) {
+    point_array_t array;
+    point_array_init(&array, &allocator);
+
+    point points[100];
+    for(int i = 0; i < 100; i++) {
+        points[i] = { (double) i, (double) -i, 0.5 };
+    }
+    for(int i = 0; i < 50; i++) {
+        ASSERT_EQ(point_array_append(&array, points, 100), ECR_SUCCESS);
+    }
+    ASSERT_EQ(point_array_append(&array, nullptr, 0), ECR_SUCCESS);
+    ASSERT_EQ(array.length, 5000);
+
+    for(size_t i = 0; i < array.length; i++) {
+        ASSERT_EQ(array.data[i].x, (double) (i % 100));
+        ASSERT_EQ(array.data[i].y, -(double) (i % 100));
+    }
+
+    ASSERT_EQ(point_array_free(&array), ECR_SUCCESS);
+}
+
+TEST_F(containers_test, array_without_resize) {
+    allocator.version = 0;
+
+    u32_array_t array;
+    u32_array_init(&array, &allocator);
+
+    for(uint32_t i = 0; i < 1000; i++) {
+        ASSERT_EQ(u32_array_push(&array, i), ECR_SUCCESS);
+    }
+    ASSERT_EQ(live_allocations, 1);
+    for(uint32_t i = 0; i < 1000; i++) {
+        ASSERT_EQ(array.data[i], i);
+    }
+
+    ASSERT_EQ(u32_array_shrink(&array), ECR_SUCCESS);
+    ASSERT_EQ(array.capacity, 1000);
+    ASSERT_EQ(array.data[999], 999);
+
+    ASSERT_EQ(u32_array_free(&array), ECR_SUCCESS);
+}
+
+TEST_F(containers_test, array_reserve_and_resize) {
+    u32_array_t array;
+    u32_array_init(&array, &allocator);
+
+    ASSERT_EQ(u32_array_reserve(&array, 300), ECR_SUCCESS);
+    ASSERT_EQ(array.capacity, 300);
+    uint32_t *data = array.data;
+    for(uint32_t i = 0; i < 300; i++) {
+        ASSERT_EQ(u32_array_push(&array, i), ECR_SUCCESS);
+    }
+    ASSERT_EQ(array.data, data);
+
+    ASSERT_EQ(u32_array_resize(&array, 10), ECR_SUCCESS);
+    ASSERT_EQ(array.length, 10);
+    ASSERT_EQ(u32_array_resize(&array, 400), ECR_SUCCESS);
+    ASSERT_EQ(array.length, 400);
+    ASSERT_EQ(array.data[9], 9);
+
+    u32_array_clear(&array);
+    ASSERT_EQ(array.length, 0);
+    ASSERT_EQ(u32_array_shrink(&array), ECR_SUCCESS);
+    ASSERT_EQ(array.capacity, 0);
+    ASSERT_EQ(array.data, nullptr);
+    ASSERT_EQ(live_allocations, 0);
+
+    ASSERT_EQ(u32_array_free(&array), ECR_SUCCESS);
+}
+
+TEST_F(containers_test, array_overflow) {
+    u32_array_t array;
+    u32_array_init(&array, &allocator);
+
+    ASSERT_EQ(u32_array_reserve(&array, SIZE_MAX / 2), ECR_ERROR_TYPE_OVERFLOW);
+    ASSERT_EQ(array.capacity, 0);
+    ASSERT_EQ(live_allocations, 0);
+}
+
+TEST_F(containers_test, array_as_buffer) {
+    u32_array_t array;
+    u32_array_init(&array, &allocator);
+
+    uint32_t values[] = { 1, 2, 3 };
+    ASSERT_EQ(u32_array_append(&array, values, 3), ECR_SUCCESS);
+
+    ecr_buffer_t buffer = u32_array_as_buffer(&array);
+    ASSERT_EQ(buffer.memory, array.data);
+    ASSERT_EQ(buffer.position, 0);
+    ASSERT_EQ(buffer.length, 3 * sizeof(uint32_t));
+    ASSERT_EQ(buffer.capacity, array.capacity * sizeof(uint32_t));
+
+    ASSERT_EQ(u32_array_free(&array), ECR_SUCCESS);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <ecr/allocator.h>
+#include <ecr/allocator/standard.h>
+#include <ecr/macro/guards.h>
+
+class containers_test : public testing::Test {
+  protected:
+    ecr_allocator_t allocator = {
+        .version = 1,
+        .data    = &live_allocations,
+        .free    = counting_free,
+        .alloc   = counting_alloc,
+        .resize  = ecr_allocator_standard_resize,
+    };
+
+    size_t live_allocations = 0;
+
+    void TearDown() override {
+        ASSERT_EQ(live_allocations, 0);
+    }
+
+  private:
+    static ecr_status_t counting_free(void *data, void *mem) {
+        if(mem) {
+            (*(size_t *) data)--;
+        }
+        return ecr_allocator_standard_free(nullptr, mem);
+    }
+
+    static ecr_status_t counting_alloc(void *data, void **mem_ptr, size_t mem_size) {
+        ECR_STATUS_GUARD(ecr_allocator_standard_alloc(nullptr, mem_ptr, mem_size));
+        (*(size_t *) data)++;
+        return ECR_SUCCESS;
+    }
+};
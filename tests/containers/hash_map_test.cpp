@@ -0,0 +1,217 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <string_view>
+
+#include "containers_test.hpp"
+
+#include <ecr/containers/hash_map.h>
+
+class hash_map_test : public containers_test {
+  protected:
+    ecr_hash_map_t map;
+
+    void SetUp() override {
+        ASSERT_EQ(ecr_hash_map_init(&map, &allocator, sizeof(uint64_t), sizeof(uint64_t), nullptr, nullptr), ECR_SUCCESS);
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(ecr_hash_map_free(&map), ECR_SUCCESS);
+        containers_test::TearDown();
+    }
+
+    void put(uint64_t key, uint64_t value) {
+        void *slot;
+        ASSERT_EQ(ecr_hash_map_insert(&map, &key, &slot, nullptr), ECR_SUCCESS);
+        std::memcpy(slot, &value, sizeof(value));
+    }
+
+    bool get(uint64_t key, uint64_t *value) {
+        void *slot = ecr_hash_map_find(&map, &key);
+        if(slot) {
+            std::memcpy(value, slot, sizeof(*value));
+        }
+        return slot != nullptr;
+    }
+};
+
+TEST_F(hash_map_test, empty) {
+    uint64_t value;
+    ASSERT_FALSE(get(1, &value));
+    uint64_t key = 1;
+    ASSERT_FALSE(ecr_hash_map_remove(&map, &key));
+    ASSERT_EQ(live_allocations, 0);
+}
+
+TEST_F(hash_map_test, insert_and_find) {
+    for(uint64_t i = 0; i < 10000; i++) {
+        put(i, i * 3);
+    }
+    ASSERT_EQ(map.size, 10000);
+
+    for(uint64_t i = 0; i < 10000; i++) {
+        uint64_t value;
+        ASSERT_TRUE(get(i, &value));
+        ASSERT_EQ(value, i * 3);
+    }
+
+    uint64_t value;
+    ASSERT_FALSE(get(10000, &value));
+}
+
+TEST_F(hash_map_test, insert_existing) {
+    put(7, 1);
+
+    uint64_t key = 7;
+    void *slot;
+    bool inserted;
+    ASSERT_EQ(ecr_hash_map_insert(&map, &key, &slot, &inserted), ECR_SUCCESS);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(*(uint64_t *) slot, 1);
+    ASSERT_EQ(map.size, 1);
+}
+
+TEST_F(hash_map_test, remove) {
+    for(uint64_t i = 0; i < 1000; i++) {
+        put(i, i);
+    }
+    for(uint64_t i = 0; i < 1000; i += 2) {
+        ASSERT_TRUE(ecr_hash_map_remove(&map, &i));
+        ASSERT_FALSE(ecr_hash_map_remove(&map, &i));
+    }
+    ASSERT_EQ(map.size, 500);
+
+    for(uint64_t i = 0; i < 1000; i++) {
+        uint64_t value;
+        ASSERT_EQ(get(i, &value), i % 2 == 1);
+    }
+}
+
+TEST_F(hash_map_test, churn_reuses_storage) {
+    ASSERT_EQ(ecr_hash_map_reserve(&map, 100), ECR_SUCCESS);
+    size_t capacity = map.capacity;
+
+    // a sliding window of keys leaves deleted slots behind, which rehashing must reclaim rather than growing
+    for(uint64_t i = 0; i < 100000; i++) {
+        put(i, i);
+        if(i >= 50) {
+            uint64_t old = i - 50;
+            ASSERT_TRUE(ecr_hash_map_remove(&map, &old));
+        }
+    }
+
+    ASSERT_EQ(map.size, 50);
+    ASSERT_EQ(map.capacity, capacity);
+    for(uint64_t i = 100000 - 50; i < 100000; i++) {
+        uint64_t value;
+        ASSERT_TRUE(get(i, &value));
+    }
+}
+
+TEST_F(hash_map_test, reserve) {
+    ASSERT_EQ(ecr_hash_map_reserve(&map, 5000), ECR_SUCCESS);
+    ASSERT_EQ(live_allocations, 1);
+    size_t capacity = map.capacity;
+
+    for(uint64_t i = 0; i < 5000; i++) {
+        put(i, i);
+    }
+    ASSERT_EQ(map.capacity, capacity);
+}
+
+TEST_F(hash_map_test, clear_and_iterate) {
+    for(uint64_t i = 0; i < 300; i++) {
+        put(i, i + 1);
+    }
+
+    size_t cursor = 0, count = 0;
+    uint64_t sum = 0;
+    const void *key;
+    void *value;
+    while(ecr_hash_map_next(&map, &cursor, &key, &value)) {
+        ASSERT_EQ(*(const uint64_t *) key + 1, *(uint64_t *) value);
+        sum += *(const uint64_t *) key;
+        count++;
+    }
+    ASSERT_EQ(count, 300);
+    ASSERT_EQ(sum, 299 * 300 / 2);
+
+    ecr_hash_map_clear(&map);
+    ASSERT_EQ(map.size, 0);
+    cursor = 0;
+    ASSERT_FALSE(ecr_hash_map_next(&map, &cursor, &key, &value));
+
+    uint64_t found;
+    ASSERT_FALSE(get(5, &found));
+}
+
+struct string_key {
+    const char *data;
+    size_t length;
+};
+
+static uint_least64_t hash_string_key(const void *key, size_t) {
+    const string_key *string = (const string_key *) key;
+    return ecr_hash_bytes(string->data, string->length);
+}
+
+static bool equal_string_key(const void *key, const void *other, size_t) {
+    const string_key *a = (const string_key *) key, *b = (const string_key *) other;
+    return a->length == b->length && std::memcmp(a->data, b->data, a->length) == 0;
+}
+
+static bool equal_string_view(const void *key, const void *other, size_t) {
+    const std::string_view *view = (const std::string_view *) key;
+    const string_key *string = (const string_key *) other;
+    return view->size() == string->length && std::memcmp(view->data(), string->data, string->length) == 0;
+}
+
+TEST_F(containers_test, hash_map_heterogeneous_lookup) {
+    ecr_hash_map_t strings;
+    ASSERT_EQ(ecr_hash_map_init(&strings, &allocator, sizeof(string_key), sizeof(int), hash_string_key, equal_string_key), ECR_SUCCESS);
+
+    const char *words[] = { "alpha", "beta", "gamma", "delta" };
+    for(int i = 0; i < 4; i++) {
+        string_key key = { words[i], std::strlen(words[i]) };
+        void *value;
+        ASSERT_EQ(ecr_hash_map_insert(&strings, &key, &value, nullptr), ECR_SUCCESS);
+        *(int *) value = i;
+    }
+
+    std::string_view lookup = "gamma";
+    void *value = ecr_hash_map_find_with(&strings, &lookup, ecr_hash_bytes(lookup.data(), lookup.size()), equal_string_view);
+    ASSERT_NE(value, nullptr);
+    ASSERT_EQ(*(int *) value, 2);
+
+    lookup = "epsilon";
+    ASSERT_EQ(ecr_hash_map_find_with(&strings, &lookup, ecr_hash_bytes(lookup.data(), lookup.size()), equal_string_view), nullptr);
+
+    ASSERT_EQ(ecr_hash_map_free(&strings), ECR_SUCCESS);
+}
+
+TEST_F(containers_test, hash_map_entry_layout) {
+    ecr_hash_map_t set;
+    ASSERT_EQ(ecr_hash_map_init(&set, &allocator, 3, 0, nullptr, nullptr), ECR_SUCCESS);
+    ASSERT_EQ(set.entry_size, 3);
+
+    ecr_hash_map_t mixed;
+    ASSERT_EQ(ecr_hash_map_init(&mixed, &allocator, sizeof(uint32_t), sizeof(uint64_t), nullptr, nullptr), ECR_SUCCESS);
+    ASSERT_EQ(mixed.value_offset, 8);
+    ASSERT_EQ(mixed.entry_size, 16);
+
+    ASSERT_EQ(ecr_hash_map_init(&mixed, &allocator, 0, 8, nullptr, nullptr), ECR_ERROR_INVALID_ARGUMENT);
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <string>
+
+#include "containers_test.hpp"
+
+#include <ecr/containers/string_builder.h>
+
+class string_builder_test : public containers_test {
+  protected:
+    ecr_string_builder_t builder;
+
+    void SetUp() override {
+        ecr_string_builder_init(&builder, &allocator);
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(ecr_string_builder_free(&builder), ECR_SUCCESS);
+        containers_test::TearDown();
+    }
+
+    std::string contents() {
+        return std::string(builder.data, builder.length);
+    }
+};
+
+TEST_F(string_builder_test, append) {
+    ASSERT_EQ(ecr_string_builder_append_string(&builder, "hello"), ECR_SUCCESS);
+    ASSERT_EQ(ecr_string_builder_push(&builder, ','), ECR_SUCCESS);
+    ASSERT_EQ(ecr_string_builder_append(&builder, " world!!", 6), ECR_SUCCESS);
+    ASSERT_EQ(contents(), "hello, world");
+}
+
+TEST_F(string_builder_test, printf) {
+    ASSERT_EQ(ecr_string_builder_printf(&builder, "%d-%s", 42, "x"), ECR_SUCCESS);
+    ASSERT_EQ(contents(), "42-x");
+
+    // longer than the builder's spare capacity, so it must grow and format again
+    std::string long_text(1000, 'a');
+    ASSERT_EQ(ecr_string_builder_printf(&builder, "[%s]", long_text.c_str()), ECR_SUCCESS);
+    ASSERT_EQ(contents(), "42-x[" + long_text + "]");
+
+    ASSERT_EQ(ecr_string_builder_printf(&builder, "%s", ""), ECR_SUCCESS);
+    ASSERT_EQ(builder.length, 1006);
+}
+
+TEST_F(string_builder_test, c_str) {
+    const char *string;
+    ASSERT_EQ(ecr_string_builder_c_str(&builder, &string), ECR_SUCCESS);
+    ASSERT_STREQ(string, "");
+
+    std::string text(builder.capacity, 'b');
+    ASSERT_EQ(ecr_string_builder_append(&builder, text.data(), text.size()), ECR_SUCCESS);
+    ASSERT_EQ(ecr_string_builder_c_str(&builder, &string), ECR_SUCCESS);
+    ASSERT_EQ(std::strlen(string), text.size());
+    ASSERT_EQ(builder.length, text.size());
+}
+
+TEST_F(string_builder_test, as_buffer) {
+    ASSERT_EQ(ecr_string_builder_append_string(&builder, "line\n"), ECR_SUCCESS);
+
+    ecr_buffer_t buffer = ecr_string_builder_as_buffer(&builder);
+    ASSERT_EQ(buffer.length, 5);
+    ASSERT_EQ(std::memcmp(buffer.memory, "line\n", 5), 0);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "io_test.hpp"
+
+#include <ecr/stream/async_log.h>
+
+class async_log_test : public io_test {
+  protected:
+    memory_stream memory;
+    ecr_stream_t sink;
+    ecr_async_log_config_t config = ecr_async_log_config_default;
+
+    void SetUp() override {
+        open_memory(&sink, &memory);
+    }
+};
+
+TEST_F(async_log_test, formats_messages) {
+    ecr_async_log_t *log;
+    ASSERT_EQ(ecr_async_log_open(&log, &sink, &allocator, &config), ECR_SUCCESS);
+
+    char name[] = "temporary";
+    ASSERT_EQ(ecr_async_log_printf(log, "%d %s %.2f %x|%-5c|\n", -42, name, 3.14159, 255u, 'z'), ECR_SUCCESS);
+    // strings are copied when logged, so changing them afterwards has no effect
+    name[0] = 'X';
+    ASSERT_EQ(ecr_async_log_printf(log, "%lld %zu %%\n", (long long) INT64_MIN, (size_t) 7), ECR_SUCCESS);
+
+    ASSERT_EQ(ecr_async_log_close(log), ECR_SUCCESS);
+
+    char expected[256];
+    std::snprintf(expected, sizeof(expected), "%d %s %.2f %x|%-5c|\n%lld %zu %%\n", -42, "temporary", 3.14159, 255u, 'z', (long long) INT64_MIN, (size_t) 7);
+    ASSERT_EQ(memory.contents, expected);
+}
+
+TEST_F(async_log_test, many_threads) {
+    constexpr int threads = 4, messages = 5000;
+
+    ecr_async_log_t *log;
+    ASSERT_EQ(ecr_async_log_open(&log, &sink, &allocator, &config), ECR_SUCCESS);
+
+    std::vector<std::thread> loggers;
+    for(int t = 0; t < threads; t++) {
+        loggers.emplace_back([log, t] {
+            for(int i = 0; i < messages; i++) {
+                ASSERT_EQ(ecr_async_log_printf(log, "%d:%d\n", t, i), ECR_SUCCESS);
+            }
+        });
+    }
+    for(std::thread &logger : loggers) {
+        logger.join();
+    }
+    ASSERT_EQ(ecr_async_log_close(log), ECR_SUCCESS);
+
+    ASSERT_EQ(std::count(memory.contents.begin(), memory.contents.end(), '\n'), threads * messages);
+}
+
+TEST_F(async_log_test, counts_overflow) {
+    config.capacity = 2;
+    config.overflow = ECR_ASYNC_LOG_OVERFLOW_COUNT;
+
+    ecr_async_log_t *log;
+    ASSERT_EQ(ecr_async_log_open(&log, &sink, &allocator, &config), ECR_SUCCESS);
+
+    constexpr int messages = 10000;
+    for(int i = 0; i < messages; i++) {
+        ASSERT_EQ(ecr_async_log_printf(log, "%d\n", i), ECR_SUCCESS);
+    }
+
+    uint_least64_t dropped;
+    ASSERT_EQ(ecr_async_log_dropped(log, &dropped), ECR_SUCCESS);
+    ASSERT_EQ(ecr_async_log_close(log), ECR_SUCCESS);
+
+    ASSERT_EQ(std::count(memory.contents.begin(), memory.contents.end(), '\n') + dropped, messages);
+}
+
+TEST_F(async_log_test, rejects_messages) {
+    config.record_size = 32;
+
+    ecr_async_log_t *log;
+    ASSERT_EQ(ecr_async_log_open(&log, &sink, &allocator, &config), ECR_SUCCESS);
+
+    int written;
+    ASSERT_EQ(ecr_async_log_printf(log, "%n", &written), ECR_ERROR_NOT_SUPPORTED);
+    ASSERT_EQ(ecr_async_log_printf(log, "%s", std::string(100, 'a').c_str()), ECR_ERROR_FULL_BUFFER);
+    ASSERT_EQ(ecr_async_log_printf(log, "ok\n"), ECR_SUCCESS);
+
+    ASSERT_EQ(ecr_async_log_close(log), ECR_SUCCESS);
+    ASSERT_EQ(memory.contents, "ok\n");
+}
+
+TEST_F(async_log_test, invalid_config) {
+    config.capacity = 0;
+
+    ecr_async_log_t *log;
+    ASSERT_EQ(ecr_async_log_open(&log, &sink, &allocator, &config), ECR_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(async_log_test, sink_error) {
+    memory.write_error = ECR_ERROR_IO;
+
+    ecr_async_log_t *log;
+    ASSERT_EQ(ecr_async_log_open(&log, &sink, &allocator, &config), ECR_SUCCESS);
+    ASSERT_EQ(ecr_async_log_printf(log, "lost\n"), ECR_SUCCESS);
+    ASSERT_EQ(ecr_async_log_close(log), ECR_ERROR_IO);
+}
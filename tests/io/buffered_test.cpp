@@ -0,0 +1,114 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/buffered.h>
+
+class buffered_test : public io_test {
+  protected:
+    memory_stream memory;
+    ecr_stream_t inner, stream;
+
+    // a small buffer and short reads from the inner stream, so that records span several refills
+    void open(const std::string &contents, size_t capacity = 8) {
+        memory.contents = contents;
+        memory.read_chunk = 5;
+        open_memory(&inner, &memory);
+        ASSERT_EQ(ecr_stream_open_buffered(&stream, &inner, &allocator, capacity), ECR_SUCCESS);
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    }
+};
+
+TEST_F(buffered_test, readline) {
+    open("first\r\nsecond line, longer than the buffer\n\nlast");
+
+    const char *line;
+    size_t length;
+    ASSERT_EQ(ecr_stream_readline(&stream, 1024, &line, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string(line, length), "first");
+    ASSERT_EQ(ecr_stream_readline(&stream, 1024, &line, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string(line, length), "second line, longer than the buffer");
+    ASSERT_EQ(ecr_stream_readline(&stream, 1024, &line, &length), ECR_SUCCESS);
+    ASSERT_EQ(length, 0);
+    ASSERT_EQ(ecr_stream_readline(&stream, 1024, &line, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string(line, length), "last");
+    ASSERT_EQ(ecr_stream_readline(&stream, 1024, &line, &length), ECR_ERROR_EOF);
+}
+
+TEST_F(buffered_test, read_until_too_long) {
+    open("0123456789;ab;");
+
+    const void *record;
+    size_t length;
+    ASSERT_EQ(ecr_stream_read_until(&stream, ';', 5, &record, &length), ECR_ERROR_FULL_BUFFER);
+    ASSERT_EQ(ecr_stream_read_until(&stream, ';', 11, &record, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string((const char *) record, length), "0123456789;");
+    ASSERT_EQ(ecr_stream_read_until(&stream, ';', 11, &record, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string((const char *) record, length), "ab;");
+    ASSERT_EQ(ecr_stream_read_until(&stream, ';', 11, &record, &length), ECR_ERROR_EOF);
+}
+
+TEST_F(buffered_test, fill_and_consume) {
+    open("abcdefghijklmnopqrstuvwxyz");
+
+    const void *view;
+    size_t length;
+    ASSERT_EQ(ecr_stream_buffered_fill(&stream, 20, &view, &length), ECR_SUCCESS);
+    ASSERT_GE(length, 20);
+    ASSERT_EQ(std::string((const char *) view, 20), "abcdefghijklmnopqrst");
+    ASSERT_EQ(ecr_stream_buffered_consume(&stream, 20), ECR_SUCCESS);
+
+    ASSERT_EQ(ecr_stream_buffered_fill(&stream, 10, &view, &length), ECR_ERROR_EOF);
+    ASSERT_EQ(std::string((const char *) view, length), "uvwxyz");
+    ASSERT_EQ(ecr_stream_buffered_consume(&stream, length + 1), ECR_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(buffered_test, reserve_and_commit) {
+    open("");
+
+    void *space;
+    size_t length;
+    ASSERT_EQ(ecr_stream_buffered_reserve(&stream, 32, &space, &length), ECR_SUCCESS);
+    ASSERT_GE(length, 32);
+    std::memcpy(space, "reserved", 8);
+    ASSERT_EQ(ecr_stream_buffered_commit(&stream, 8), ECR_SUCCESS);
+
+    char more[] = " and written";
+    size_t more_length = sizeof(more) - 1;
+    ASSERT_EQ(ecr_stream_write_full(&stream, more, &more_length), ECR_SUCCESS);
+    ASSERT_EQ(memory.contents, "");
+
+    ASSERT_EQ(ecr_stream_buffered_flush(&stream), ECR_SUCCESS);
+    ASSERT_EQ(memory.contents, "reserved and written");
+}
+
+TEST_F(io_test, buffered_rejects_other_streams) {
+    memory_stream memory;
+    ecr_stream_t stream;
+    open_memory(&stream, &memory);
+
+    const char *line;
+    size_t length;
+    ASSERT_EQ(ecr_stream_readline(&stream, 16, &line, &length), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_buffered_flush(&stream), ECR_ERROR_INVALID_ARGUMENT);
+
+    ecr_stream_t buffered;
+    ASSERT_EQ(ecr_stream_open_buffered(&buffered, &stream, &allocator, 0), ECR_ERROR_INVALID_ARGUMENT);
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/checksum.h>
+
+TEST_F(io_test, checksum) {
+    // the CRC-32C check value
+    ASSERT_EQ(ecr_crc32c(0, "123456789", 9), 0xE3069283);
+
+    std::string data = sample(10000);
+    memory_stream memory;
+    ecr_stream_t inner, stream;
+    open_memory(&inner, &memory);
+    ASSERT_EQ(ecr_stream_open_checksum(&stream, &inner, &allocator), ECR_SUCCESS);
+    ASSERT_EQ(write_all(&stream, data), ECR_SUCCESS);
+
+    uint_least32_t digest;
+    ASSERT_EQ(ecr_stream_checksum_digest(&stream, &digest), ECR_SUCCESS);
+    ASSERT_EQ(digest, ecr_crc32c(ecr_crc32c(0, data.data(), 1234), data.data() + 1234, data.size() - 1234));
+    ASSERT_EQ(ecr_stream_checksum_verify(&stream, digest), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_checksum_verify(&stream, digest ^ 1), ECR_ERROR_INVALID_DATA);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+
+    ASSERT_EQ(ecr_stream_checksum_digest(&inner, &digest), ECR_ERROR_INVALID_ARGUMENT);
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+#include "io_test.hpp"
+
+#include <ecr/codec.h>
+#include <ecr/stream/buffered.h>
+
+class codec_test : public io_test {
+  protected:
+    memory_stream memory;
+    ecr_stream_t inner, stream;
+
+    void SetUp() override {
+        memory.read_chunk = 3;
+        open_memory(&inner, &memory);
+        ASSERT_EQ(ecr_stream_open_buffered(&stream, &inner, &allocator, 16), ECR_SUCCESS);
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    }
+};
+
+TEST_F(codec_test, round_trip) {
+    unsigned char memory[256];
+    ecr_buffer_t buffer = { .memory = memory, .capacity = sizeof(memory), .position = 0, .length = 0 };
+
+    const uint64_t values[] = { 0, 1, 127, 128, 300, UINT32_MAX, UINT64_MAX };
+    for(uint64_t value : values) {
+        ASSERT_EQ(ecr_codec_put_varint(&buffer, value), ECR_SUCCESS);
+    }
+    ASSERT_EQ(ecr_codec_put_zigzag(&buffer, -1), ECR_SUCCESS);
+    ASSERT_EQ(ecr_codec_put_zigzag(&buffer, INT64_MIN), ECR_SUCCESS);
+    ASSERT_EQ(ecr_codec_put_u32le(&buffer, 0x01020304), ECR_SUCCESS);
+    ASSERT_EQ(ecr_codec_put_u16be(&buffer, 0xABCD), ECR_SUCCESS);
+    ASSERT_EQ(ecr_codec_put_bytes(&buffer, "bytes", 5), ECR_SUCCESS);
+
+    // little and big endian byte orders are fixed regardless of the host's
+    ASSERT_EQ(std::memcmp(memory + buffer.length - 6 - 2 - 4, "\x04\x03\x02\x01\xAB\xCD", 6), 0);
+
+    for(uint64_t expected : values) {
+        uint_least64_t value;
+        ASSERT_EQ(ecr_codec_get_varint(&buffer, &value), ECR_SUCCESS);
+        ASSERT_EQ(value, expected);
+    }
+    int_least64_t signed_value;
+    ASSERT_EQ(ecr_codec_get_zigzag(&buffer, &signed_value), ECR_SUCCESS);
+    ASSERT_EQ(signed_value, -1);
+    ASSERT_EQ(ecr_codec_get_zigzag(&buffer, &signed_value), ECR_SUCCESS);
+    ASSERT_EQ(signed_value, INT64_MIN);
+    uint_least32_t u32;
+    ASSERT_EQ(ecr_codec_get_u32le(&buffer, &u32), ECR_SUCCESS);
+    ASSERT_EQ(u32, 0x01020304);
+    uint_least16_t u16;
+    ASSERT_EQ(ecr_codec_get_u16be(&buffer, &u16), ECR_SUCCESS);
+    ASSERT_EQ(u16, 0xABCD);
+    const void *bytes;
+    size_t length;
+    ASSERT_EQ(ecr_codec_get_bytes(&buffer, &bytes, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string((const char *) bytes, length), "bytes");
+
+    ASSERT_EQ(buffer.position, buffer.length);
+    uint_least64_t value;
+    ASSERT_EQ(ecr_codec_get_varint(&buffer, &value), ECR_ERROR_EOF);
+}
+
+TEST_F(codec_test, errors) {
+    unsigned char memory[12];
+    ecr_buffer_t buffer = { .memory = memory, .capacity = 3, .position = 0, .length = 0 };
+    ASSERT_EQ(ecr_codec_put_varint(&buffer, UINT64_MAX), ECR_ERROR_FULL_BUFFER);
+    ASSERT_EQ(buffer.length, 0);
+
+    // eleven continuation bytes can't be a 64-bit varint
+    std::memset(memory, 0xFF, sizeof(memory));
+    buffer = { .memory = memory, .capacity = sizeof(memory), .position = 0, .length = sizeof(memory) };
+    uint_least64_t value;
+    ASSERT_EQ(ecr_codec_get_varint(&buffer, &value), ECR_ERROR_INVALID_DATA);
+    ASSERT_EQ(buffer.position, 0);
+}
+
+TEST_F(codec_test, get_varints) {
+    unsigned char memory[1024];
+    ecr_buffer_t buffer = { .memory = memory, .capacity = sizeof(memory), .position = 0, .length = 0 };
+
+    std::vector<uint64_t> values;
+    for(uint64_t i = 0; i < 100; i++) {
+        values.push_back(i % 3 == 0 ? i << (i % 57) : i);
+        ASSERT_EQ(ecr_codec_put_varint(&buffer, values.back()), ECR_SUCCESS);
+    }
+
+    uint_least64_t decoded_values[101];
+    size_t decoded;
+    ASSERT_EQ(ecr_codec_get_varints(&buffer, decoded_values, 101, &decoded), ECR_ERROR_EOF);
+    ASSERT_EQ(decoded, 100);
+    for(size_t i = 0; i < 100; i++) {
+        ASSERT_EQ(decoded_values[i], values[i]);
+    }
+}
+
+TEST_F(codec_test, over_stream) {
+    ecr_buffer_t buffer;
+    ASSERT_EQ(ecr_codec_begin_write(&stream, 2 * ECR_CODEC_VARINT_MAX, &buffer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_codec_put_varint(&buffer, 1234567), ECR_SUCCESS);
+    ASSERT_EQ(ecr_codec_put_zigzag(&buffer, -5), ECR_SUCCESS);
+    ASSERT_EQ(ecr_codec_end_write(&stream, &buffer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_buffered_flush(&stream), ECR_SUCCESS);
+
+    ASSERT_EQ(ecr_codec_begin_read(&stream, 4, &buffer), ECR_SUCCESS);
+    uint_least64_t value;
+    int_least64_t signed_value;
+    ASSERT_EQ(ecr_codec_get_varint(&buffer, &value), ECR_SUCCESS);
+    ASSERT_EQ(ecr_codec_get_zigzag(&buffer, &signed_value), ECR_SUCCESS);
+    ASSERT_EQ(ecr_codec_end_read(&stream, &buffer), ECR_SUCCESS);
+    ASSERT_EQ(value, 1234567);
+    ASSERT_EQ(signed_value, -5);
+
+    ASSERT_EQ(ecr_codec_begin_read(&stream, 1, &buffer), ECR_ERROR_EOF);
+}
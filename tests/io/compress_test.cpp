@@ -0,0 +1,50 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/compress.h>
+
+TEST_F(io_test, compress_round_trip) {
+    std::string data = sample(200000);
+
+    memory_stream compressed;
+    ecr_stream_t sink, stream;
+    open_memory(&sink, &compressed);
+    ASSERT_EQ(ecr_stream_open_compress(&stream, &sink, &allocator, 4096), ECR_SUCCESS);
+    ASSERT_EQ(write_all(&stream, data), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    ASSERT_LT(compressed.contents.size(), data.size() / 2);
+
+    ecr_stream_t source;
+    open_memory(&source, &compressed);
+    compressed.read_chunk = 100;
+    ASSERT_EQ(ecr_stream_open_decompress(&stream, &source, &allocator), ECR_SUCCESS);
+    std::string decompressed;
+    ASSERT_EQ(read_all(&stream, &decompressed), ECR_ERROR_EOF);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    ASSERT_EQ(decompressed, data);
+
+    // truncated compressed data must not be mistaken for the end of it
+    compressed.contents.resize(compressed.contents.size() / 2);
+    compressed.offset = 0;
+    ASSERT_EQ(ecr_stream_open_decompress(&stream, &source, &allocator), ECR_SUCCESS);
+    decompressed.clear();
+    ASSERT_EQ(read_all(&stream, &decompressed), ECR_ERROR_INVALID_DATA);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+
+    ASSERT_EQ(ecr_stream_open_compress(&stream, &sink, &allocator, 0), ECR_ERROR_INVALID_ARGUMENT);
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "io_test.hpp"
+
+#include <ecr/stream/concurrent.h>
+#include <ecr/stream/fd.h>
+#include <ecr/stream/socket.h>
+
+class concurrent_test : public io_test {
+  protected:
+    std::string socket_path = "/tmp/ecr-concurrent-test-" + std::to_string(getpid());
+
+    static constexpr int writers = 8;
+    static constexpr int writes = 2000;
+
+    // each writer writes numbered lines, which must come out whole and in each writer's order
+    void write_lines(ecr_stream_t *stream) {
+        std::vector<std::thread> threads;
+        for(int t = 0; t < writers; t++) {
+            threads.emplace_back([stream, t] {
+                for(int i = 0; i < writes; i++) {
+                    std::string line = std::to_string(t) + ":" + std::to_string(i) + "\n";
+                    size_t length = line.size();
+                    ASSERT_EQ(ecr_stream_write_full(stream, line.data(), &length), ECR_SUCCESS);
+                }
+            });
+        }
+        for(std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+
+    void check_lines(const std::string &contents) {
+        std::vector<int> next(writers, 0);
+        std::istringstream lines(contents);
+        std::string line;
+        while(std::getline(lines, line)) {
+            int t, i;
+            ASSERT_EQ(std::sscanf(line.c_str(), "%d:%d", &t, &i), 2) << line;
+            ASSERT_EQ(i, next[t]++);
+        }
+        for(int t = 0; t < writers; t++) {
+            ASSERT_EQ(next[t], writes);
+        }
+    }
+};
+
+TEST_F(concurrent_test, stream_sink) {
+    memory_stream memory;
+    ecr_stream_t sink, stream;
+    open_memory(&sink, &memory);
+    ASSERT_EQ(ecr_stream_open_concurrent(&stream, &sink, &allocator), ECR_SUCCESS);
+
+    write_lines(&stream);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+
+    check_lines(memory.contents);
+}
+
+TEST_F(concurrent_test, fd_sink) {
+    std::FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+
+    ecr_stream_t sink, stream;
+    ASSERT_EQ(ecr_stream_from_fd(&sink, fileno(file)), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_open_concurrent(&stream, &sink, &allocator), ECR_SUCCESS);
+
+    write_lines(&stream);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+
+    std::string contents(lseek(fileno(file), 0, SEEK_END), '\0');
+    ASSERT_EQ(pread(fileno(file), contents.data(), contents.size(), 0), (ssize_t) contents.size());
+    std::fclose(file);
+
+    check_lines(contents);
+}
+
+TEST_F(concurrent_test, socket_sink) {
+    ecr_stream_t listener, sink, peer, stream;
+    uint_least16_t port;
+    ASSERT_EQ(ecr_stream_listen_tcp(&listener, "127.0.0.1", "0", 1), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_local_port(&listener, &port), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_connect_tcp(&sink, "127.0.0.1", std::to_string(port).c_str()), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_accept(&listener, &peer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&sink, ECR_SOCKET_CORK, 1), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_open_concurrent(&stream, &sink, &allocator), ECR_SUCCESS);
+
+    std::string contents;
+    std::thread reader([&peer, &contents] {
+        char chunk[4096];
+        while(true) {
+            size_t length = sizeof(chunk);
+            ecr_status_t status = ecr_stream_read(&peer, chunk, &length);
+            contents.append(chunk, length);
+            if(status) {
+                ASSERT_EQ(status, ECR_ERROR_EOF);
+                break;
+            }
+        }
+    });
+
+    write_lines(&stream);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&sink), ECR_SUCCESS);
+    reader.join();
+
+    check_lines(contents);
+    ASSERT_EQ(ecr_stream_close(&peer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&listener), ECR_SUCCESS);
+}
+
+// a peer closing the connection must surface as EPIPE rather than kill the process with SIGPIPE
+TEST_F(concurrent_test, socket_peer_closed) {
+    std::signal(SIGPIPE, SIG_DFL);
+
+    ecr_stream_t listener, sink, peer, stream;
+    unlink(socket_path.c_str());
+    ASSERT_EQ(ecr_stream_listen_unix(&listener, socket_path.c_str(), 1), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_connect_unix(&sink, socket_path.c_str()), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_accept(&listener, &peer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&peer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_open_concurrent(&stream, &sink, &allocator), ECR_SUCCESS);
+
+    char byte = 'x';
+    ecr_status_t status = ECR_SUCCESS;
+    for(int i = 0; i < 5000 && !status; i++) {
+        size_t length = 1;
+        status = ecr_stream_write(&stream, &byte, &length);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(status, ECR_ERROR_SYSTEM);
+
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_ERROR_SYSTEM);
+    ASSERT_EQ(ecr_stream_close(&sink), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&listener), ECR_SUCCESS);
+    unlink(socket_path.c_str());
+}
+
+TEST_F(concurrent_test, sink_error) {
+    memory_stream memory;
+    memory.write_error = ECR_ERROR_IO;
+
+    ecr_stream_t sink, stream;
+    open_memory(&sink, &memory);
+    ASSERT_EQ(ecr_stream_open_concurrent(&stream, &sink, &allocator), ECR_SUCCESS);
+
+    // writes only fail once the background thread has run into the error
+    char byte = 'x';
+    ecr_status_t status = ECR_SUCCESS;
+    for(int i = 0; i < 5000 && !status; i++) {
+        size_t length = 1;
+        status = ecr_stream_write(&stream, &byte, &length);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(status, ECR_ERROR_IO);
+
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_ERROR_IO);
+}
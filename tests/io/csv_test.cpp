@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/buffered.h>
+#include <ecr/stream/csv.h>
+
+class csv_test : public io_test {
+  protected:
+    memory_stream memory;
+    ecr_stream_t inner, stream;
+
+    void open(const std::string &contents) {
+        memory.contents = contents;
+        memory.read_chunk = 7;
+        open_memory(&inner, &memory);
+        ASSERT_EQ(ecr_stream_open_buffered(&stream, &inner, &allocator, 16), ECR_SUCCESS);
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    }
+
+    std::string field(const ecr_csv_field_t &field) {
+        std::string out(field.length, '\0');
+        out.resize(ecr_csv_unescape(&field, out.data()));
+        return out;
+    }
+};
+
+TEST_F(csv_test, records) {
+    open("a,b,c\r\n\"quoted, with \"\"quotes\"\"\",\"multi\nline\",\n\nlast,record");
+
+    ecr_csv_field_t fields[4];
+    size_t count;
+    ASSERT_EQ(ecr_stream_read_csv(&stream, ',', true, 1024, fields, 4, &count), ECR_SUCCESS);
+    ASSERT_EQ(count, 3);
+    ASSERT_EQ(field(fields[0]), "a");
+    ASSERT_EQ(field(fields[2]), "c");
+
+    ASSERT_EQ(ecr_stream_read_csv(&stream, ',', true, 1024, fields, 4, &count), ECR_SUCCESS);
+    ASSERT_EQ(count, 3);
+    ASSERT_TRUE(fields[0].escaped);
+    ASSERT_EQ(field(fields[0]), "quoted, with \"quotes\"");
+    ASSERT_EQ(field(fields[1]), "multi\nline");
+    ASSERT_EQ(fields[2].length, 0);
+
+    ASSERT_EQ(ecr_stream_read_csv(&stream, ',', true, 1024, fields, 4, &count), ECR_SUCCESS);
+    ASSERT_EQ(count, 1);
+    ASSERT_EQ(fields[0].length, 0);
+
+    ASSERT_EQ(ecr_stream_read_csv(&stream, ',', true, 1024, fields, 1, &count), ECR_ERROR_FULL_BUFFER);
+    ASSERT_EQ(ecr_stream_read_csv(&stream, ',', true, 1024, fields, 4, &count), ECR_SUCCESS);
+    ASSERT_EQ(count, 2);
+    ASSERT_EQ(field(fields[1]), "record");
+
+    ASSERT_EQ(ecr_stream_read_csv(&stream, ',', true, 1024, fields, 4, &count), ECR_ERROR_EOF);
+}
+
+TEST_F(csv_test, without_quoting) {
+    open("x\t\"y\tz\n");
+
+    ecr_csv_field_t fields[4];
+    size_t count;
+    ASSERT_EQ(ecr_stream_read_csv(&stream, '\t', false, 1024, fields, 4, &count), ECR_SUCCESS);
+    ASSERT_EQ(count, 3);
+    ASSERT_EQ(field(fields[1]), "\"y");
+}
+
+TEST_F(csv_test, errors) {
+    open(std::string(100, 'l') + "\n\"unterminated");
+
+    ecr_csv_field_t fields[4];
+    size_t count;
+    ASSERT_EQ(ecr_stream_read_csv(&stream, ',', true, 50, fields, 4, &count), ECR_ERROR_FULL_BUFFER);
+    ASSERT_EQ(ecr_stream_read_csv(&stream, ',', true, 1024, fields, 4, &count), ECR_SUCCESS);
+    ASSERT_EQ(fields[0].length, 100);
+    ASSERT_EQ(ecr_stream_read_csv(&stream, ',', true, 1024, fields, 4, &count), ECR_ERROR_INVALID_DATA);
+}
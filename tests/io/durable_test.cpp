@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "io_test.hpp"
+
+#include <ecr/stream/durable.h>
+#include <ecr/stream/fd.h>
+
+TEST_F(io_test, durable_round_trip) {
+    std::FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(fcntl(fileno(file), F_SETFL, O_APPEND), 0);
+
+    ecr_stream_t sink, stream;
+    ASSERT_EQ(ecr_stream_from_fd(&sink, fileno(file)), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_open_durable(&stream, &sink, &allocator), ECR_SUCCESS);
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++) {
+        threads.emplace_back([&stream] {
+            for(int i = 0; i < 100; i++) {
+                char record[] = "rec\n";
+                size_t length = 4;
+                ASSERT_EQ(ecr_stream_write_full(&stream, record, &length), ECR_SUCCESS);
+            }
+        });
+    }
+    for(std::thread &thread : threads) {
+        thread.join();
+    }
+
+    char record[] = "end\n";
+    ecr_buffer_t buffer = { .memory = record, .capacity = 4, .position = 0, .length = 4 };
+    ecr_stream_durable_ticket_t ticket;
+    ASSERT_EQ(ecr_stream_durable_submit(&stream, &buffer, &ticket), ECR_SUCCESS);
+    ASSERT_EQ(buffer.position, 4);
+    ASSERT_EQ(ecr_stream_durable_wait(&stream, ticket), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+
+    ASSERT_EQ(lseek(fileno(file), 0, SEEK_END), 4 * 100 * 4 + 4);
+    std::fclose(file);
+}
+
+TEST_F(io_test, durable_requires_append) {
+    std::FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+
+    ecr_stream_t sink, stream;
+    ASSERT_EQ(ecr_stream_from_fd(&sink, fileno(file)), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_open_durable(&stream, &sink, &allocator), ECR_ERROR_INVALID_ARGUMENT);
+    std::fclose(file);
+
+    memory_stream memory;
+    open_memory(&sink, &memory);
+    ASSERT_EQ(ecr_stream_open_durable(&stream, &sink, &allocator), ECR_ERROR_INVALID_ARGUMENT);
+}
+
+// a writer waiting on another thread's commit must not be left queued when that commit fails
+TEST_F(io_test, durable_commit_error) {
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(fcntl(fds[1], F_SETFL, O_APPEND), 0);
+
+    ecr_stream_t sink, stream;
+    ASSERT_EQ(ecr_stream_from_fd(&sink, fds[1]), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_open_durable(&stream, &sink, &allocator), ECR_SUCCESS);
+
+    // the first writer commits a record larger than the pipe can hold, so it blocks with the commit in progress
+    std::thread committer([&stream, size = (size_t) fcntl(fds[1], F_GETPIPE_SZ) * 2] {
+        std::string record(size, 'x');
+        size_t length = record.size();
+        ASSERT_NE(ecr_stream_write_full(&stream, record.data(), &length), ECR_SUCCESS);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::vector<std::thread> waiters;
+    for(int t = 0; t < 4; t++) {
+        waiters.emplace_back([&stream] {
+            char record[] = "rec\n";
+            size_t length = 4;
+            ASSERT_NE(ecr_stream_write_full(&stream, record, &length), ECR_SUCCESS);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    ASSERT_EQ(close(fds[0]), 0);
+    committer.join();
+    for(std::thread &waiter : waiters) {
+        waiter.join();
+    }
+
+    char record[] = "end\n";
+    ecr_buffer_t buffer = { .memory = record, .capacity = 4, .position = 0, .length = 4 };
+    ecr_stream_durable_ticket_t ticket;
+    ASSERT_NE(ecr_stream_durable_submit(&stream, &buffer, &ticket), ECR_SUCCESS);
+
+    ASSERT_NE(ecr_stream_close(&stream), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&sink), ECR_SUCCESS);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/encoding.h>
+
+TEST_F(io_test, encoding_round_trip) {
+    for(ecr_encoding_t encoding : { ECR_ENCODING_HEX, ECR_ENCODING_BASE64 }) {
+        for(size_t length : { 0, 1, 2, 3, 4, 1000, 4097 }) {
+            std::string data = sample(length);
+
+            memory_stream text;
+            ecr_stream_t sink, stream;
+            open_memory(&sink, &text);
+            ASSERT_EQ(ecr_stream_open_encode(&stream, &sink, encoding, &allocator), ECR_SUCCESS);
+            ASSERT_EQ(write_all(&stream, data), ECR_SUCCESS);
+            ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+
+            ecr_stream_t source;
+            open_memory(&source, &text);
+            text.read_chunk = 7;
+            ASSERT_EQ(ecr_stream_open_decode(&stream, &source, encoding, &allocator), ECR_SUCCESS);
+            std::string decoded;
+            ASSERT_EQ(read_all(&stream, &decoded), ECR_ERROR_EOF);
+            ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+            ASSERT_EQ(decoded, data);
+        }
+    }
+}
+
+TEST_F(io_test, encoding_known_values) {
+    memory_stream text;
+    ecr_stream_t sink, stream;
+    open_memory(&sink, &text);
+    ASSERT_EQ(ecr_stream_open_encode(&stream, &sink, ECR_ENCODING_BASE64, &allocator), ECR_SUCCESS);
+    ASSERT_EQ(write_all(&stream, "foobar!"), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    ASSERT_EQ(text.contents, "Zm9vYmFyIQ==");
+
+    text.contents = "DEADbeef0";
+    ecr_stream_t source;
+    open_memory(&source, &text);
+    ASSERT_EQ(ecr_stream_open_decode(&stream, &source, ECR_ENCODING_HEX, &allocator), ECR_SUCCESS);
+    std::string decoded;
+    ASSERT_EQ(read_all(&stream, &decoded), ECR_ERROR_INVALID_DATA);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+
+    ASSERT_EQ(ecr_stream_open_decode(&stream, &source, (ecr_encoding_t) 9, &allocator), ECR_ERROR_INVALID_ARGUMENT);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/*
+ * ecr_format picks each value's formatter with _Generic, which C++ doesn't have,
+ * so the calls under test are made from C, and checked by format_test.cpp.
+ */
+
+#include <limits.h>
+#include <stdint.h>
+
+#include <ecr/stream/formatted.h>
+
+ecr_status_t format_strings(ecr_stream_t *stream) {
+    const char *constant = "constant";
+    char mutable[] = "mutable";
+    // a character constant is an int in C, so it is written as a number
+    return ecr_format(stream, "literal", ",", constant, ",", mutable, ",", (char) 'c', ",", 'c');
+}
+
+ecr_status_t format_signed(ecr_stream_t *stream) {
+    return ecr_format(stream, (signed char) SCHAR_MIN, ",", (short) SHRT_MIN, ",", INT_MIN, ",", LONG_MIN, ",", LLONG_MIN, ",", 0, ",", -1);
+}
+
+ecr_status_t format_unsigned(ecr_stream_t *stream) {
+    return ecr_format(stream, (unsigned char) UCHAR_MAX, ",", (unsigned short) USHRT_MAX, ",", UINT_MAX, ",", ULONG_MAX, ",", ULLONG_MAX, ",", 0u);
+}
+
+ecr_status_t format_others(ecr_stream_t *stream) {
+    bool yes = true, no = false;
+    return ecr_format(stream, 0.5f, ",", 0.1, ",", yes, ",", no, ",", (void *) 0x1234, ",", (const void *) 0);
+}
+
+ecr_status_t format_many(ecr_stream_t *stream) {
+    return ecr_format(stream,
+        "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p",
+        "q", "r", "s", "t", "u", "v", "w", "x", "y", "z", 0, 1, 2, 3, 4, 5
+    );
+}
+
+ecr_status_t format_long_numbers(ecr_stream_t *stream) {
+    const uint64_t max = UINT64_MAX;
+    return ecr_format(stream,
+        max, ",", max, ",", max, ",", max, ",", max, ",", max, ",", max, ",", max, ",",
+        max, ",", max, ",", max, ",", max, ",", max, ",", max, ",", max, ",", max
+    );
+}
+
+ecr_status_t format_long_string(ecr_stream_t *stream, const char *string) {
+    return ecr_format(stream, "<", string, ">");
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <functional>
+
+#include <ecr/stream/formatted.h>
+
+// defined in format_test.c
+extern "C" {
+    ecr_status_t format_strings(ecr_stream_t *stream);
+    ecr_status_t format_signed(ecr_stream_t *stream);
+    ecr_status_t format_unsigned(ecr_stream_t *stream);
+    ecr_status_t format_others(ecr_stream_t *stream);
+    ecr_status_t format_many(ecr_stream_t *stream);
+    ecr_status_t format_long_numbers(ecr_stream_t *stream);
+    ecr_status_t format_long_string(ecr_stream_t *stream, const char *string);
+}
+
+class format_test : public io_test {
+  protected:
+    memory_stream memory;
+    ecr_stream_t stream;
+
+    void SetUp() override {
+        open_memory(&stream, &memory);
+    }
+
+    void expect(const std::function<ecr_status_t(ecr_stream_t *)> &format, const std::string &expected, size_t writes) {
+        memory.contents.clear();
+        memory.writes = 0;
+        ASSERT_EQ(format(&stream), ECR_SUCCESS);
+        ASSERT_EQ(memory.contents, expected);
+        ASSERT_EQ(memory.writes, writes);
+    }
+};
+
+TEST_F(format_test, types) {
+    expect(format_strings, "literal,constant,mutable,c,99", 1);
+    expect(format_signed, "-128,-32768,-2147483648,-9223372036854775808,-9223372036854775808,0,-1", 1);
+    expect(format_unsigned, "255,65535,4294967295,18446744073709551615,18446744073709551615,0", 1);
+    expect(format_others, "0.5,0.1,true,false,0x1234,0x0", 1);
+}
+
+TEST_F(format_test, many_arguments) {
+    expect(format_many, "abcdefghijklmnopqrstuvwxyz012345", 1);
+}
+
+TEST_F(format_test, staging_buffer) {
+    // flushed once fewer than ECR_NUMBER_MAX_LENGTH bytes are left, so the 11th number is the last to fit
+    std::string expected = "18446744073709551615";
+    for(int i = 1; i < 16; i++) {
+        expected += ",18446744073709551615";
+    }
+    expect(format_long_numbers, expected, 2);
+    ASSERT_EQ(expected.size(), 335);
+}
+
+TEST_F(format_test, long_strings) {
+    std::string fits(200, 'x');
+    expect([&](ecr_stream_t *stream) { return format_long_string(stream, fits.c_str()); }, "<" + fits + ">", 1);
+
+    // written directly, after what was staged before it
+    std::string direct = sample(300);
+    std::replace(direct.begin(), direct.end(), '\0', ' ');
+    expect([&](ecr_stream_t *stream) { return format_long_string(stream, direct.c_str()); }, "<" + direct + ">", 3);
+}
+
+TEST_F(format_test, errors) {
+    memory.write_error = ECR_ERROR_IO;
+    ASSERT_EQ(format_strings(&stream), ECR_ERROR_IO);
+    ASSERT_EQ(format_long_numbers(&stream), ECR_ERROR_IO);
+    ASSERT_EQ(format_long_string(&stream, std::string(300, 'x').c_str()), ECR_ERROR_IO);
+    ASSERT_EQ(memory.contents, "");
+
+    memory.write_error = ECR_SUCCESS;
+    ecr_format_segment_t segments[] = { ecr_format_segment_string("x"), { .kind = (ecr_format_kind_t) 99 } };
+    ASSERT_EQ(ecr_format_segments(&stream, segments, 2), ECR_ERROR_INVALID_ARGUMENT);
+}
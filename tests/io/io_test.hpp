@@ -0,0 +1,132 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+// the io headers use C's restrict qualifier, which C++ only has as an extension
+#define restrict __restrict
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <ecr/allocator.h>
+#include <ecr/allocator/standard.h>
+#include <ecr/stream.h>
+
+/**
+ * In-memory stream contents: reads consume **contents** from **offset**, at most **read_chunk** bytes at a time,
+ * and writes append to it, counting the calls in **writes**, or fail with **write_error** if it's set.
+ */
+struct memory_stream {
+    std::string contents;
+    size_t offset = 0;
+    size_t read_chunk = SIZE_MAX;
+    ecr_status_t write_error = ECR_SUCCESS;
+    size_t writes = 0;
+};
+
+class io_test : public testing::Test {
+  protected:
+    ecr_allocator_t allocator = ecr_allocator_standard;
+
+    static void open_memory(ecr_stream_t *stream, memory_stream *memory) {
+        stream->version  = 0;
+        stream->data     = memory;
+        stream->readbuf  = memory_readbuf;
+        stream->writebuf = memory_writebuf;
+        stream->close    = memory_close;
+        stream->getpos   = memory_getpos;
+        stream->setpos   = memory_setpos;
+    }
+
+    // reads a stream until it fails, in odd-sized chunks, returning the error it failed with
+    static ecr_status_t read_all(ecr_stream_t *stream, std::string *out) {
+        char chunk[1000];
+        while(true) {
+            size_t length = sizeof(chunk);
+            ecr_status_t status = ecr_stream_read(stream, chunk, &length);
+            out->append(chunk, length);
+            if(status) {
+                return status;
+            }
+        }
+    }
+
+    static ecr_status_t write_all(ecr_stream_t *stream, const std::string &data) {
+        size_t length = data.size();
+        if(length == 0) {
+            return ECR_SUCCESS;
+        }
+        return ecr_stream_write_full(stream, (void *) data.data(), &length);
+    }
+
+    static std::string sample(size_t length) {
+        std::string data(length, '\0');
+        for(size_t i = 0; i < length; i++) {
+            // compressible, but not trivially so
+            data[i] = "the quick brown fox "[i % 20] ^ (char) ((i / 1000) & 7);
+        }
+        return data;
+    }
+
+  private:
+    static ecr_status_t memory_readbuf(void *data, ecr_buffer_t *buffer) {
+        memory_stream *memory = (memory_stream *) data;
+        if(buffer->position == buffer->length) {
+            return ECR_ERROR_FULL_BUFFER;
+        }
+        if(memory->offset == memory->contents.size()) {
+            return ECR_ERROR_EOF;
+        }
+
+        size_t length = std::min({ buffer->length - buffer->position, memory->contents.size() - memory->offset, memory->read_chunk });
+        std::memcpy((char *) buffer->memory + buffer->position, memory->contents.data() + memory->offset, length);
+        memory->offset += length;
+        buffer->position += length;
+        return ECR_SUCCESS;
+    }
+
+    static ecr_status_t memory_writebuf(void *data, ecr_buffer_t *buffer) {
+        memory_stream *memory = (memory_stream *) data;
+        if(memory->write_error) {
+            return memory->write_error;
+        }
+        if(buffer->position == buffer->length) {
+            return ECR_ERROR_FULL_BUFFER;
+        }
+
+        memory->contents.append((const char *) buffer->memory + buffer->position, buffer->length - buffer->position);
+        memory->writes++;
+        buffer->position = buffer->length;
+        return ECR_SUCCESS;
+    }
+
+    static ecr_status_t memory_close(void *) {
+        return ECR_SUCCESS;
+    }
+
+    static ecr_status_t memory_getpos(void *, ecr_stream_pos_t *) {
+        return ECR_ERROR_NOT_SUPPORTED;
+    }
+
+    static ecr_status_t memory_setpos(void *, ecr_stream_pos_t *, ecr_stream_dir_t) {
+        return ECR_ERROR_NOT_SUPPORTED;
+    }
+};
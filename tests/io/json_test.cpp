@@ -0,0 +1,84 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits>
+
+#include "io_test.hpp"
+
+#include <ecr/stream/buffered.h>
+#include <ecr/stream/json.h>
+
+class json_test : public io_test {
+  protected:
+    memory_stream memory;
+    ecr_stream_t inner, stream;
+
+    void open(const std::string &contents) {
+        memory.contents = contents;
+        memory.read_chunk = 7;
+        open_memory(&inner, &memory);
+        ASSERT_EQ(ecr_stream_open_buffered(&stream, &inner, &allocator, 16), ECR_SUCCESS);
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    }
+};
+
+TEST_F(json_test, document) {
+    open("");
+
+    ecr_json_writer_t writer;
+    ecr_json_writer_init(&writer, &stream);
+
+    ASSERT_EQ(ecr_json_begin_object(&writer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_key(&writer, "name", 4), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_string(&writer, "a \"quoted\"\n\x01 string", 19), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_key(&writer, "values", 6), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_begin_array(&writer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_u64(&writer, UINT64_MAX), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_i64(&writer, -3), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_f64(&writer, 0.5), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_bool(&writer, true), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_null(&writer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_end_array(&writer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_end_object(&writer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_u64(&writer, 1), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_buffered_flush(&stream), ECR_SUCCESS);
+
+    ASSERT_EQ(memory.contents, "{\"name\":\"a \\\"quoted\\\"\\n\\u0001 string\",\"values\":[18446744073709551615,-3,0.5,true,null]}\n1");
+}
+
+TEST_F(json_test, misuse) {
+    open("");
+
+    ecr_json_writer_t writer;
+    ecr_json_writer_init(&writer, &stream);
+
+    ASSERT_EQ(ecr_json_key(&writer, "k", 1), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_json_end_array(&writer), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_json_f64(&writer, std::numeric_limits<double>::infinity()), ECR_ERROR_INVALID_ARGUMENT);
+
+    ASSERT_EQ(ecr_json_begin_object(&writer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_json_u64(&writer, 1), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_json_end_array(&writer), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_json_end_object(&writer), ECR_SUCCESS);
+
+    for(int i = 0; i < ECR_JSON_MAX_DEPTH; i++) {
+        ASSERT_EQ(ecr_json_begin_array(&writer), ECR_SUCCESS);
+    }
+    ASSERT_EQ(ecr_json_begin_array(&writer), ECR_ERROR_FULL_BUFFER);
+}
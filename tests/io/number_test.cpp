@@ -0,0 +1,106 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include <ecr/stream/number.h>
+
+template<typename T>
+static std::string format(size_t (*formatter)(char *, T), T value) {
+    char out[ECR_NUMBER_MAX_LENGTH];
+    size_t length = formatter(out, value);
+    EXPECT_LE(length, sizeof(out));
+    return std::string(out, length);
+}
+
+TEST_F(io_test, number_integers) {
+    ASSERT_EQ(format(ecr_format_u64, (uint_least64_t) 0), "0");
+    ASSERT_EQ(format(ecr_format_u64, (uint_least64_t) 9), "9");
+    ASSERT_EQ(format(ecr_format_u64, (uint_least64_t) 10), "10");
+    ASSERT_EQ(format(ecr_format_u64, (uint_least64_t) 99), "99");
+    ASSERT_EQ(format(ecr_format_u64, (uint_least64_t) 100), "100");
+    ASSERT_EQ(format(ecr_format_u64, (uint_least64_t) UINT64_MAX), "18446744073709551615");
+
+    ASSERT_EQ(format(ecr_format_i64, (int_least64_t) 0), "0");
+    ASSERT_EQ(format(ecr_format_i64, (int_least64_t) -1), "-1");
+    ASSERT_EQ(format(ecr_format_i64, (int_least64_t) -10), "-10");
+    ASSERT_EQ(format(ecr_format_i64, (int_least64_t) INT64_MAX), "9223372036854775807");
+    ASSERT_EQ(format(ecr_format_i64, (int_least64_t) INT64_MIN), "-9223372036854775808");
+
+    ASSERT_EQ(format(ecr_format_hex, (uint_least64_t) 0), "0");
+    ASSERT_EQ(format(ecr_format_hex, (uint_least64_t) 0xf), "f");
+    ASSERT_EQ(format(ecr_format_hex, (uint_least64_t) 0x10), "10");
+    ASSERT_EQ(format(ecr_format_hex, (uint_least64_t) UINT64_MAX), "ffffffffffffffff");
+}
+
+TEST_F(io_test, number_floats) {
+    // positional up to a decimal exponent of 16, scientific from 17
+    ASSERT_EQ(format(ecr_format_f64, 1e16), "10000000000000000");
+    ASSERT_EQ(format(ecr_format_f64, 9999999999999998.0), "9999999999999998");
+    ASSERT_EQ(format(ecr_format_f64, 1e17), "1e+17");
+    ASSERT_EQ(format(ecr_format_f64, 1.2345678901234568e17), "1.2345678901234568e+17");
+
+    // positional down to a decimal exponent of -4, scientific from -5
+    ASSERT_EQ(format(ecr_format_f64, 1e-4), "0.0001");
+    ASSERT_EQ(format(ecr_format_f64, 1e-5), "1e-05");
+    ASSERT_EQ(format(ecr_format_f64, 1.5e-7), "1.5e-07");
+
+    ASSERT_EQ(format(ecr_format_f64, 0.0), "0");
+    ASSERT_EQ(format(ecr_format_f64, -0.0), "-0");
+    ASSERT_EQ(format(ecr_format_f64, 0.1), "0.1");
+    ASSERT_EQ(format(ecr_format_f64, 0.5), "0.5");
+    ASSERT_EQ(format(ecr_format_f64, 1e100), "1e+100");
+    ASSERT_EQ(format(ecr_format_f64, std::numeric_limits<double>::denorm_min()), "5e-324");
+    ASSERT_EQ(format(ecr_format_f64, HUGE_VAL), "inf");
+    ASSERT_EQ(format(ecr_format_f64, -HUGE_VAL), "-inf");
+    ASSERT_EQ(format(ecr_format_f64, std::numeric_limits<double>::quiet_NaN()), "nan");
+
+    // the shortest form always reads back as the same value
+    for(double value : { 1.0 / 3.0, 2.0 / 3.0, 123456.789, -1e-300, std::numeric_limits<double>::max(), std::numeric_limits<double>::min() }) {
+        ASSERT_EQ(std::strtod(format(ecr_format_f64, value).c_str(), nullptr), value);
+    }
+}
+
+TEST_F(io_test, number_stream_writers) {
+    memory_stream memory;
+    ecr_stream_t stream;
+    open_memory(&stream, &memory);
+
+    ASSERT_EQ(ecr_stream_write_u64(&stream, UINT64_MAX), ECR_SUCCESS);
+    ASSERT_EQ(memory.contents, "18446744073709551615");
+
+    memory.contents.clear();
+    ASSERT_EQ(ecr_stream_write_i64(&stream, INT64_MIN), ECR_SUCCESS);
+    ASSERT_EQ(memory.contents, "-9223372036854775808");
+
+    memory.contents.clear();
+    ASSERT_EQ(ecr_stream_write_hex(&stream, 0xdeadbeef), ECR_SUCCESS);
+    ASSERT_EQ(memory.contents, "deadbeef");
+
+    memory.contents.clear();
+    ASSERT_EQ(ecr_stream_write_f64(&stream, 1e-5), ECR_SUCCESS);
+    ASSERT_EQ(memory.contents, "1e-05");
+
+    memory.write_error = ECR_ERROR_IO;
+    ASSERT_EQ(ecr_stream_write_u64(&stream, 0), ECR_ERROR_IO);
+    ASSERT_EQ(ecr_stream_write_i64(&stream, 0), ECR_ERROR_IO);
+    ASSERT_EQ(ecr_stream_write_hex(&stream, 0), ECR_ERROR_IO);
+    ASSERT_EQ(ecr_stream_write_f64(&stream, 0), ECR_ERROR_IO);
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <thread>
+#include <vector>
+
+#include "io_test.hpp"
+
+#include <ecr/stream/file.h>
+#include <ecr/stream/pipe.h>
+
+TEST_F(io_test, pipe_round_trip) {
+    ecr_stream_t reader, writer;
+    ASSERT_EQ(ecr_stream_open_pipe(&reader, &writer, &allocator, 1000, (ecr_filemode_t) 0), ECR_SUCCESS);
+
+    // several times the pipe's capacity, so that both ends have to wait on each other
+    std::string sent(100000, '\0');
+    for(size_t i = 0; i < sent.size(); i++) {
+        sent[i] = (char) (i * 7 + i / 251);
+    }
+
+    std::thread producer([&] {
+        size_t length = sent.size();
+        ASSERT_EQ(ecr_stream_write_full(&writer, sent.data(), &length), ECR_SUCCESS);
+        ASSERT_EQ(ecr_stream_close(&writer), ECR_SUCCESS);
+    });
+
+    std::string received;
+    char chunk[333];
+    ecr_status_t status;
+    while(true) {
+        size_t length = sizeof(chunk);
+        status = ecr_stream_read(&reader, chunk, &length);
+        if(status) {
+            break;
+        }
+        received.append(chunk, length);
+    }
+    producer.join();
+
+    ASSERT_EQ(status, ECR_ERROR_EOF);
+    ASSERT_EQ(received, sent);
+    ASSERT_EQ(ecr_stream_close(&reader), ECR_SUCCESS);
+}
+
+TEST_F(io_test, pipe_nonblocking) {
+    ecr_stream_t reader, writer;
+    ASSERT_EQ(ecr_stream_open_pipe(&reader, &writer, &allocator, 16, ECR_FILEMODE_NONBLOCK), ECR_SUCCESS);
+
+    char memory[32] = "0123456789abcdefghijklmnopqrstu";
+    size_t length = sizeof(memory);
+    ASSERT_EQ(ecr_stream_read(&reader, memory, &length), ECR_ERROR_AGAIN);
+
+    length = sizeof(memory);
+    ASSERT_EQ(ecr_stream_write(&writer, memory, &length), ECR_SUCCESS);
+    ASSERT_EQ(length, 16);
+    length = sizeof(memory);
+    ASSERT_EQ(ecr_stream_write(&writer, memory, &length), ECR_ERROR_AGAIN);
+
+    char out[32];
+    length = sizeof(out);
+    ASSERT_EQ(ecr_stream_read(&reader, out, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string(out, length), "0123456789abcdef");
+
+    ASSERT_EQ(ecr_stream_close(&writer), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&reader), ECR_SUCCESS);
+}
+
+TEST_F(io_test, pipe_reader_closed) {
+    ecr_stream_t reader, writer;
+    ASSERT_EQ(ecr_stream_open_pipe(&reader, &writer, &allocator, 16, (ecr_filemode_t) 0), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&reader), ECR_SUCCESS);
+
+    char byte = 'x';
+    size_t length = 1;
+    ASSERT_EQ(ecr_stream_write(&writer, &byte, &length), ECR_ERROR_SYSTEM);
+    ASSERT_EQ(errno, EPIPE);
+    ASSERT_EQ(ecr_stream_close(&writer), ECR_SUCCESS);
+}
+
+TEST_F(io_test, pipe_invalid_arguments) {
+    ecr_stream_t reader, writer;
+    ASSERT_EQ(ecr_stream_open_pipe(&reader, &writer, &allocator, 0, (ecr_filemode_t) 0), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_open_pipe(&reader, &writer, &allocator, 16, ECR_FILEMODE_APPEND), ECR_ERROR_INVALID_ARGUMENT);
+}
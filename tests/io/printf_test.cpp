@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "io_test.hpp"
+
+#include <ecr/stream/formatted.h>
+
+TEST_F(io_test, printf_chunks) {
+    memory_stream memory;
+    ecr_stream_t stream;
+    open_memory(&stream, &memory);
+
+    std::string data = sample(10000);
+    std::replace(data.begin(), data.end(), '\0', ' ');
+    ASSERT_EQ(ecr_stream_printf(&stream, "%s|%d|%s", data.c_str(), 42, data.c_str()), ECR_SUCCESS);
+    ASSERT_EQ(memory.contents, data + "|42|" + data);
+
+    // formatted into a 1 KiB buffer, so it reaches the stream in several writes
+    ASSERT_GT(memory.writes, 1);
+}
+
+// a stream which logs each write to another stream with ecr_stream_printf
+struct logging_stream {
+    memory_stream memory;
+    ecr_stream_t log;
+};
+
+static ecr_status_t logging_writebuf(void *data, ecr_buffer_t *buffer) {
+    logging_stream *logging = (logging_stream *) data;
+    ECR_STATUS_GUARD(ecr_stream_printf(&logging->log, "write %zu\n", buffer->length - buffer->position));
+
+    logging->memory.contents.append((const char *) buffer->memory + buffer->position, buffer->length - buffer->position);
+    buffer->position = buffer->length;
+    return ECR_SUCCESS;
+}
+
+TEST_F(io_test, printf_nested) {
+    memory_stream log;
+    logging_stream logging;
+    open_memory(&logging.log, &log);
+
+    ecr_stream_t stream;
+    open_memory(&stream, &logging.memory);
+    stream.data = &logging;
+    stream.writebuf = logging_writebuf;
+
+    std::string data(3000, 'x');
+    ASSERT_EQ(ecr_stream_printf(&stream, "<%s>", data.c_str()), ECR_SUCCESS);
+    ASSERT_EQ(logging.memory.contents, "<" + data + ">");
+
+    // one whole line per write, accounting for all of the output
+    std::istringstream lines(log.contents);
+    std::string line;
+    size_t total = 0;
+    while(std::getline(lines, line)) {
+        ASSERT_EQ(line.rfind("write ", 0), 0);
+        total += std::stoul(line.substr(6));
+    }
+    ASSERT_EQ(total, data.size() + 2);
+
+    // and the outer printer still works afterwards
+    log.contents.clear();
+    ASSERT_EQ(ecr_stream_printf(&logging.log, "%s", "done"), ECR_SUCCESS);
+    ASSERT_EQ(log.contents, "done");
+}
+
+TEST_F(io_test, printf_errors) {
+    memory_stream bad, good;
+    ecr_stream_t bad_stream, good_stream;
+    open_memory(&bad_stream, &bad);
+    open_memory(&good_stream, &good);
+    bad.write_error = ECR_ERROR_IO;
+
+    // fails when flushing at the end
+    ASSERT_EQ(ecr_stream_printf(&bad_stream, "%s", "leftover"), ECR_ERROR_IO);
+    ASSERT_EQ(ecr_stream_printf(&good_stream, "%s", "first"), ECR_SUCCESS);
+    ASSERT_EQ(good.contents, "first");
+
+    // fails when the buffer fills up, with more still to format
+    std::string data(5000, 'x');
+    ASSERT_EQ(ecr_stream_printf(&bad_stream, "%s%s", data.c_str(), "leftover"), ECR_ERROR_IO);
+    ASSERT_EQ(ecr_stream_printf(&good_stream, "%s", "second"), ECR_SUCCESS);
+    ASSERT_EQ(good.contents, "firstsecond");
+}
+
+TEST_F(io_test, printf_threads) {
+    constexpr int threads = 4;
+    constexpr int lines = 2000;
+
+    std::vector<memory_stream> memories(threads);
+    std::vector<std::thread> printers;
+    for(int t = 0; t < threads; t++) {
+        printers.emplace_back([&memories, t] {
+            ecr_stream_t stream;
+            open_memory(&stream, &memories[t]);
+            for(int i = 0; i < lines; i++) {
+                ASSERT_EQ(ecr_stream_printf(&stream, "%d:%d\n", t, i), ECR_SUCCESS);
+            }
+        });
+    }
+    for(std::thread &printer : printers) {
+        printer.join();
+    }
+
+    for(int t = 0; t < threads; t++) {
+        std::string expected;
+        for(int i = 0; i < lines; i++) {
+            expected += std::to_string(t) + ":" + std::to_string(i) + "\n";
+        }
+        ASSERT_EQ(memories[t].contents, expected);
+    }
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/readahead.h>
+
+TEST_F(io_test, readahead) {
+    memory_stream memory;
+    memory.contents = sample(300000);
+    memory.read_chunk = 4000;
+
+    ecr_stream_t source, stream;
+    open_memory(&source, &memory);
+    ASSERT_EQ(ecr_stream_open_readahead(&stream, &source, &allocator, 1, 4096), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_open_readahead(&stream, &source, &allocator, 3, 4096), ECR_SUCCESS);
+
+    std::string read;
+    ASSERT_EQ(read_all(&stream, &read), ECR_ERROR_EOF);
+    ASSERT_EQ(read, memory.contents);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/buffered.h>
+#include <ecr/stream/record.h>
+
+class record_test : public io_test {
+  protected:
+    memory_stream memory;
+    ecr_stream_t inner, stream;
+
+    void SetUp() override {
+        memory.read_chunk = 3;
+        open_memory(&inner, &memory);
+        ASSERT_EQ(ecr_stream_open_buffered(&stream, &inner, &allocator, 16), ECR_SUCCESS);
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    }
+};
+
+TEST_F(record_test, round_trip) {
+    std::string records[] = { "", "short", std::string(300, 'r'), std::string(20, 's') };
+    for(ecr_record_prefix_t prefix : { ECR_RECORD_PREFIX_VARINT, ECR_RECORD_PREFIX_FIXED32 }) {
+        memory.contents.clear();
+        memory.offset = 0;
+
+        for(const std::string &record : records) {
+            ASSERT_EQ(ecr_stream_write_record(&stream, prefix, record.data(), record.size()), ECR_SUCCESS);
+        }
+        ASSERT_EQ(ecr_stream_buffered_flush(&stream), ECR_SUCCESS);
+
+        for(const std::string &record : records) {
+            const void *memory;
+            size_t length;
+            ASSERT_EQ(ecr_stream_read_record(&stream, prefix, 1024, &memory, &length), ECR_SUCCESS);
+            ASSERT_EQ(std::string((const char *) memory, length), record);
+        }
+
+        const void *memory;
+        size_t length;
+        ASSERT_EQ(ecr_stream_read_record(&stream, prefix, 1024, &memory, &length), ECR_ERROR_EOF);
+    }
+}
+
+TEST_F(record_test, too_long) {
+    std::string record(100, 'x');
+    ASSERT_EQ(ecr_stream_write_record(&stream, ECR_RECORD_PREFIX_VARINT, record.data(), record.size()), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_buffered_flush(&stream), ECR_SUCCESS);
+
+    const void *memory;
+    size_t length;
+    ASSERT_EQ(ecr_stream_read_record(&stream, ECR_RECORD_PREFIX_VARINT, 99, &memory, &length), ECR_ERROR_FULL_BUFFER);
+    ASSERT_EQ(ecr_stream_read_record(&stream, ECR_RECORD_PREFIX_VARINT, 100, &memory, &length), ECR_SUCCESS);
+    ASSERT_EQ(length, 100);
+}
+
+TEST_F(record_test, truncated) {
+    // a prefix promising ten bytes, followed by only four
+    memory.contents = "\x0a" "abcd";
+
+    const void *memory;
+    size_t length;
+    ASSERT_EQ(ecr_stream_read_record(&stream, ECR_RECORD_PREFIX_VARINT, 1024, &memory, &length), ECR_ERROR_INVALID_DATA);
+}
+
+TEST_F(record_test, unknown_prefix) {
+    ASSERT_EQ(ecr_stream_write_record(&stream, (ecr_record_prefix_t) 7, "x", 1), ECR_ERROR_INVALID_ARGUMENT);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "io_test.hpp"
+
+#include <ecr/stream/buffered.h>
+#include <ecr/stream/number.h>
+#include <ecr/stream/scan.h>
+
+class scan_test : public io_test {
+  protected:
+    memory_stream memory;
+    ecr_stream_t inner, stream;
+
+    void open(const std::string &contents) {
+        memory.contents = contents;
+        memory.read_chunk = 7;
+        open_memory(&inner, &memory);
+        ASSERT_EQ(ecr_stream_open_buffered(&stream, &inner, &allocator, 16), ECR_SUCCESS);
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    }
+};
+
+TEST_F(scan_test, integers) {
+    open("  42\n-17 +8 18446744073709551615 18446744073709551616 12abc 9223372036854775808");
+
+    uint_least64_t u;
+    int_least64_t i;
+    ASSERT_EQ(ecr_stream_scan_u64(&stream, &u), ECR_SUCCESS);
+    ASSERT_EQ(u, 42);
+    ASSERT_EQ(ecr_stream_scan_u64(&stream, &u), ECR_ERROR_INVALID_DATA);
+    ASSERT_EQ(ecr_stream_scan_i64(&stream, &i), ECR_SUCCESS);
+    ASSERT_EQ(i, -17);
+    ASSERT_EQ(ecr_stream_scan_i64(&stream, &i), ECR_SUCCESS);
+    ASSERT_EQ(i, 8);
+    ASSERT_EQ(ecr_stream_scan_u64(&stream, &u), ECR_SUCCESS);
+    ASSERT_EQ(u, UINT64_MAX);
+
+    // numbers which can't be read are left unread, so they may be read as tokens instead
+    ASSERT_EQ(ecr_stream_scan_u64(&stream, &u), ECR_ERROR_TYPE_OVERFLOW);
+    const char *token;
+    size_t length;
+    ASSERT_EQ(ecr_stream_scan_token(&stream, 64, &token, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string(token, length), "18446744073709551616");
+
+    ASSERT_EQ(ecr_stream_scan_u64(&stream, &u), ECR_ERROR_INVALID_DATA);
+    ASSERT_EQ(ecr_stream_scan_token(&stream, 64, &token, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string(token, length), "12abc");
+
+    ASSERT_EQ(ecr_stream_scan_i64(&stream, &i), ECR_ERROR_TYPE_OVERFLOW);
+    ASSERT_EQ(ecr_stream_scan_u64(&stream, &u), ECR_SUCCESS);
+    ASSERT_EQ(u, UINT64_C(9223372036854775808));
+
+    ASSERT_EQ(ecr_stream_scan_u64(&stream, &u), ECR_ERROR_EOF);
+}
+
+TEST_F(scan_test, floats) {
+    open("3.25 -0.1 1e308 .5e-3 INF nan 4.9e-324 1e-400 1e309 1.5.2");
+
+    const double expected[] = { 3.25, -0.1, 1e308, .5e-3, std::numeric_limits<double>::infinity() };
+    for(double value : expected) {
+        double scanned;
+        ASSERT_EQ(ecr_stream_scan_f64(&stream, &scanned), ECR_SUCCESS);
+        ASSERT_EQ(scanned, value);
+    }
+
+    double scanned;
+    ASSERT_EQ(ecr_stream_scan_f64(&stream, &scanned), ECR_SUCCESS);
+    ASSERT_TRUE(std::isnan(scanned));
+    ASSERT_EQ(ecr_stream_scan_f64(&stream, &scanned), ECR_SUCCESS);
+    ASSERT_EQ(scanned, 4.9e-324);
+    ASSERT_EQ(ecr_stream_scan_f64(&stream, &scanned), ECR_SUCCESS);
+    ASSERT_EQ(scanned, 0.0);
+    ASSERT_EQ(ecr_stream_scan_f64(&stream, &scanned), ECR_ERROR_TYPE_OVERFLOW);
+
+    const char *token;
+    size_t length;
+    ASSERT_EQ(ecr_stream_scan_token(&stream, 64, &token, &length), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_scan_f64(&stream, &scanned), ECR_ERROR_INVALID_DATA);
+    ASSERT_EQ(ecr_stream_scan_token(&stream, 3, &token, &length), ECR_ERROR_FULL_BUFFER);
+    ASSERT_EQ(ecr_stream_scan_token(&stream, 64, &token, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string(token, length), "1.5.2");
+    ASSERT_EQ(ecr_stream_scan_token(&stream, 64, &token, &length), ECR_ERROR_EOF);
+}
+
+TEST_F(scan_test, format_round_trip) {
+    std::mt19937_64 random(12345);
+    std::string text;
+    std::vector<double> values = { 0.0, -0.0, 1.0, 0.1, 1e-7, 123456789012345680.0, 5e-324, 1.7976931348623157e308 };
+    for(int i = 0; i < 2000; i++) {
+        uint64_t bits = random();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if(std::isfinite(value)) {
+            values.push_back(value);
+        }
+    }
+
+    char out[ECR_NUMBER_MAX_LENGTH];
+    for(double value : values) {
+        text.append(out, ecr_format_f64(out, value));
+        text += ' ';
+    }
+    text.append(out, ecr_format_i64(out, INT64_MIN));
+    text += ' ';
+    text.append(out, ecr_format_hex(out, 0xBEEF));
+    open(text);
+
+    for(double value : values) {
+        double scanned;
+        ASSERT_EQ(ecr_stream_scan_f64(&stream, &scanned), ECR_SUCCESS);
+        ASSERT_EQ(std::memcmp(&scanned, &value, sizeof(value)), 0) << value;
+    }
+
+    int_least64_t i;
+    ASSERT_EQ(ecr_stream_scan_i64(&stream, &i), ECR_SUCCESS);
+    ASSERT_EQ(i, INT64_MIN);
+    const char *token;
+    size_t length;
+    ASSERT_EQ(ecr_stream_scan_token(&stream, 64, &token, &length), ECR_SUCCESS);
+    ASSERT_EQ(std::string(token, length), "beef");
+}
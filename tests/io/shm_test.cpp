@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string>
+
+#include <unistd.h>
+
+#include "io_test.hpp"
+
+#include <ecr/stream/shm.h>
+
+class shm_test : public io_test {
+  protected:
+    std::string name = "/ecr-shm-test-" + std::to_string(getpid());
+
+    // C++ does not combine enumerators into the enumeration type
+    static ecr_filemode_t mode(int flags) {
+        return (ecr_filemode_t) flags;
+    }
+};
+
+TEST_F(shm_test, round_trip) {
+    ecr_stream_t writer, reader;
+    ASSERT_EQ(ecr_stream_open_shm(&writer, name.c_str(), mode(ECR_FILEMODE_WRITE_ONLY | ECR_FILEMODE_CREATE), 64, &allocator), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_open_shm(&reader, name.c_str(), mode(ECR_FILEMODE_READ_ONLY | ECR_FILEMODE_NONBLOCK), 0, &allocator), ECR_SUCCESS);
+
+    char message[] = "hello ring";
+    size_t length = sizeof(message);
+    ASSERT_EQ(ecr_stream_write_full(&writer, message, &length), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&writer), ECR_SUCCESS);
+
+    char received[64];
+    length = sizeof(received);
+    ASSERT_EQ(ecr_stream_read(&reader, received, &length), ECR_SUCCESS);
+    ASSERT_EQ(length, sizeof(message));
+    ASSERT_STREQ(received, message);
+    length = sizeof(received);
+    ASSERT_EQ(ecr_stream_read(&reader, received, &length), ECR_ERROR_EOF);
+    ASSERT_EQ(ecr_stream_close(&reader), ECR_SUCCESS);
+}
+
+TEST_F(shm_test, creator_unlinks) {
+    for(int i = 0; i < 2; i++) {
+        ecr_stream_t stream;
+        ASSERT_EQ(ecr_stream_open_shm(&stream, name.c_str(), mode(ECR_FILEMODE_READ_ONLY | ECR_FILEMODE_CREATE), 64, &allocator), ECR_SUCCESS);
+        ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+    }
+
+    ecr_stream_t stream;
+    ASSERT_EQ(ecr_stream_open_shm(&stream, name.c_str(), ECR_FILEMODE_WRITE_ONLY, 0, &allocator), ECR_ERROR_SYSTEM);
+}
+
+TEST_F(shm_test, invalid_mode) {
+    ecr_stream_t stream;
+    ASSERT_EQ(ecr_stream_open_shm(&stream, name.c_str(), mode(ECR_FILEMODE_READ_WRITE | ECR_FILEMODE_CREATE), 64, &allocator), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_open_shm(&stream, name.c_str(), mode(ECR_FILEMODE_WRITE_ONLY | ECR_FILEMODE_APPEND | ECR_FILEMODE_CREATE), 64, &allocator), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_open_shm(&stream, name.c_str(), mode(ECR_FILEMODE_WRITE_ONLY | (1 << 12)), 0, &allocator), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_open_shm(&stream, nullptr, ECR_FILEMODE_READ_ONLY, 0, &allocator), ECR_ERROR_INVALID_ARGUMENT);
+
+    // nothing was created by the rejected calls
+    ASSERT_EQ(ecr_stream_open_shm(&stream, name.c_str(), mode(ECR_FILEMODE_READ_ONLY | ECR_FILEMODE_CREATE), 64, &allocator), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <unistd.h>
+
+#include "io_test.hpp"
+
+#include <ecr/stream/socket.h>
+
+class socket_test : public io_test {
+  protected:
+    std::string socket_path = "/tmp/ecr-socket-test-" + std::to_string(getpid());
+
+    ecr_stream_t client, server;
+
+    void TearDown() override {
+        unlink(socket_path.c_str());
+    }
+
+    void connect_unix() {
+        ecr_stream_t listener;
+        unlink(socket_path.c_str());
+        ASSERT_EQ(ecr_stream_listen_unix(&listener, socket_path.c_str(), 1), ECR_SUCCESS);
+        ASSERT_EQ(ecr_stream_connect_unix(&client, socket_path.c_str()), ECR_SUCCESS);
+        ASSERT_EQ(ecr_stream_accept(&listener, &server), ECR_SUCCESS);
+        ASSERT_EQ(ecr_stream_close(&listener), ECR_SUCCESS);
+    }
+
+    void connect_tcp() {
+        ecr_stream_t listener;
+        uint_least16_t port;
+        ASSERT_EQ(ecr_stream_listen_tcp(&listener, "127.0.0.1", "0", 1), ECR_SUCCESS);
+        ASSERT_EQ(ecr_stream_socket_local_port(&listener, &port), ECR_SUCCESS);
+        ASSERT_NE(port, 0);
+        ASSERT_EQ(ecr_stream_connect_tcp(&client, "127.0.0.1", std::to_string(port).c_str()), ECR_SUCCESS);
+        ASSERT_EQ(ecr_stream_accept(&listener, &server), ECR_SUCCESS);
+        ASSERT_EQ(ecr_stream_close(&listener), ECR_SUCCESS);
+    }
+
+    // sends data from the client while the server reads it, then a reply back, closing both ends
+    void round_trip(const std::string &data) {
+        std::thread writer([this, &data] {
+            ASSERT_EQ(write_all(&client, data), ECR_SUCCESS);
+
+            std::string reply;
+            ASSERT_EQ(read_all(&client, &reply), ECR_ERROR_EOF);
+            ASSERT_EQ(reply, "done");
+            ASSERT_EQ(ecr_stream_close(&client), ECR_SUCCESS);
+        });
+
+        std::string received;
+        while(received.size() < data.size()) {
+            char chunk[4096];
+            size_t length = std::min(sizeof(chunk), data.size() - received.size());
+            ASSERT_EQ(ecr_stream_read(&server, chunk, &length), ECR_SUCCESS);
+            received.append(chunk, length);
+        }
+        ASSERT_EQ(write_all(&server, "done"), ECR_SUCCESS);
+        ASSERT_EQ(ecr_stream_close(&server), ECR_SUCCESS);
+
+        writer.join();
+        ASSERT_EQ(received, data);
+    }
+};
+
+TEST_F(socket_test, unix_round_trip) {
+    connect_unix();
+    uint_least16_t port;
+    ASSERT_EQ(ecr_stream_socket_local_port(&client, &port), ECR_ERROR_NOT_SUPPORTED);
+    round_trip(sample(1 << 20));
+}
+
+TEST_F(socket_test, tcp_round_trip) {
+    connect_tcp();
+    round_trip(sample(1 << 20));
+}
+
+TEST_F(socket_test, options) {
+    connect_tcp();
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_NODELAY, 1), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_NODELAY, 0), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_CORK, 1), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_CORK, 0), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_SNDBUF, 1 << 14), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&server, ECR_SOCKET_RCVBUF, 1 << 14), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_ZEROCOPY, 0), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, (ecr_socket_option_t) 99, 1), ECR_ERROR_INVALID_ARGUMENT);
+
+    // small kernel buffers only slow the transfer down
+    round_trip(sample(1 << 16));
+}
+
+TEST_F(socket_test, unix_options) {
+    connect_unix();
+    // TCP only
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_NODELAY, 1), ECR_ERROR_NOT_SUPPORTED);
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_CORK, 1), ECR_ERROR_NOT_SUPPORTED);
+    ASSERT_EQ(ecr_stream_socket_flush(&client), ECR_SUCCESS);
+
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_SNDBUF, 1 << 16), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&server, ECR_SOCKET_RCVBUF, 1 << 16), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, (ecr_socket_option_t) 99, 1), ECR_ERROR_INVALID_ARGUMENT);
+    round_trip(sample(1000));
+}
+
+TEST_F(socket_test, cork) {
+    connect_tcp();
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_CORK, 1), ECR_SUCCESS);
+
+    std::atomic<bool> received = false;
+    std::string data;
+    std::thread reader([this, &received, &data] {
+        char chunk[16];
+        size_t length = sizeof(chunk);
+        ASSERT_EQ(ecr_stream_read(&server, chunk, &length), ECR_SUCCESS);
+        data.assign(chunk, length);
+        received = true;
+    });
+
+    ASSERT_EQ(write_all(&client, "hello"), ECR_SUCCESS);
+    // the kernel sends held back data anyway after 200 ms
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(received);
+
+    ASSERT_EQ(ecr_stream_socket_flush(&client), ECR_SUCCESS);
+    reader.join();
+    ASSERT_EQ(data, "hello");
+
+    ASSERT_EQ(ecr_stream_close(&client), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&server), ECR_SUCCESS);
+}
+
+TEST_F(socket_test, zerocopy) {
+    connect_tcp();
+    ASSERT_EQ(ecr_stream_socket_set_option(&client, ECR_SOCKET_ZEROCOPY, 1 << 16), ECR_SUCCESS);
+
+    // one large write sent with MSG_ZEROCOPY, while smaller ones are copied as usual
+    round_trip(sample(1 << 20) + sample(100));
+}
+
+TEST_F(socket_test, not_a_socket) {
+    memory_stream memory;
+    ecr_stream_t stream;
+    open_memory(&stream, &memory);
+
+    uint_least16_t port;
+    ASSERT_EQ(ecr_stream_socket_set_option(&stream, ECR_SOCKET_NODELAY, 1), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_socket_flush(&stream), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_socket_local_port(&stream, &port), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_accept(&stream, &client), ECR_ERROR_INVALID_ARGUMENT);
+
+    // nor is a connected socket a listener
+    connect_unix();
+    ASSERT_EQ(ecr_stream_accept(&client, &stream), ECR_ERROR_INVALID_ARGUMENT);
+    ASSERT_EQ(ecr_stream_close(&client), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&server), ECR_SUCCESS);
+
+    ASSERT_EQ(ecr_stream_connect_unix(&client, std::string(200, 'x').c_str()), ECR_ERROR_INVALID_ARGUMENT);
+}
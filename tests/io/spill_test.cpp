@@ -0,0 +1,36 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/spill.h>
+
+TEST_F(io_test, spill) {
+    ecr_stream_t stream;
+    ASSERT_EQ(ecr_stream_open_spill(&stream, &allocator, 1024), ECR_SUCCESS);
+
+    // past the threshold, so the contents move to a file partway through
+    std::string data = sample(5000);
+    ASSERT_EQ(write_all(&stream, data.substr(0, 1000)), ECR_SUCCESS);
+    ASSERT_EQ(write_all(&stream, data.substr(1000)), ECR_SUCCESS);
+
+    ecr_stream_pos_t position = 0;
+    ASSERT_EQ(ecr_stream_setpos(&stream, &position, ECR_STREAM_DIR_START), ECR_SUCCESS);
+    std::string read;
+    ASSERT_EQ(read_all(&stream, &read), ECR_ERROR_EOF);
+    ASSERT_EQ(read, data);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/tee.h>
+
+TEST_F(io_test, tee) {
+    memory_stream first, second;
+    ecr_stream_t first_stream, second_stream, stream;
+    open_memory(&first_stream, &first);
+    open_memory(&second_stream, &second);
+
+    ecr_stream_tee_child_t children[] = {
+        { .stream = &first_stream,  .async = false },
+        { .stream = &second_stream, .async = true },
+    };
+    ASSERT_EQ(ecr_stream_open_tee(&stream, children, 2, &allocator), ECR_SUCCESS);
+
+    std::string data = sample(50000);
+    ASSERT_EQ(write_all(&stream, data), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+
+    ASSERT_EQ(first.contents, data);
+    ASSERT_EQ(second.contents, data);
+}
+
+TEST_F(io_test, tee_child_error) {
+    memory_stream good, bad;
+    bad.write_error = ECR_ERROR_IO;
+    ecr_stream_t good_stream, bad_stream, stream;
+    open_memory(&good_stream, &good);
+    open_memory(&bad_stream, &bad);
+
+    ecr_stream_tee_child_t children[] = {
+        { .stream = &good_stream, .async = false },
+        { .stream = &bad_stream,  .async = false },
+    };
+    ASSERT_EQ(ecr_stream_open_tee(&stream, children, 2, &allocator), ECR_SUCCESS);
+
+    // the good child takes the data once, and isn't given it again when the write is retried
+    char data[] = "data";
+    size_t length = 4;
+    ASSERT_EQ(ecr_stream_write(&stream, data, &length), ECR_ERROR_IO);
+    bad.write_error = ECR_SUCCESS;
+    length = 4;
+    ASSERT_EQ(ecr_stream_write_full(&stream, data, &length), ECR_SUCCESS);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_SUCCESS);
+
+    ASSERT_EQ(good.contents, "data");
+    ASSERT_EQ(bad.contents, "data");
+}
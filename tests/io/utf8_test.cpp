@@ -0,0 +1,38 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "io_test.hpp"
+
+#include <ecr/stream/utf8.h>
+
+TEST_F(io_test, utf8_validation) {
+    memory_stream memory;
+    memory.contents = std::string(200, 'a') + "h\xC3\xA9llo \xE2\x82\xAC \xF0\x9F\x98\x80" + "\xC0\xAF" + "tail";
+    memory.read_chunk = 3;
+
+    ecr_stream_t inner, stream;
+    open_memory(&inner, &memory);
+    ASSERT_EQ(ecr_stream_open_utf8(&stream, &inner, &allocator), ECR_SUCCESS);
+
+    std::string valid;
+    ASSERT_EQ(read_all(&stream, &valid), ECR_ERROR_INVALID_DATA);
+    ASSERT_EQ(valid, memory.contents.substr(0, 200 + 15));
+
+    uint_least64_t offset;
+    ASSERT_EQ(ecr_stream_utf8_error(&stream, &offset), ECR_ERROR_INVALID_DATA);
+    ASSERT_EQ(offset, 200 + 15);
+    ASSERT_EQ(ecr_stream_close(&stream), ECR_ERROR_INVALID_DATA);
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2025 Aleksa Radomirovic
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <ecr/allocator.h>
+#include <ecr/allocator/standard.h>
+#include <ecr/queue.h>
+
+class queue_test : public testing::Test {
+  protected:
+    ecr_allocator_t allocator = ecr_allocator_standard;
+    ecr_queue_t queue;
+
+    void TearDown() override {
+        ASSERT_EQ(ecr_queue_free(&queue), ECR_SUCCESS);
+    }
+};
+
+TEST_F(queue_test, push_and_pop) {
+    ASSERT_EQ(ecr_queue_init(&queue, &allocator, sizeof(uint64_t), 5), ECR_SUCCESS);
+    ASSERT_EQ(queue.mask + 1, 8);
+    ASSERT_EQ((uintptr_t) queue.slots % ECR_QUEUE_CACHE_LINE_SIZE, 0);
+    ASSERT_EQ(queue.slot_size, ECR_QUEUE_CACHE_LINE_SIZE);
+
+    uint64_t value;
+    ASSERT_EQ(ecr_queue_pop(&queue, &value, false), ECR_ERROR_AGAIN);
+
+    // wrap around the ring several times
+    for(uint64_t lap = 0; lap < 4; lap++) {
+        for(uint64_t i = 0; i < 8; i++) {
+            value = lap * 8 + i;
+            ASSERT_EQ(ecr_queue_push(&queue, &value, false), ECR_SUCCESS);
+        }
+        ASSERT_EQ(ecr_queue_push(&queue, &value, false), ECR_ERROR_AGAIN);
+
+        for(uint64_t i = 0; i < 8; i++) {
+            ASSERT_EQ(ecr_queue_pop(&queue, &value, false), ECR_SUCCESS);
+            ASSERT_EQ(value, lap * 8 + i);
+        }
+        ASSERT_EQ(ecr_queue_pop(&queue, &value, false), ECR_ERROR_AGAIN);
+    }
+}
+
+TEST_F(queue_test, batch) {
+    ASSERT_EQ(ecr_queue_init(&queue, &allocator, sizeof(uint32_t), 16), ECR_SUCCESS);
+
+    uint32_t values[24];
+    for(uint32_t i = 0; i < 24; i++) {
+        values[i] = i;
+    }
+
+    size_t pushed;
+    ASSERT_EQ(ecr_queue_push_batch(&queue, values, 10, &pushed, false), ECR_SUCCESS);
+    ASSERT_EQ(pushed, 10);
+    ASSERT_EQ(ecr_queue_push_batch(&queue, values + 10, 14, &pushed, false), ECR_SUCCESS);
+    ASSERT_EQ(pushed, 6);
+    ASSERT_EQ(ecr_queue_push_batch(&queue, values, 1, &pushed, false), ECR_ERROR_AGAIN);
+    ASSERT_EQ(ecr_queue_push_batch(&queue, values, 0, &pushed, false), ECR_ERROR_INVALID_ARGUMENT);
+
+    uint32_t out[24];
+    size_t popped;
+    ASSERT_EQ(ecr_queue_pop_batch(&queue, out, 24, &popped, false), ECR_SUCCESS);
+    ASSERT_EQ(popped, 16);
+    for(uint32_t i = 0; i < 16; i++) {
+        ASSERT_EQ(out[i], i);
+    }
+}
+
+TEST_F(queue_test, large_elements) {
+    struct element {
+        uint64_t values[20];
+    };
+
+    ASSERT_EQ(ecr_queue_init(&queue, &allocator, sizeof(element), 4), ECR_SUCCESS);
+    ASSERT_EQ(queue.element_offset % alignof(element), 0);
+    ASSERT_EQ(queue.slot_size % ECR_QUEUE_CACHE_LINE_SIZE, 0);
+    ASSERT_GE(queue.slot_size, queue.element_offset + sizeof(element));
+
+    element in = {}, out;
+    for(uint64_t i = 0; i < 20; i++) {
+        in.values[i] = i * i;
+    }
+    ASSERT_EQ(ecr_queue_push(&queue, &in, false), ECR_SUCCESS);
+    ASSERT_EQ(ecr_queue_pop(&queue, &out, false), ECR_SUCCESS);
+    ASSERT_EQ(out.values[19], 361);
+}
+
+TEST_F(queue_test, close) {
+    ASSERT_EQ(ecr_queue_init(&queue, &allocator, sizeof(int), 4), ECR_SUCCESS);
+
+    int value = 1;
+    ASSERT_EQ(ecr_queue_push(&queue, &value, false), ECR_SUCCESS);
+    ecr_queue_close(&queue);
+
+    ASSERT_EQ(ecr_queue_push(&queue, &value, true), ECR_ERROR_SYSTEM);
+    ASSERT_EQ(ecr_queue_pop(&queue, &value, true), ECR_SUCCESS);
+    ASSERT_EQ(value, 1);
+    ASSERT_EQ(ecr_queue_pop(&queue, &value, true), ECR_ERROR_EOF);
+}
+
+TEST_F(queue_test, close_wakes_waiters) {
+    ASSERT_EQ(ecr_queue_init(&queue, &allocator, sizeof(int), 2), ECR_SUCCESS);
+
+    std::thread consumer([this] {
+        int value;
+        ASSERT_EQ(ecr_queue_pop(&queue, &value, true), ECR_ERROR_EOF);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    ecr_queue_close(&queue);
+    consumer.join();
+}
+
+// every push that succeeds must be delivered, even when the queue is closed while producers are mid-push
+TEST_F(queue_test, close_while_pushing) {
+    // large elements, so that producers spend a while between claiming a slot and filling it
+    struct element {
+        uint64_t values[8192];
+    };
+    constexpr int producers = 4, rounds = 200;
+
+    for(int round = 0; round < rounds; round++) {
+        ASSERT_EQ(ecr_queue_init(&queue, &allocator, sizeof(element), 64), ECR_SUCCESS);
+
+        std::atomic<uint64_t> pushed = 0, popped = 0;
+        std::vector<std::thread> threads;
+        for(int p = 0; p < producers; p++) {
+            threads.emplace_back([this, &pushed] {
+                element value = {};
+                while(ecr_queue_push(&queue, &value, true) == ECR_SUCCESS) {
+                    pushed++;
+                }
+            });
+        }
+        threads.emplace_back([this, &popped] {
+            element value;
+            ecr_status_t status;
+            while((status = ecr_queue_pop(&queue, &value, true)) == ECR_SUCCESS) {
+                popped++;
+            }
+            ASSERT_EQ(status, ECR_ERROR_EOF);
+        });
+
+        while(pushed < (uint64_t) round % 50 * 4) {
+            std::this_thread::yield();
+        }
+        ecr_queue_close(&queue);
+        for(std::thread &thread : threads) {
+            thread.join();
+        }
+
+        ASSERT_EQ(popped, pushed) << "round " << round;
+        if(round + 1 < rounds) {
+            ASSERT_EQ(ecr_queue_free(&queue), ECR_SUCCESS);
+        }
+    }
+}
+
+TEST_F(queue_test, concurrent) {
+    constexpr int producers = 4, consumers = 4;
+    constexpr uint64_t per_producer = 100000;
+
+    ASSERT_EQ(ecr_queue_init(&queue, &allocator, sizeof(uint64_t), 64), ECR_SUCCESS);
+
+    std::atomic<uint64_t> sum = 0, count = 0;
+    std::vector<std::thread> threads;
+
+    for(int p = 0; p < producers; p++) {
+        threads.emplace_back([this, p] {
+            uint64_t batch[8];
+            for(uint64_t i = 0; i < per_producer;) {
+                size_t length = 0;
+                for(; length < 8 && i + length < per_producer; length++) {
+                    batch[length] = p * per_producer + i + length + 1;
+                }
+
+                // alternate single and batched pushes
+                size_t pushed = 1;
+                if(i % 2 == 0) {
+                    ASSERT_EQ(ecr_queue_push(&queue, batch, true), ECR_SUCCESS);
+                } else {
+                    ASSERT_EQ(ecr_queue_push_batch(&queue, batch, length, &pushed, true), ECR_SUCCESS);
+                }
+                i += pushed;
+            }
+        });
+    }
+
+    for(int c = 0; c < consumers; c++) {
+        threads.emplace_back([this, &sum, &count] {
+            uint64_t batch[5];
+            size_t popped;
+            while(ecr_queue_pop_batch(&queue, batch, 5, &popped, true) == ECR_SUCCESS) {
+                for(size_t i = 0; i < popped; i++) {
+                    sum += batch[i];
+                }
+                count += popped;
+            }
+        });
+    }
+
+    for(int p = 0; p < producers; p++) {
+        threads[p].join();
+    }
+    ecr_queue_close(&queue);
+    for(int c = 0; c < consumers; c++) {
+        threads[producers + c].join();
+    }
+
+    uint64_t total = producers * per_producer;
+    ASSERT_EQ(count, total);
+    ASSERT_EQ(sum, total * (total + 1) / 2);
+}